@@ -32,3 +32,36 @@ void Board3D::CreateRect(Vertex3D* p3DVertices, const VerticesParam& verticesPar
 		verticesParam.m_texUV.m_endTU, verticesParam.m_texUV.m_endTV
 	);
 }
+
+void Board3D::CreateRects(Vertex3D* p3DVertices, const VerticesParam* pVerticesParams, UINT boardsNum)
+{
+	const int m_RECT_VERTICES_NUM = 4;
+
+	for (UINT i = 0; i < boardsNum; ++i)
+	{
+		CreateRect(&p3DVertices[i * m_RECT_VERTICES_NUM], pVerticesParams[i]);
+	}
+}
+
+void Board3D::CreateInstance(BoardInstance* pInstance, const VerticesParam& verticesParam)
+{
+	D3DXMATRIX scale;
+	D3DXMatrixScaling(&scale, verticesParam.m_halfScale.x, verticesParam.m_halfScale.y, 1.0f);
+
+	D3DXMATRIX rotateX, rotateY, rotateZ;
+	D3DXMatrixRotationX(&rotateX, D3DXToRadian(verticesParam.m_deg.x));
+	D3DXMatrixRotationY(&rotateY, D3DXToRadian(verticesParam.m_deg.y));
+	D3DXMatrixRotationZ(&rotateZ, D3DXToRadian(verticesParam.m_deg.z));
+
+	D3DXMATRIX translation;
+	D3DXMatrixTranslation(&translation, verticesParam.m_center.x, verticesParam.m_center.y, verticesParam.m_center.z);
+
+	CreateInstance(pInstance, scale * rotateX * rotateY * rotateZ * translation, verticesParam.m_aRGB, verticesParam.m_texUV);
+}
+
+void Board3D::CreateInstance(BoardInstance* pInstance, const D3DXMATRIX& rWorld, DWORD aRGB, const TexUV& texUV)
+{
+	pInstance->m_world	= rWorld;
+	pInstance->m_aRGB	= aRGB;
+	pInstance->m_texUV	= texUV;
+}
@@ -20,16 +20,51 @@ public:
 	float		m_Tv;
 };
 
+/// <summary>
+/// インスタンス描画する板ポリ一枚分のデータ
+/// 共有の単位板ポリ(-1~1の正方形)をワールド行列で変換して描画する
+/// </summary>
+struct BoardInstance
+{
+public:
+	D3DXMATRIX m_world;
+
+	DWORD m_aRGB = 0xFFFFFFFF;
+
+	TexUV m_texUV;
+};
+
 class Board3D
 {
 public:
 	Board3D() {}
 	~Board3D() {}
 
+	/// <summary>
+	/// インスタンス描画用のデータを作成する
+	/// </summary>
+	/// <param name="pInstance">[out]作成したデータを入れる</param>
+	/// <param name="verticesParam">中心,幅の半分,XYZ順の回転角度,色,テクスチャ座標</param>
+	void CreateInstance(BoardInstance* pInstance, const VerticesParam& verticesParam);
+
+	/// <param name="pInstance">[out]作成したデータを入れる</param>
+	/// <param name="rWorld">単位板ポリに掛け合わせる拡大回転移動行列</param>
+	/// <param name="aRGB">頂点の色</param>
+	/// <param name="texUV">テクスチャ座標</param>
+	void CreateInstance(BoardInstance* pInstance, const D3DXMATRIX& rWorld, DWORD aRGB = 0xFFFFFFFF, const TexUV& texUV = TexUV());
+
 	void CreateRect(Vertex3D* p3DVertices, const D3DXVECTOR3& halfScale, const D3DXVECTOR3& center,
 		DWORD aRGB = 0xFFFFFFFF, float startTU = 0.0f, float startTV = 0.0f, float endTU = 1.0f, float endTV = 1.0f);
 
 	void CreateRect(Vertex3D* p3DVertices, const VerticesParam& verticesParam);
+
+	/// <summary>
+	/// 複数の板ポリの頂点データを連続した配列に作成する 共有のインデックスバッファでまとめて描画できる
+	/// </summary>
+	/// <param name="p3DVertices">[out]板ポリの数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pVerticesParams">[in]板ポリの数の長さを持つ中心,幅の半分,色,テクスチャ座標の配列の先頭アドレス</param>
+	/// <param name="boardsNum">板ポリの数</param>
+	void CreateRects(Vertex3D* p3DVertices, const VerticesParam* pVerticesParams, UINT boardsNum);
 };
 
 
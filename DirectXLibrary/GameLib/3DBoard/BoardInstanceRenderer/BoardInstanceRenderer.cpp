@@ -0,0 +1,54 @@
+﻿/// <filename>
+/// BoardInstanceRenderer.cpp
+/// </filename>
+/// <summary>
+/// 板ポリのインスタンスをテクスチャごとにまとめるクラスのソース
+/// </summary>
+
+#include "BoardInstanceRenderer.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <unordered_map>
+
+#include <d3dx9.h>
+
+#include "3DBoard\3DBoard.h"
+#include "IBoardInstanceBackend.h"
+
+void BoardInstanceRenderer::Submit(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture)
+{
+	if (instancesNum == 0) return;
+
+	auto batchIndex = m_batchIndices.find(pTexture);
+
+	if (batchIndex == m_batchIndices.end())
+	{
+		batchIndex = m_batchIndices.emplace(pTexture, m_batches.size()).first;
+
+		m_batches.emplace_back(pTexture, std::vector<BoardInstance>());
+	}
+
+	std::vector<BoardInstance>& rInstances = m_batches[batchIndex->second].second;
+
+	rInstances.insert(rInstances.end(), pInstances, pInstances + instancesNum);
+}
+
+void BoardInstanceRenderer::Flush(IBoardInstanceBackend* pBackend)
+{
+	m_stats = BoardInstanceStats();
+
+	for (auto& rBatch : m_batches)
+	{
+		UINT instancesNum = static_cast<UINT>(rBatch.second.size());
+
+		pBackend->DrawBatch(rBatch.second.data(), instancesNum, rBatch.first);
+
+		++m_stats.m_batchesNum;
+		m_stats.m_instancesNum += instancesNum;
+	}
+
+	m_batches.clear();
+	m_batchIndices.clear();
+}
@@ -0,0 +1,75 @@
+﻿/// <filename>
+/// BoardInstanceRenderer.h
+/// </filename>
+/// <summary>
+/// 板ポリのインスタンスをテクスチャごとにまとめるクラスのヘッダ
+/// </summary>
+
+#ifndef BOARD_INSTANCE_RENDERER_H
+#define BOARD_INSTANCE_RENDERER_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <unordered_map>
+
+#include <d3dx9.h>
+
+#include "3DBoard\3DBoard.h"
+#include "IBoardInstanceBackend.h"
+
+/// <summary>
+/// 最後にFlushした際の統計
+/// </summary>
+struct BoardInstanceStats
+{
+public:
+	//! 描画先に渡したまとまりの数 テクスチャの種類の数と等しい
+	UINT m_batchesNum = 0;
+
+	UINT m_instancesNum = 0;
+};
+
+/// <summary>
+/// 積まれた板ポリのインスタンスをテクスチャごとにまとめ,描画先へテクスチャ一つにつき一度で渡すクラス
+/// 描画先を差し替えられるのでデバイスなしでもまとまり方を確かめられる
+/// </summary>
+class BoardInstanceRenderer
+{
+public:
+	BoardInstanceRenderer() {};
+	~BoardInstanceRenderer() {};
+
+	/// <summary>
+	/// インスタンスを積む 実際の描画はFlushで行う
+	/// </summary>
+	/// <param name="pInstances">[in]インスタンスの配列の先頭アドレス</param>
+	/// <param name="instancesNum">インスタンスの数</param>
+	/// <param name="pTexture">板ポリに張り付けるテクスチャのポインタ</param>
+	void Submit(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture = nullptr);
+
+	/// <summary>
+	/// 積まれたインスタンスを初めに積まれたテクスチャの順に描画先へ渡し,空にする
+	/// </summary>
+	/// <param name="pBackend">描画先</param>
+	void Flush(IBoardInstanceBackend* pBackend);
+
+	/// <summary>
+	/// 最後にFlushした際の統計を取得する
+	/// </summary>
+	inline const BoardInstanceStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+private:
+	//! テクスチャごとのインスタンス 初めに積まれた順に並ぶ
+	std::vector<std::pair<LPDIRECT3DTEXTURE9, std::vector<BoardInstance>>> m_batches;
+
+	//! テクスチャからm_batchesの番号を引く
+	std::unordered_map<LPDIRECT3DTEXTURE9, size_t> m_batchIndices;
+
+	BoardInstanceStats m_stats;
+};
+
+#endif //! BOARD_INSTANCE_RENDERER_H
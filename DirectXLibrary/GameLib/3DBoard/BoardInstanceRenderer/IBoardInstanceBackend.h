@@ -0,0 +1,35 @@
+﻿/// <filename>
+/// IBoardInstanceBackend.h
+/// </filename>
+/// <summary>
+/// 板ポリのインスタンス描画を行う描画先のインターフェイスのヘッダ
+/// </summary>
+
+#ifndef I_BOARD_INSTANCE_BACKEND_H
+#define I_BOARD_INSTANCE_BACKEND_H
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "3DBoard\3DBoard.h"
+
+/// <summary>
+/// 板ポリのインスタンス描画を行う描画先のインターフェイス
+/// BoardInstanceRendererがテクスチャごとにまとめたインスタンスを受け取る
+/// </summary>
+class IBoardInstanceBackend
+{
+public:
+	virtual ~IBoardInstanceBackend() {};
+
+	/// <summary>
+	/// 同じテクスチャを用いるインスタンスを一度に描画する
+	/// </summary>
+	/// <param name="pInstances">[in]インスタンスの配列の先頭アドレス</param>
+	/// <param name="instancesNum">インスタンスの数</param>
+	/// <param name="pTexture">板ポリに張り付けるテクスチャのポインタ</param>
+	virtual void DrawBatch(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture) = 0;
+};
+
+#endif //! I_BOARD_INSTANCE_BACKEND_H
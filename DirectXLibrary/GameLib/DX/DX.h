@@ -170,10 +170,11 @@ public:
 	* @brief テクスチャを作成する
 	* @param pTexKey テクスチャにつける名前のポインタ キー 連想配列
 	* @param pTexPath 画像のパスのポインタ
+	* @return テクスチャのハンドル 既に作成されている場合はそのハンドル 作成できなかった場合何も指さない
 	*/
-	inline void CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
+	inline TexHandle CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
 	{
-		m_pDX3D->CreateTex(pTexKey, pTexPath);
+		return m_pDX3D->CreateTex(pTexKey, pTexPath);
 	}
 
 	/**
@@ -202,6 +203,26 @@ public:
 	{
 		return m_pDX3D->GetTex(pTexKey);
 	}
+
+	/// <summary>
+	/// テクスチャのハンドルを取得する 毎フレーム描画するものは一度取得したハンドルを使い続ける
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャを作るときに決めたキー</param>
+	/// <returns>作成されていない場合何も指さない</returns>
+	inline TexHandle GetTexHandle(const TCHAR* pTexKey) const
+	{
+		return m_pDX3D->GetTexHandle(pTexKey);
+	}
+
+	/// <summary>
+	/// ハンドルの指すテクスチャを取得する キーで取得するより速い
+	/// </summary>
+	/// <returns>何も指さないか,指していたテクスチャが開放されている場合nullptr</returns>
+	inline const LPDIRECT3DTEXTURE9 GetTex(TexHandle texHandle) const
+	{
+		return m_pDX3D->GetTex(texHandle);
+	}
+
 	/**
 	* @brief テクスチャが生成されているか判断する
 	* @param pTexKey テクスチャを作るときに決めたキーのポインタ
@@ -212,6 +233,47 @@ public:
 		return m_pDX3D->TexExists(pTexKey);
 	}
 
+	/// <summary>
+	/// 画像をアトラスのページに詰めて作成する 同じページの画像同士はテクスチャを切り替えずに描画できる
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャにつける名前</param>
+	/// <param name="pTexPath">[in]画像のパス</param>
+	inline void CreateAtlasTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
+	{
+		m_pDX3D->CreateAtlasTex(pTexKey, pTexPath);
+	}
+
+	/// <summary>
+	/// CreateAtlasTexで作成したテクスチャとその中での画像の座標を取得する
+	/// 座標はVerticesParam::m_texUVにそのまま入れられる
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャを作るときに決めた名前</param>
+	/// <returns>テクスチャと座標</returns>
+	inline AtlasTex GetAtlasTex(const TCHAR* pTexKey) const
+	{
+		return m_pDX3D->GetAtlasTex(pTexKey);
+	}
+
+	/// <summary>
+	/// アトラスのページと画像の座標の表を書き出す
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]書き出すファイルのパスの先頭 ページは(先頭)(番号).png,表は(先頭).txtになる</param>
+	/// <returns>書き出せなかった場合false</returns>
+	inline bool SaveAtlas(const TCHAR* pFilePathPrefix) const
+	{
+		return m_pDX3D->SaveAtlas(pFilePathPrefix);
+	}
+
+	/// <summary>
+	/// SaveAtlasで書き出したページと表を読み込む 読み込んだ画像はGetAtlasTexで取得できる
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]SaveAtlasに渡したファイルのパスの先頭</param>
+	/// <returns>読み込めなかった場合false</returns>
+	inline bool LoadAtlas(const TCHAR* pFilePathPrefix)
+	{
+		return m_pDX3D->LoadAtlas(pFilePathPrefix);
+	}
+
 	/**
 	* @brief 現在のカメラの位置を取得する
 	* @param[out] pCameraPos カメラ位置を入れる
@@ -521,6 +583,50 @@ public:
 		m_pDX3D->CreateRect(pCustomVertices, verticesParam);
 	}
 
+	/// <summary>
+	/// 複数の矩形の頂点データを連続した配列に作成する 共有のインデックスバッファでまとめて描画できる
+	/// </summary>
+	/// <param name="pCustomVertices">[out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pVerticesParams">[in]矩形の数の長さを持つオブジェクトの状態構造体配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void CreateRects(CustomVertex* pCustomVertices, const VerticesParam* pVerticesParams, UINT rectsNum) const
+	{
+		m_pDX3D->CreateRects(pCustomVertices, pVerticesParams, rectsNum);
+	}
+
+	/// <summary>
+	/// 複数の矩形をそれぞれの中心でXYZ順に回転させる
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pDegs">[in]矩形の数の長さを持つ度数法での角度の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void RotateRectsXYZ(CustomVertex* pCustomVertices, const D3DXVECTOR3* pDegs, UINT rectsNum) const
+	{
+		m_pDX3D->RotateRectsXYZ(pCustomVertices, pDegs, rectsNum);
+	}
+
+	/// <summary>
+	/// 複数の矩形をそれぞれの中心で拡縮させる
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pScaleRates">[in]矩形の数の長さを持つ拡縮率の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void RescaleRects(CustomVertex* pCustomVertices, const D3DXVECTOR2* pScaleRates, UINT rectsNum) const
+	{
+		m_pDX3D->RescaleRects(pCustomVertices, pScaleRates, rectsNum);
+	}
+
+	/// <summary>
+	/// 複数の矩形をそれぞれ移動させる
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pMovements">[in]矩形の数の長さを持つ移動量の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void MoveRects(CustomVertex* pCustomVertices, const D3DXVECTOR3* pMovements, UINT rectsNum) const
+	{
+		m_pDX3D->MoveRects(pCustomVertices, pMovements, rectsNum);
+	}
+
 	/**
 	* @brief FBXの描画を行う
 	* @param rFBXModel FBXのクラス モデルを読み込んだ後でないといけない
@@ -553,6 +659,29 @@ public:
 		m_pDX3D->Render(pVertex3D, rWorld, pTexture);
 	}
 
+	/// <summary>
+	/// 連続して並んでいる複数の矩形をまとめて描画する
+	/// </summary>
+	/// <param name="pCustomVertices">[in]矩形の数*4の頂点データの先頭ポインタ CreateRectsで作成する</param>
+	/// <param name="rectsNum">矩形の数</param>
+	/// <param name="pTexture">ポリゴンに張り付けるテクスチャのポインタ</param>
+	inline void RenderRects(const CustomVertex* pCustomVertices, UINT rectsNum, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		m_pDX3D->RenderRects(pCustomVertices, rectsNum, pTexture);
+	}
+
+	/// <summary>
+	/// 連続して並んでいる複数の板ポリを同じワールド行列で一度に描画する
+	/// </summary>
+	/// <param name="pVertices">[in]板ポリの数*4の頂点データの先頭ポインタ Board3D::CreateRectsで作成する</param>
+	/// <param name="boardsNum">板ポリの数</param>
+	/// <param name="rWorld">拡大回転移動行列をまとめた行列</param>
+	/// <param name="pTexture">板ポリに張り付けるテクスチャのポインタ</param>
+	inline void RenderBoards(const Vertex3D* pVertices, UINT boardsNum, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		m_pDX3D->RenderBoards(pVertices, boardsNum, rWorld, pTexture);
+	}
+
 	/// <summary>
 	/// 文字の描画を行う
 	/// </summary>
@@ -566,6 +695,19 @@ public:
 		m_pDX3D->Render(topLeft, pText, format, pFont, color);
 	}
 
+	/// <summary>
+	/// UTF-8の文字列の描画を行う
+	/// </summary>
+	/// <param name="topLeft">[in]左上の座標</param>
+	/// <param name="pText">[in]描画したいUTF-8の文字列</param>
+	/// <param name="format">文字のフォーマット DT_LEFT(左寄せ)等</param>
+	/// <param name="pFont">描画する際に使うフォントオブジェクト</param>
+	/// <param name="color">文字の色ARGB</param>
+	inline void RenderUTF8(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color)
+	{
+		m_pDX3D->RenderUTF8(topLeft, pText, format, pFont, color);
+	}
+
 	/// <summary>
 	/// 矩形の描画を行う
 	/// </summary>
@@ -576,6 +718,154 @@ public:
 		m_pDX3D->Render(verticesParam, pTexture);
 	}
 
+	/// <summary>
+	/// 矩形の描画命令を積む 描画の終了宣言の前に並べ替えられ,まとめて描画される
+	/// </summary>
+	/// <param name="verticesParam">頂点情報配列を作成するためのデータ</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	/// <param name="blendMode">矩形を描画する際の色の合成</param>
+	/// <param name="layer">描画する層 大きいほど後に描画される</param>
+	inline void Submit(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const
+	{
+		m_pDX3D->Submit(verticesParam, pTexture, blendMode, layer);
+	}
+
+	inline void Submit(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const
+	{
+		m_pDX3D->Submit(pCustomVertices, pTexture, blendMode, layer);
+	}
+
+	/// <summary>
+	/// 保持している頂点データで矩形の描画を行う 変更があった要素のみ頂点データを作り直す
+	/// </summary>
+	/// <param name="pSprite">[in,out]描画する矩形</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	inline void Render(Sprite* pSprite, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		m_pDX3D->Render(pSprite, pTexture);
+	}
+
+	/// <summary>
+	/// 保持している頂点データで矩形の描画命令を積む 変更があった要素のみ頂点データを作り直す
+	/// </summary>
+	/// <param name="pSprite">[in,out]描画する矩形</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	/// <param name="blendMode">矩形を描画する際の色の合成</param>
+	/// <param name="layer">描画する層 大きいほど後に描画される</param>
+	inline void Submit(Sprite* pSprite, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const
+	{
+		m_pDX3D->Submit(pSprite, pTexture, blendMode, layer);
+	}
+
+	/// <summary>
+	/// 最後に描画したフレームの描画命令の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const RenderQueueStats& GetRenderQueueStats() const
+	{
+		return m_pDX3D->GetRenderQueueStats();
+	}
+
+	/// <summary>
+	/// 3Dの板ポリとFBXの頂点を書き込む頂点バッファの確保の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const VertexRingBufferStats& GetVertexRingBufferStats() const
+	{
+		return m_pDX3D->GetVertexRingBufferStats();
+	}
+
+	/// <summary>
+	/// 状態の設定をデバイスへ渡した回数と省いた回数の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const RenderStateCacheStats& GetRenderStateCacheStats() const
+	{
+		return m_pDX3D->GetRenderStateCacheStats();
+	}
+
+	/// <summary>
+	/// 状態の設定の回数の統計を0にする
+	/// </summary>
+	inline void ResetRenderStateCacheStats() const
+	{
+		m_pDX3D->ResetRenderStateCacheStats();
+	}
+
+	/// <summary>
+	/// 文字の画像を使いまわした回数と作成した回数の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const GlyphCacheStats& GetGlyphCacheStats() const
+	{
+		return m_pDX3D->GetGlyphCacheStats();
+	}
+
+	/// <summary>
+	/// 文字の画像の統計を0にする
+	/// </summary>
+	inline void ResetGlyphCacheStats() const
+	{
+		m_pDX3D->ResetGlyphCacheStats();
+	}
+
+	/// <summary>
+	/// 文字列の配置を使いまわした回数と保持している大きさの統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const TextLayoutCacheStats& GetTextLayoutCacheStats() const
+	{
+		return m_pDX3D->GetTextLayoutCacheStats();
+	}
+
+	/// <summary>
+	/// 文字列の配置の統計を0にする
+	/// </summary>
+	inline void ResetTextLayoutCacheStats() const
+	{
+		m_pDX3D->ResetTextLayoutCacheStats();
+	}
+
+	/// <summary>
+	/// 最後に終了したフレームで画面外として描画しなかった矩形とメッシュの数の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const CullerStats& GetCullerStats() const
+	{
+		return m_pDX3D->GetCullerStats();
+	}
+
+	/// <summary>
+	/// 板ポリのインスタンスを積む テクスチャごとにまとめて一度で描画される
+	/// </summary>
+	/// <param name="pInstances">[in]インスタンスの配列の先頭アドレス Board3D::CreateInstanceで作成する</param>
+	/// <param name="instancesNum">インスタンスの数</param>
+	/// <param name="pTexture">板ポリに張り付けるテクスチャのポインタ</param>
+	inline void RenderInstances(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		m_pDX3D->RenderInstances(pInstances, instancesNum, pTexture);
+	}
+
+	/// <summary>
+	/// 積まれた板ポリのインスタンスを描画する 呼ばなくても描画の終了宣言の前に描画される
+	/// </summary>
+	inline void FlushBoardInstances() const
+	{
+		m_pDX3D->FlushBoardInstances();
+	}
+
+	/// <summary>
+	/// 最後に板ポリのインスタンスを描画した際の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const BoardInstanceStats& GetBoardInstanceStats() const
+	{
+		return m_pDX3D->GetBoardInstanceStats();
+	}
+
 	/// <summary>
 	/// FBXオブジェクトの作成を行う
 	/// </summary>
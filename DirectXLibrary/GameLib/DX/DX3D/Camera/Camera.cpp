@@ -39,6 +39,8 @@ void Camera::SetTransform()
 		DEFAULT_FAR);
 
 	m_pDX_GRAPHIC_DEVICE->SetTransform(D3DTS_PROJECTION, &m_projection);
+
+	m_isTransformSet = true;
 }
 
 D3DXVECTOR3 Camera::TransScreen(const D3DXVECTOR3& worldPos)
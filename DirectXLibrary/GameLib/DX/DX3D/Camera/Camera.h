@@ -16,7 +16,12 @@
 class Camera
 {
 public:
-	explicit Camera(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice) {};
+	explicit Camera(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice)
+	{
+		//! SetTransformが呼ばれる前に取得されても不定値を返さないようにする
+		D3DXMatrixIdentity(&m_view);
+		D3DXMatrixIdentity(&m_projection);
+	}
 	~Camera() {};
 
 	/**
@@ -104,6 +109,14 @@ public:
 	*/
 	void SetTransform();
 
+	/// <summary>
+	/// SetTransformが一度でも呼ばれたか 呼ばれるまでビュー行列とプロジェクション行列は単位行列
+	/// </summary>
+	inline bool IsTransformSet() const
+	{
+		return m_isTransformSet;
+	}
+
 	/**
 	* @brief 引数の行列をビルボード化する、
 	* 回転行列なのでかけ合わせる順番は回転行列をかけ合わせるとき
@@ -134,6 +147,8 @@ private:
 
 	D3DXMATRIX m_view;
 	D3DXMATRIX m_projection;
+
+	bool m_isTransformSet = false;
 };
 
 #endif //! CAMERA_H
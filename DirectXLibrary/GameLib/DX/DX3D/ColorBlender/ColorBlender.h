@@ -10,38 +10,64 @@
 
 #include <d3dx9.h>
 
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
 /**
 * @brief 色の合成を変更するクラス
 */
 class ColorBlender
 {
 public:
-	ColorBlender(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice) {};
+	/// <summary>
+	/// 現在の色の合成の種類
+	/// </summary>
+	enum class BLEND_MODE
+	{
+		DEFAULT,
+		ADDITION,
+	};
+
+	explicit ColorBlender(RenderStateCache* pRenderStateCache) :m_pRenderStateCache(pRenderStateCache) {};
 	~ColorBlender() {};
 
 	/**
 	* @brief 色の合成を通常合成に変更する デフォルトでは通常合成になっている
 	*/
-	inline void DefaultBlendMode() const
+	inline void DefaultBlendMode()
 	{
-		m_pDX_GRAPHIC_DEVICE->SetRenderState(D3DRS_DESTBLEND, D3DBLEND_INVSRCALPHA);
+		m_pRenderStateCache->SetRenderState(D3DRS_DESTBLEND, D3DBLEND_INVSRCALPHA);
+
+		m_blendMode = BLEND_MODE::DEFAULT;
 	}
 
 	/**
 	* @brief 色の合成を加算合成に変更する
 	*/
-	inline void AddtionBlendMode() const
+	inline void AddtionBlendMode()
 	{
-		m_pDX_GRAPHIC_DEVICE->SetRenderState(D3DRS_DESTBLEND, D3DBLEND_ONE);
+		m_pRenderStateCache->SetRenderState(D3DRS_DESTBLEND, D3DBLEND_ONE);
+
+		m_blendMode = BLEND_MODE::ADDITION;
 	}
 
 	/**
 	* @brief デフォルトの色合成を使用する ウィンドウモードを切り替えた時には再設定する必要がある
 	*/
-	void DefaultColorBlending() const;
+	void DefaultColorBlending();
+
+	/// <summary>
+	/// 現在の色の合成の種類を取得する
+	/// </summary>
+	/// <returns>最後に設定した色の合成の種類</returns>
+	inline BLEND_MODE GetBlendMode() const
+	{
+		return m_blendMode;
+	}
 
 private:
-	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+	RenderStateCache* m_pRenderStateCache = nullptr;
+
+	BLEND_MODE m_blendMode = BLEND_MODE::DEFAULT;
 };
 
 #endif //!　COLOR_BLENDER_H
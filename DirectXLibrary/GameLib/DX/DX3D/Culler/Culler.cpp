@@ -0,0 +1,99 @@
+﻿/// <filename>
+/// Culler.cpp
+/// </filename>
+/// <summary>
+/// 画面外の矩形やモデルを描画前に除外するクラスのソース
+/// </summary>
+
+#include "Culler.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\Camera\Camera.h"
+
+bool Culler::IsVisible(const CustomVertex* pRect)
+{
+	++m_stats.m_testedRectsNum;
+
+	float left		= pRect[0].m_pos.x;
+	float right		= pRect[0].m_pos.x;
+	float top		= pRect[0].m_pos.y;
+	float bottom	= pRect[0].m_pos.y;
+
+	//! 回転している場合もあるので全頂点を囲む矩形で判定する
+	for (int i = 1; i < CustomVertex::m_RECT_VERTICES_NUM; ++i)
+	{
+		left	= (std::min)(left, pRect[i].m_pos.x);
+		right	= (std::max)(right, pRect[i].m_pos.x);
+		top		= (std::min)(top, pRect[i].m_pos.y);
+		bottom	= (std::max)(bottom, pRect[i].m_pos.y);
+	}
+
+	if (right < m_viewportLeft || left > m_viewportRight ||
+		bottom < m_viewportTop || top > m_viewportBottom)
+	{
+		++m_stats.m_culledRectsNum;
+
+		return false;
+	}
+
+	return true;
+}
+
+void Culler::SetWorld(const D3DXMATRIX& rWorld)
+{
+	m_isFrustumValid = m_pCAMERA->IsTransformSet();
+
+	if (!m_isFrustumValid) return;
+
+	D3DXMATRIX view;
+	m_pCAMERA->GetView(&view);
+
+	D3DXMATRIX projection;
+	m_pCAMERA->GetProjection(&projection);
+
+	D3DXMATRIX worldViewProjection = rWorld * view * projection;
+
+	const D3DXMATRIX& rM = worldViewProjection;
+
+	//! 行列の列から面を取り出す Direct3Dのクリップ空間は0 <= z <= w
+	m_frustumPlanes[0] = D3DXPLANE(rM._14 + rM._11, rM._24 + rM._21, rM._34 + rM._31, rM._44 + rM._41);
+	m_frustumPlanes[1] = D3DXPLANE(rM._14 - rM._11, rM._24 - rM._21, rM._34 - rM._31, rM._44 - rM._41);
+	m_frustumPlanes[2] = D3DXPLANE(rM._14 + rM._12, rM._24 + rM._22, rM._34 + rM._32, rM._44 + rM._42);
+	m_frustumPlanes[3] = D3DXPLANE(rM._14 - rM._12, rM._24 - rM._22, rM._34 - rM._32, rM._44 - rM._42);
+	m_frustumPlanes[4] = D3DXPLANE(rM._13, rM._23, rM._33, rM._43);
+	m_frustumPlanes[5] = D3DXPLANE(rM._14 - rM._13, rM._24 - rM._23, rM._34 - rM._33, rM._44 - rM._43);
+}
+
+bool Culler::IsVisible(const D3DXVECTOR3& rMin, const D3DXVECTOR3& rMax)
+{
+	//! 頂点を持たないメッシュは範囲が求まっていないので除外しない
+	if (rMin.x > rMax.x || rMin.y > rMax.y || rMin.z > rMax.z) return true;
+
+	if (!m_isFrustumValid) return true;
+
+	++m_stats.m_testedMeshesNum;
+
+	for (const D3DXPLANE& rPlane : m_frustumPlanes)
+	{
+		//! 面の法線方向に最も進んだ頂点が外側なら直方体全体が外側
+		D3DXVECTOR3 farthest(
+			(rPlane.a >= 0.0f) ? rMax.x : rMin.x,
+			(rPlane.b >= 0.0f) ? rMax.y : rMin.y,
+			(rPlane.c >= 0.0f) ? rMax.z : rMin.z);
+
+		if (D3DXPlaneDotCoord(&rPlane, &farthest) < 0.0f)
+		{
+			++m_stats.m_culledMeshesNum;
+
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,116 @@
+﻿/// <filename>
+/// Culler.h
+/// </filename>
+/// <summary>
+/// 画面外の矩形やモデルを描画前に除外するクラスのヘッダ
+/// </summary>
+
+#ifndef CULLER_H
+#define CULLER_H
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\Camera\Camera.h"
+
+/// <summary>
+/// 最後に終了したフレームの統計
+/// </summary>
+struct CullerStats
+{
+public:
+	//! ビューポートと判定した矩形の数
+	UINT m_testedRectsNum = 0;
+
+	//! ビューポートの外にあり除外した矩形の数
+	UINT m_culledRectsNum = 0;
+
+	//! 視錐台と判定したメッシュの数
+	UINT m_testedMeshesNum = 0;
+
+	//! 視錐台の外にあり除外したメッシュの数
+	UINT m_culledMeshesNum = 0;
+};
+
+/// <summary>
+/// 2Dの矩形はビューポート,3Dのメッシュはカメラの視錐台と判定し,見えないものを除外するクラス
+/// </summary>
+class Culler
+{
+public:
+	explicit Culler(const Camera* pCamera) :m_pCAMERA(pCamera) {};
+	~Culler() {};
+
+	/// <summary>
+	/// 矩形の判定に使うビューポートを設定する
+	/// </summary>
+	/// <param name="rViewport">[in]デバイスに設定したビューポート</param>
+	inline void SetViewport(const D3DVIEWPORT9& rViewport)
+	{
+		m_viewportLeft		= static_cast<float>(rViewport.X);
+		m_viewportTop		= static_cast<float>(rViewport.Y);
+		m_viewportRight		= static_cast<float>(rViewport.X + rViewport.Width);
+		m_viewportBottom	= static_cast<float>(rViewport.Y + rViewport.Height);
+	}
+
+	/// <summary>
+	/// 統計をフレームごとに区切る フレームの最初に呼ぶ
+	/// </summary>
+	inline void BeginFrame()
+	{
+		m_lastFrameStats = m_stats;
+
+		m_stats = CullerStats();
+	}
+
+	/// <summary>
+	/// 矩形がビューポートと重なっているかを判定する
+	/// </summary>
+	/// <param name="pRect">[in]矩形の頂点 CustomVertex::m_RECT_VERTICES_NUM個</param>
+	/// <returns>一部でも重なっていればtrue</returns>
+	bool IsVisible(const CustomVertex* pRect);
+
+	/// <summary>
+	/// 次に判定するメッシュのワールド行列を設定し,カメラの行列と合わせてメッシュの座標系での視錐台を求める
+	/// Camera::SetTransformが呼ばれる前は視錐台が決まらないので,メッシュを除外しない
+	/// </summary>
+	/// <param name="rWorld">[in]メッシュのワールド行列</param>
+	void SetWorld(const D3DXMATRIX& rWorld);
+
+	/// <summary>
+	/// メッシュの座標系の軸に沿った直方体が視錐台と重なっているかを判定する
+	/// </summary>
+	/// <param name="rMin">[in]直方体の最小の座標</param>
+	/// <param name="rMax">[in]直方体の最大の座標</param>
+	/// <returns>一部でも重なっている,直方体が不正,またはカメラが設定されていなければtrue</returns>
+	bool IsVisible(const D3DXVECTOR3& rMin, const D3DXVECTOR3& rMax);
+
+	inline const CullerStats& GetStats() const
+	{
+		return m_lastFrameStats;
+	}
+
+private:
+	static const int m_FRUSTUM_PLANES_NUM = 6;
+
+	const Camera* m_pCAMERA = nullptr;
+
+	float m_viewportLeft	= 0.0f;
+	float m_viewportTop		= 0.0f;
+	float m_viewportRight	= 0.0f;
+	float m_viewportBottom	= 0.0f;
+
+	//! 内側が正になる視錐台の面
+	D3DXPLANE m_frustumPlanes[m_FRUSTUM_PLANES_NUM];
+
+	//! SetWorldの時点でカメラが設定されていなければfalse
+	bool m_isFrustumValid = false;
+
+	CullerStats m_stats;
+
+	CullerStats m_lastFrameStats;
+};
+
+#endif //! CULLER_H
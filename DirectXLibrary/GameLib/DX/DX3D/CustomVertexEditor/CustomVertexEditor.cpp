@@ -9,6 +9,10 @@
 
 #include <Windows.h>
 
+#include <algorithm>
+
+#include <xmmintrin.h>
+
 #include <d3dx9.h>
 
 #include "Algorithm\Algorithm.h"
@@ -345,6 +349,291 @@ void CustomVertexEditor::Create(CustomVertex *pCustomVertices, const VerticesPar
 	RotateXYZ(pCustomVertices, verticesParam.m_deg);
 }
 
+void CustomVertexEditor::CreateRects(CustomVertex* pCustomVertices, const VerticesParam* pVerticesParams, UINT rectsNum) const
+{
+	CreateBatch(pCustomVertices, pVerticesParams, rectsNum);
+}
+
+void CustomVertexEditor::RotateXYZBatch(CustomVertex* pCustomVertices, const RotateValueXYZ* pDegs, UINT rectsNum) const
+{
+	D3DXMATRIX rotates[m_LANES_NUM];
+	bool isRotated[m_LANES_NUM];
+
+	for (UINT i = 0; i < rectsNum; i += m_LANES_NUM)
+	{
+		UINT groupRectsNum = (std::min)(rectsNum - i, m_LANES_NUM);
+
+		for (UINT j = 0; j < groupRectsNum; ++j)
+		{
+			isRotated[j] = ComposeRotateXYZ(&rotates[j], pDegs[i + j]);
+		}
+
+		RotateAroundCenters(&pCustomVertices[i * m_RECT_VERTICES_NUM], rotates, isRotated, groupRectsNum);
+	}
+}
+
+void CustomVertexEditor::RescaleBatch(CustomVertex* pCustomVertices, const D3DXVECTOR2* pScaleRates, UINT rectsNum) const
+{
+	UINT groupedRectsNum = rectsNum - rectsNum % m_LANES_NUM;
+
+	for (UINT i = 0; i < groupedRectsNum; i += m_LANES_NUM)
+	{
+		const CustomVertex* pRects[m_LANES_NUM] =
+		{
+			&pCustomVertices[i * m_RECT_VERTICES_NUM],
+			&pCustomVertices[(i + 1) * m_RECT_VERTICES_NUM],
+			&pCustomVertices[(i + 2) * m_RECT_VERTICES_NUM],
+			&pCustomVertices[(i + 3) * m_RECT_VERTICES_NUM]
+		};
+
+		//! Rescaleと同じ順番で計算し結果をそろえる
+		__m128 half		= _mm_set1_ps(0.5f);
+		__m128 centerX	= _mm_mul_ps(_mm_add_ps(
+			_mm_setr_ps(pRects[0][0].m_pos.x, pRects[1][0].m_pos.x, pRects[2][0].m_pos.x, pRects[3][0].m_pos.x),
+			_mm_setr_ps(pRects[0][2].m_pos.x, pRects[1][2].m_pos.x, pRects[2][2].m_pos.x, pRects[3][2].m_pos.x)), half);
+		__m128 centerY	= _mm_mul_ps(_mm_add_ps(
+			_mm_setr_ps(pRects[0][0].m_pos.y, pRects[1][0].m_pos.y, pRects[2][0].m_pos.y, pRects[3][0].m_pos.y),
+			_mm_setr_ps(pRects[0][2].m_pos.y, pRects[1][2].m_pos.y, pRects[2][2].m_pos.y, pRects[3][2].m_pos.y)), half);
+
+		__m128 scaleRateX = _mm_setr_ps(pScaleRates[i].x, pScaleRates[i + 1].x, pScaleRates[i + 2].x, pScaleRates[i + 3].x);
+		__m128 scaleRateY = _mm_setr_ps(pScaleRates[i].y, pScaleRates[i + 1].y, pScaleRates[i + 2].y, pScaleRates[i + 3].y);
+
+		//! 4矩形の同じ位置の頂点をまとめて計算する
+		for (int j = 0; j < m_RECT_VERTICES_NUM; ++j)
+		{
+			__m128 xs = _mm_setr_ps(pRects[0][j].m_pos.x, pRects[1][j].m_pos.x, pRects[2][j].m_pos.x, pRects[3][j].m_pos.x);
+			__m128 ys = _mm_setr_ps(pRects[0][j].m_pos.y, pRects[1][j].m_pos.y, pRects[2][j].m_pos.y, pRects[3][j].m_pos.y);
+
+			float resultXs[m_LANES_NUM];
+			float resultYs[m_LANES_NUM];
+			_mm_storeu_ps(resultXs, _mm_add_ps(_mm_mul_ps(scaleRateX, _mm_sub_ps(xs, centerX)), centerX));
+			_mm_storeu_ps(resultYs, _mm_add_ps(_mm_mul_ps(scaleRateY, _mm_sub_ps(ys, centerY)), centerY));
+
+			for (UINT k = 0; k < m_LANES_NUM; ++k)
+			{
+				CustomVertex& rVertex = pCustomVertices[(i + k) * m_RECT_VERTICES_NUM + j];
+
+				rVertex.m_pos.x = resultXs[k];
+				rVertex.m_pos.y = resultYs[k];
+			}
+		}
+	}
+
+	for (UINT i = groupedRectsNum; i < rectsNum; ++i)
+	{
+		Rescale(&pCustomVertices[i * m_RECT_VERTICES_NUM], pScaleRates[i]);
+	}
+}
+
+void CustomVertexEditor::MoveBatch(CustomVertex* pCustomVertices, const D3DXVECTOR3* pMovements, UINT rectsNum) const
+{
+	for (UINT i = 0; i < rectsNum; ++i)
+	{
+		Move(&pCustomVertices[i * m_RECT_VERTICES_NUM], pMovements[i]);
+	}
+}
+
+void CustomVertexEditor::CreateBatch(CustomVertex* pCustomVertices, const VerticesParam* pVerticesParams, UINT rectsNum) const
+{
+	D3DXMATRIX rotates[m_LANES_NUM];
+	bool isRotated[m_LANES_NUM];
+
+	for (UINT i = 0; i < rectsNum; i += m_LANES_NUM)
+	{
+		UINT groupRectsNum = (std::min)(rectsNum - i, m_LANES_NUM);
+
+		for (UINT j = 0; j < groupRectsNum; ++j)
+		{
+			const VerticesParam& rVerticesParam = pVerticesParams[i + j];
+
+			Create(
+				&pCustomVertices[(i + j) * m_RECT_VERTICES_NUM],
+				rVerticesParam.m_center, rVerticesParam.m_halfScale,
+				rVerticesParam.m_aRGB,
+				rVerticesParam.m_texUV.m_startTU, rVerticesParam.m_texUV.m_startTV,
+				rVerticesParam.m_texUV.m_endTU, rVerticesParam.m_texUV.m_endTV);
+
+			isRotated[j] = ComposeRotateXYZ(&rotates[j], rVerticesParam.m_deg);
+		}
+
+		RotateAroundCenters(&pCustomVertices[i * m_RECT_VERTICES_NUM], rotates, isRotated, groupRectsNum);
+	}
+}
+
+bool CustomVertexEditor::ComposeRotateXYZ(D3DXMATRIX* pRotate, const RotateValueXYZ& deg) const
+{
+	if (deg.x == 0.0f && deg.y == 0.0f && deg.z == 0.0f) return false;
+
+	D3DXMatrixIdentity(pRotate);
+
+	//! RotateXYZと同じくX,Y,Zの順に回転させる 角度が0の軸は掛けない
+	D3DXMATRIX rotate;
+
+	if (deg.x != 0.0f)
+	{
+		D3DXMatrixRotationX(&rotate, D3DXToRadian(deg.x));
+		D3DXMatrixMultiply(pRotate, pRotate, &rotate);
+	}
+
+	if (deg.y != 0.0f)
+	{
+		D3DXMatrixRotationY(&rotate, D3DXToRadian(deg.y));
+		D3DXMatrixMultiply(pRotate, pRotate, &rotate);
+	}
+
+	if (deg.z != 0.0f)
+	{
+		D3DXMatrixRotationZ(&rotate, D3DXToRadian(deg.z));
+		D3DXMatrixMultiply(pRotate, pRotate, &rotate);
+	}
+
+	return true;
+}
+
+void CustomVertexEditor::RotateAroundCenter(CustomVertex* pCustomVertices, const D3DXMATRIX& rRotate) const
+{
+	D3DXVECTOR3 rectCenter((pCustomVertices[0].m_pos + pCustomVertices[2].m_pos) * 0.5f);
+
+	__m128 centerX = _mm_set1_ps(rectCenter.x);
+	__m128 centerY = _mm_set1_ps(rectCenter.y);
+	__m128 centerZ = _mm_set1_ps(rectCenter.z);
+
+	//! 4頂点の座標を要素ごとに並べ,中心が原点になるように移動させる
+	__m128 xs = _mm_sub_ps(_mm_setr_ps(pCustomVertices[0].m_pos.x, pCustomVertices[1].m_pos.x, pCustomVertices[2].m_pos.x, pCustomVertices[3].m_pos.x), centerX);
+	__m128 ys = _mm_sub_ps(_mm_setr_ps(pCustomVertices[0].m_pos.y, pCustomVertices[1].m_pos.y, pCustomVertices[2].m_pos.y, pCustomVertices[3].m_pos.y), centerY);
+	__m128 zs = _mm_sub_ps(_mm_setr_ps(pCustomVertices[0].m_pos.z, pCustomVertices[1].m_pos.z, pCustomVertices[2].m_pos.z, pCustomVertices[3].m_pos.z), centerZ);
+
+	//! 回転行列なので平行移動とwによる除算は省く
+	__m128 rotatedXs = _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(xs, _mm_set1_ps(rRotate._11)),
+		_mm_mul_ps(ys, _mm_set1_ps(rRotate._21))),
+		_mm_mul_ps(zs, _mm_set1_ps(rRotate._31)));
+
+	__m128 rotatedYs = _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(xs, _mm_set1_ps(rRotate._12)),
+		_mm_mul_ps(ys, _mm_set1_ps(rRotate._22))),
+		_mm_mul_ps(zs, _mm_set1_ps(rRotate._32)));
+
+	__m128 rotatedZs = _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(xs, _mm_set1_ps(rRotate._13)),
+		_mm_mul_ps(ys, _mm_set1_ps(rRotate._23))),
+		_mm_mul_ps(zs, _mm_set1_ps(rRotate._33)));
+
+	float resultXs[m_RECT_VERTICES_NUM];
+	float resultYs[m_RECT_VERTICES_NUM];
+	float resultZs[m_RECT_VERTICES_NUM];
+	_mm_storeu_ps(resultXs, _mm_add_ps(rotatedXs, centerX));
+	_mm_storeu_ps(resultYs, _mm_add_ps(rotatedYs, centerY));
+	_mm_storeu_ps(resultZs, _mm_add_ps(rotatedZs, centerZ));
+
+	for (int i = 0; i < m_RECT_VERTICES_NUM; ++i)
+	{
+		pCustomVertices[i].m_pos.x = resultXs[i];
+		pCustomVertices[i].m_pos.y = resultYs[i];
+		pCustomVertices[i].m_pos.z = resultZs[i];
+	}
+}
+
+void CustomVertexEditor::RotateAroundCenters(CustomVertex* pCustomVertices, const D3DXMATRIX* pRotates, const bool* pIsRotated, UINT rectsNum) const
+{
+	bool isAnyRotated = false;
+
+	for (UINT i = 0; i < rectsNum; ++i)
+	{
+		isAnyRotated |= pIsRotated[i];
+	}
+
+	if (!isAnyRotated) return;
+
+	//! 4矩形そろわない端数は矩形ごとに計算する
+	if (rectsNum < m_LANES_NUM)
+	{
+		for (UINT i = 0; i < rectsNum; ++i)
+		{
+			if (!pIsRotated[i]) continue;
+
+			RotateAroundCenter(&pCustomVertices[i * m_RECT_VERTICES_NUM], pRotates[i]);
+		}
+
+		return;
+	}
+
+	//! 回転させない矩形は単位行列で計算し,書き戻さない
+	D3DXMATRIX rotates[m_LANES_NUM];
+
+	for (UINT i = 0; i < m_LANES_NUM; ++i)
+	{
+		if (pIsRotated[i])
+		{
+			rotates[i] = pRotates[i];
+
+			continue;
+		}
+
+		D3DXMatrixIdentity(&rotates[i]);
+	}
+
+	//! 行列の要素ごとに4矩形分を並べる
+	auto LoadLanes = [&rotates](UINT row, UINT column)
+	{
+		return _mm_setr_ps(rotates[0](row, column), rotates[1](row, column), rotates[2](row, column), rotates[3](row, column));
+	};
+
+	__m128 rotate11 = LoadLanes(0, 0), rotate12 = LoadLanes(0, 1), rotate13 = LoadLanes(0, 2);
+	__m128 rotate21 = LoadLanes(1, 0), rotate22 = LoadLanes(1, 1), rotate23 = LoadLanes(1, 2);
+	__m128 rotate31 = LoadLanes(2, 0), rotate32 = LoadLanes(2, 1), rotate33 = LoadLanes(2, 2);
+
+	const CustomVertex* pRects[m_LANES_NUM] =
+	{
+		&pCustomVertices[0],
+		&pCustomVertices[m_RECT_VERTICES_NUM],
+		&pCustomVertices[2 * m_RECT_VERTICES_NUM],
+		&pCustomVertices[3 * m_RECT_VERTICES_NUM]
+	};
+
+	//! RotateAroundCenterと同じ順番で計算し結果をそろえる
+	__m128 half		= _mm_set1_ps(0.5f);
+	__m128 centerX	= _mm_mul_ps(_mm_add_ps(
+		_mm_setr_ps(pRects[0][0].m_pos.x, pRects[1][0].m_pos.x, pRects[2][0].m_pos.x, pRects[3][0].m_pos.x),
+		_mm_setr_ps(pRects[0][2].m_pos.x, pRects[1][2].m_pos.x, pRects[2][2].m_pos.x, pRects[3][2].m_pos.x)), half);
+	__m128 centerY	= _mm_mul_ps(_mm_add_ps(
+		_mm_setr_ps(pRects[0][0].m_pos.y, pRects[1][0].m_pos.y, pRects[2][0].m_pos.y, pRects[3][0].m_pos.y),
+		_mm_setr_ps(pRects[0][2].m_pos.y, pRects[1][2].m_pos.y, pRects[2][2].m_pos.y, pRects[3][2].m_pos.y)), half);
+	__m128 centerZ	= _mm_mul_ps(_mm_add_ps(
+		_mm_setr_ps(pRects[0][0].m_pos.z, pRects[1][0].m_pos.z, pRects[2][0].m_pos.z, pRects[3][0].m_pos.z),
+		_mm_setr_ps(pRects[0][2].m_pos.z, pRects[1][2].m_pos.z, pRects[2][2].m_pos.z, pRects[3][2].m_pos.z)), half);
+
+	//! 4矩形の同じ位置の頂点をまとめて計算する
+	for (int i = 0; i < m_RECT_VERTICES_NUM; ++i)
+	{
+		__m128 xs = _mm_sub_ps(_mm_setr_ps(pRects[0][i].m_pos.x, pRects[1][i].m_pos.x, pRects[2][i].m_pos.x, pRects[3][i].m_pos.x), centerX);
+		__m128 ys = _mm_sub_ps(_mm_setr_ps(pRects[0][i].m_pos.y, pRects[1][i].m_pos.y, pRects[2][i].m_pos.y, pRects[3][i].m_pos.y), centerY);
+		__m128 zs = _mm_sub_ps(_mm_setr_ps(pRects[0][i].m_pos.z, pRects[1][i].m_pos.z, pRects[2][i].m_pos.z, pRects[3][i].m_pos.z), centerZ);
+
+		__m128 rotatedXs = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, rotate11), _mm_mul_ps(ys, rotate21)), _mm_mul_ps(zs, rotate31));
+		__m128 rotatedYs = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, rotate12), _mm_mul_ps(ys, rotate22)), _mm_mul_ps(zs, rotate32));
+		__m128 rotatedZs = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, rotate13), _mm_mul_ps(ys, rotate23)), _mm_mul_ps(zs, rotate33));
+
+		float resultXs[m_LANES_NUM];
+		float resultYs[m_LANES_NUM];
+		float resultZs[m_LANES_NUM];
+		_mm_storeu_ps(resultXs, _mm_add_ps(rotatedXs, centerX));
+		_mm_storeu_ps(resultYs, _mm_add_ps(rotatedYs, centerY));
+		_mm_storeu_ps(resultZs, _mm_add_ps(rotatedZs, centerZ));
+
+		for (UINT j = 0; j < m_LANES_NUM; ++j)
+		{
+			if (!pIsRotated[j]) continue;
+
+			CustomVertex& rVertex = pCustomVertices[j * m_RECT_VERTICES_NUM + i];
+
+			rVertex.m_pos.x = resultXs[j];
+			rVertex.m_pos.y = resultYs[j];
+			rVertex.m_pos.z = resultZs[j];
+		}
+	}
+}
+
 void CustomVertexEditor::SetAverageARGB(DWORD* averageARGB, DWORD aARGB, DWORD bARGB) const
 {
 	BYTE alphaValue[2] = { static_cast<BYTE>(aARGB >> 24) ,static_cast<BYTE>(bARGB >> 24) };
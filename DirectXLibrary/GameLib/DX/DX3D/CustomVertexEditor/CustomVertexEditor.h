@@ -158,13 +158,76 @@ public:
 	*/
 	void Create(CustomVertex *pCustomVertices, const VerticesParam& verticesParam) const;
 
+	/// <summary>
+	/// 複数の矩形の頂点データを連続した配列に作成する 共有のインデックスバッファでまとめて描画できる
+	/// </summary>
+	/// <param name="pCustomVertices">[out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pVerticesParams">[in]矩形の数の長さを持つオブジェクトの状態構造体配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	void CreateRects(CustomVertex* pCustomVertices, const VerticesParam* pVerticesParams, UINT rectsNum) const;
+
+	/// <summary>
+	/// 複数の矩形をそれぞれの中心でXYZ順に回転させる 3軸の回転は矩形ごとに1つの行列にまとめ4矩形の同じ位置の頂点を同時に計算する
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pDegs">[in]矩形の数の長さを持つ度数法での角度の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	void RotateXYZBatch(CustomVertex* pCustomVertices, const RotateValueXYZ* pDegs, UINT rectsNum) const;
+
+	/// <summary>
+	/// 複数の矩形をそれぞれの中心で拡縮させる 4矩形の同じ位置の頂点を同時に計算する
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pScaleRates">[in]矩形の数の長さを持つ拡縮率の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	void RescaleBatch(CustomVertex* pCustomVertices, const D3DXVECTOR2* pScaleRates, UINT rectsNum) const;
+
+	/// <summary>
+	/// 複数の矩形をそれぞれ移動させる
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pMovements">[in]矩形の数の長さを持つ移動量の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	void MoveBatch(CustomVertex* pCustomVertices, const D3DXVECTOR3* pMovements, UINT rectsNum) const;
+
+	/// <summary>
+	/// 複数の矩形の頂点データを作成する 回転はRotateXYZBatchと同じく矩形ごとに1つの行列で行う
+	/// </summary>
+	/// <param name="pCustomVertices">[out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pVerticesParams">[in]矩形の数の長さを持つオブジェクトの状態構造体配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	void CreateBatch(CustomVertex* pCustomVertices, const VerticesParam* pVerticesParams, UINT rectsNum) const;
+
 private:
 	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
 
 	static const int m_RECT_VERTICES_NUM = 4;	//! 矩形を構成する頂点の数
 
+	static const UINT m_LANES_NUM = 4;	//! SSEレジスタ1つに入るfloatの数 一度に計算する矩形の数
+
 	void Rotate(CustomVertex* pCustomVertices, const D3DXVECTOR3& relativeRotateCenter, const D3DXMATRIX& rRotate) const;
 
+	/// <summary>
+	/// X,Y,Zの回転行列をこの順に掛け合わせた行列を作成する
+	/// </summary>
+	/// <returns>回転させる必要がなければfalse</returns>
+	bool ComposeRotateXYZ(D3DXMATRIX* pRotate, const RotateValueXYZ& deg) const;
+
+	/// <summary>
+	/// 矩形の4頂点を1つのSSEレジスタの4要素として,矩形の中心で回転させる
+	/// </summary>
+	void RotateAroundCenter(CustomVertex* pCustomVertices, const D3DXMATRIX& rRotate) const;
+
+	/// <summary>
+	/// 連続したm_LANES_NUM個までの矩形をそれぞれの中心で回転させる
+	/// m_LANES_NUM個そろっていれば4矩形の同じ位置の頂点を1つのSSEレジスタの4要素として計算する
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pRotates">[in]矩形の数の長さを持つ回転行列の配列の先頭アドレス</param>
+	/// <param name="pIsRotated">[in]矩形の数の長さを持つ回転させるかの配列の先頭アドレス falseの矩形は書き換えない</param>
+	/// <param name="rectsNum">矩形の数 m_LANES_NUM以下</param>
+	void RotateAroundCenters(CustomVertex* pCustomVertices, const D3DXMATRIX* pRotates, const bool* pIsRotated, UINT rectsNum) const;
+
 	void SetAverageARGB(DWORD* averageARGB, DWORD aARGB, DWORD bARGB) const;
 };
 
@@ -0,0 +1,121 @@
+﻿/// <filename>
+/// Sprite.cpp
+/// </filename>
+/// <summary>
+/// 作成した頂点データを保持し,変更があった時のみ作り直す矩形のクラスのソース
+/// </summary>
+
+#include "Sprite.h"
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "VerticesParam.h"
+#include "DX\DX3D\CustomVertexEditor\CustomVertexEditor.h"
+
+void Sprite::SetVerticesParam(const VerticesParam& verticesParam)
+{
+	SetCenter(verticesParam.m_center);
+	SetHalfScale(verticesParam.m_halfScale);
+	SetDeg(verticesParam.m_deg);
+	SetARGB(verticesParam.m_aRGB);
+	SetTexUV(verticesParam.m_texUV);
+}
+
+void Sprite::SetCenter(const D3DXVECTOR3& center)
+{
+	if (m_verticesParam.m_center == center) return;
+
+	m_verticesParam.m_center = center;
+
+	MarkDirty(DIRTY_CENTER);
+}
+
+void Sprite::SetHalfScale(const D3DXVECTOR3& halfScale)
+{
+	if (m_verticesParam.m_halfScale == halfScale) return;
+
+	m_verticesParam.m_halfScale = halfScale;
+
+	MarkDirty(DIRTY_SHAPE);
+}
+
+void Sprite::SetDeg(const RotateValueXYZ& deg)
+{
+	if (m_verticesParam.m_deg == deg) return;
+
+	m_verticesParam.m_deg = deg;
+
+	MarkDirty(DIRTY_SHAPE);
+}
+
+void Sprite::SetARGB(DWORD aRGB)
+{
+	if (m_verticesParam.m_aRGB == aRGB) return;
+
+	m_verticesParam.m_aRGB = aRGB;
+
+	MarkDirty(DIRTY_COLOR);
+}
+
+void Sprite::SetTexUV(const TexUV& texUV)
+{
+	const TexUV& rCurrentTexUV = m_verticesParam.m_texUV;
+
+	if (rCurrentTexUV.m_startTU == texUV.m_startTU && rCurrentTexUV.m_startTV == texUV.m_startTV &&
+		rCurrentTexUV.m_endTU == texUV.m_endTU && rCurrentTexUV.m_endTV == texUV.m_endTV) return;
+
+	m_verticesParam.m_texUV = texUV;
+
+	MarkDirty(DIRTY_TEX_UV);
+}
+
+bool Sprite::Update(const CustomVertexEditor& rCustomVertexEditor)
+{
+	if (!m_dirtyFlags) return false;
+
+	if (m_dirtyFlags & DIRTY_SHAPE)
+	{
+		//! 原点を中心として作成し,中心からのずれとして保持する
+		VerticesParam shapeParam = m_verticesParam;
+		shapeParam.m_center = D3DXVECTOR3(0.0f, 0.0f, 0.0f);
+
+		rCustomVertexEditor.Create(m_vertices, shapeParam);
+
+		for (int i = 0; i < CustomVertex::m_RECT_VERTICES_NUM; ++i)
+		{
+			m_offsetsFromCenter[i] = m_vertices[i].m_pos;
+		}
+
+		//! Createで色とテクスチャ座標も設定されている
+		m_dirtyFlags &= ~(DIRTY_COLOR | DIRTY_TEX_UV);
+		m_dirtyFlags |= DIRTY_CENTER;
+	}
+
+	if (m_dirtyFlags & DIRTY_CENTER)
+	{
+		//! 移動の差分を足すと誤差が溜まるので,毎回中心とずれから求める
+		for (int i = 0; i < CustomVertex::m_RECT_VERTICES_NUM; ++i)
+		{
+			m_vertices[i].m_pos = m_verticesParam.m_center + m_offsetsFromCenter[i];
+		}
+	}
+
+	if (m_dirtyFlags & DIRTY_COLOR)
+	{
+		rCustomVertexEditor.SetARGB(m_vertices, m_verticesParam.m_aRGB);
+	}
+
+	if (m_dirtyFlags & DIRTY_TEX_UV)
+	{
+		const TexUV& rTexUV = m_verticesParam.m_texUV;
+
+		rCustomVertexEditor.SetTexUV(m_vertices, rTexUV.m_startTU, rTexUV.m_startTV, rTexUV.m_endTU, rTexUV.m_endTV);
+	}
+
+	m_dirtyFlags = 0;
+
+	return true;
+}
@@ -0,0 +1,106 @@
+﻿/// <filename>
+/// Sprite.h
+/// </filename>
+/// <summary>
+/// 作成した頂点データを保持し,変更があった時のみ作り直す矩形のクラスのヘッダ
+/// </summary>
+
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "VerticesParam.h"
+#include "DX\DX3D\CustomVertexEditor\CustomVertexEditor.h"
+
+/// <summary>
+/// 作成した頂点データを保持し,変更があった時のみ作り直す矩形のクラス
+/// </summary>
+/// <remarks>
+/// 回転と拡縮は中心からのずれとして保持するので,移動だけなら回転の計算を行わない
+/// </remarks>
+class Sprite
+{
+public:
+	Sprite() {};
+	explicit Sprite(const VerticesParam& verticesParam) :m_verticesParam(verticesParam) {};
+	~Sprite() {};
+
+	inline const VerticesParam& GetVerticesParam() const
+	{
+		return m_verticesParam;
+	}
+
+	/// <summary>
+	/// 状態をまとめて設定する 変わった要素のみ作り直す
+	/// </summary>
+	/// <param name="verticesParam">[in]頂点情報配列を作成するためのデータ</param>
+	void SetVerticesParam(const VerticesParam& verticesParam);
+
+	void SetCenter(const D3DXVECTOR3& center);
+
+	void SetHalfScale(const D3DXVECTOR3& halfScale);
+
+	void SetDeg(const RotateValueXYZ& deg);
+
+	void SetARGB(DWORD aRGB);
+
+	void SetTexUV(const TexUV& texUV);
+
+	/// <summary>
+	/// 状態が変わるたびに増える値 保持している頂点データと比べて古いかを判別できる
+	/// </summary>
+	inline UINT GetVersion() const
+	{
+		return m_version;
+	}
+
+	/// <summary>
+	/// 変更があった要素のみ頂点データを作り直す
+	/// </summary>
+	/// <param name="rCustomVertexEditor">[in]頂点データの編集に使うクラス</param>
+	/// <returns>作り直した場合true</returns>
+	bool Update(const CustomVertexEditor& rCustomVertexEditor);
+
+	/// <summary>
+	/// 最後にUpdateした時点の頂点データを取得する
+	/// </summary>
+	/// <returns>頂点データ配列の先頭アドレス</returns>
+	inline const CustomVertex* GetVertices() const
+	{
+		return m_vertices;
+	}
+
+private:
+	enum DIRTY_FLAG : UINT
+	{
+		DIRTY_CENTER	= 1 << 0,
+		DIRTY_SHAPE		= 1 << 1,
+		DIRTY_COLOR		= 1 << 2,
+		DIRTY_TEX_UV	= 1 << 3,
+		DIRTY_ALL		= DIRTY_CENTER | DIRTY_SHAPE | DIRTY_COLOR | DIRTY_TEX_UV,
+	};
+
+	inline void MarkDirty(UINT dirtyFlags)
+	{
+		m_dirtyFlags |= dirtyFlags;
+
+		++m_version;
+	}
+
+	VerticesParam m_verticesParam;
+
+	CustomVertex m_vertices[CustomVertex::m_RECT_VERTICES_NUM];
+
+	//! 回転と拡縮を行った後の中心から各頂点までのずれ
+	D3DXVECTOR3 m_offsetsFromCenter[CustomVertex::m_RECT_VERTICES_NUM];
+
+	UINT m_dirtyFlags = DIRTY_ALL;
+
+	UINT m_version = 0;
+};
+
+#endif //! SPRITE_H
@@ -0,0 +1,130 @@
+﻿/// <filename>
+/// D3DBoardInstanceBackend.cpp
+/// </filename>
+/// <summary>
+/// 板ポリのインスタンスをDirect3Dで描画するクラスのソース
+/// </summary>
+
+#include "D3DBoardInstanceBackend.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <algorithm>
+
+#include <d3dx9.h>
+
+#include "3DBoard\3DBoard.h"
+#include "3DBoard\BoardInstanceRenderer\IBoardInstanceBackend.h"
+#include "DX\DX3D\VertexRingBuffer\VertexRingBuffer.h"
+#include "DX\DX3D\QuadIndexBuffer\QuadIndexBuffer.h"
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+D3DBoardInstanceBackend::D3DBoardInstanceBackend(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache,
+	VertexRingBuffer* pVertexRingBuffer, const QuadIndexBuffer* pQuadIndexBuffer)
+	:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_pRenderStateCache(pRenderStateCache),
+	m_pVertexRingBuffer(pVertexRingBuffer), m_pQuadIndexBuffer(pQuadIndexBuffer)
+{
+	m_fallbackIndices.resize(m_INSTANCES_PER_LOCK * QuadIndexBuffer::m_QUAD_INDICES_NUM);
+
+	QuadIndexBuffer::WriteIndices(m_fallbackIndices.data(), m_INSTANCES_PER_LOCK);
+}
+
+void D3DBoardInstanceBackend::DrawBatch(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture)
+{
+	//! 頂点はワールド座標に変換済みなのでワールド行列は単位行列にする
+	D3DXMATRIX identity;
+	D3DXMatrixIdentity(&identity);
+	m_pDX_GRAPHIC_DEVICE->SetTransform(D3DTS_WORLD, &identity);
+
+	m_pRenderStateCache->SetFVF(
+		D3DFVF_XYZ |
+		D3DFVF_NORMAL |
+		D3DFVF_DIFFUSE |
+		D3DFVF_TEX1);
+
+	m_pRenderStateCache->SetTexture(0, pTexture);
+
+	UINT instancesPerLock = m_INSTANCES_PER_LOCK;
+
+	if (m_pQuadIndexBuffer->GetQuadsMax() > 0)
+	{
+		instancesPerLock = (std::min)(instancesPerLock, m_pQuadIndexBuffer->GetQuadsMax());
+	}
+
+	for (UINT first = 0; first < instancesNum; first += instancesPerLock)
+	{
+		UINT chunkInstancesNum	= (std::min)(instancesPerLock, instancesNum - first);
+		UINT chunkVerticesNum	= chunkInstancesNum * QuadIndexBuffer::m_QUAD_VERTICES_NUM;
+
+		UINT startVertex = 0;
+
+		Vertex3D* pVertices = static_cast<Vertex3D*>(m_pVertexRingBuffer->Lock(chunkVerticesNum, sizeof(Vertex3D), &startVertex));
+
+		bool usesRingBuffer = (pVertices != nullptr);
+
+		if (!usesRingBuffer)
+		{
+			m_fallbackVertices.resize(chunkVerticesNum);
+
+			pVertices = m_fallbackVertices.data();
+		}
+
+		for (UINT i = 0; i < chunkInstancesNum; ++i)
+		{
+			ExpandInstance(pInstances[first + i], &pVertices[i * QuadIndexBuffer::m_QUAD_VERTICES_NUM]);
+		}
+
+		if (usesRingBuffer)
+		{
+			m_pVertexRingBuffer->Unlock();
+
+			m_pVertexRingBuffer->SetStreamSource(sizeof(Vertex3D));
+
+			if (m_pQuadIndexBuffer->DrawQuads(startVertex, chunkInstancesNum)) continue;
+
+			//! インデックスバッファで描画できなかった場合は書き込んだ頂点をメモリ上に写して描画する
+			m_fallbackVertices.resize(chunkVerticesNum);
+
+			for (UINT i = 0; i < chunkInstancesNum; ++i)
+			{
+				ExpandInstance(pInstances[first + i], &m_fallbackVertices[i * QuadIndexBuffer::m_QUAD_VERTICES_NUM]);
+			}
+
+			pVertices = m_fallbackVertices.data();
+		}
+
+		m_pDX_GRAPHIC_DEVICE->DrawIndexedPrimitiveUP(
+			D3DPT_TRIANGLELIST,
+			0,
+			chunkVerticesNum,
+			chunkInstancesNum * 2,
+			m_fallbackIndices.data(), D3DFMT_INDEX16,
+			pVertices, sizeof(Vertex3D));
+
+		m_pRenderStateCache->OnDrawUP();
+	}
+}
+
+void D3DBoardInstanceBackend::ExpandInstance(const BoardInstance& rInstance, Vertex3D* pVertices)
+{
+	D3DXVECTOR3 unitNormal(0.0f, 0.0f, -1.0f);
+	D3DXVECTOR3 normal;
+	D3DXVec3TransformNormal(&normal, &unitNormal, &rInstance.m_world);
+	D3DXVec3Normalize(&normal, &normal);
+
+	//! Board3D::CreateRectと同じ頂点の順番
+	for (UINT i = 0; i < QuadIndexBuffer::m_QUAD_VERTICES_NUM; ++i)
+	{
+		D3DXVECTOR3 unitPos((i % 3) ? 1.0f : -1.0f, (i / 2) ? 1.0f : -1.0f, 0.0f);
+
+		D3DXVec3TransformCoord(&pVertices[i].m_Pos, &unitPos, &rInstance.m_world);
+
+		pVertices[i].m_Normal = normal;
+
+		pVertices[i].m_Color = rInstance.m_aRGB;
+
+		pVertices[i].m_Tu = (i % 3) ? rInstance.m_texUV.m_endTU : rInstance.m_texUV.m_startTU;
+		pVertices[i].m_Tv = (i / 2) ? rInstance.m_texUV.m_endTV : rInstance.m_texUV.m_startTV;
+	}
+}
@@ -0,0 +1,64 @@
+﻿/// <filename>
+/// D3DBoardInstanceBackend.h
+/// </filename>
+/// <summary>
+/// 板ポリのインスタンスをDirect3Dで描画するクラスのヘッダ
+/// </summary>
+
+#ifndef D3D_BOARD_INSTANCE_BACKEND_H
+#define D3D_BOARD_INSTANCE_BACKEND_H
+
+#include <Windows.h>
+
+#include <vector>
+
+#include <d3dx9.h>
+
+#include "3DBoard\3DBoard.h"
+#include "3DBoard\BoardInstanceRenderer\IBoardInstanceBackend.h"
+#include "DX\DX3D\VertexRingBuffer\VertexRingBuffer.h"
+#include "DX\DX3D\QuadIndexBuffer\QuadIndexBuffer.h"
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+/// <summary>
+/// 板ポリのインスタンスをDirect3Dで描画するクラス
+/// </summary>
+/// <remarks>
+/// D3D9のハードウェアインスタンシング(SetStreamSourceFreq)は頂点シェーダが必要で固定機能パイプラインでは使えないため,
+/// 共有の単位板ポリをCPUでインスタンスごとに変換してリングバッファへ書き込み,共有のインデックスバッファでまとめて一度で描画する
+/// </remarks>
+class D3DBoardInstanceBackend :public IBoardInstanceBackend
+{
+public:
+	D3DBoardInstanceBackend(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache,
+		VertexRingBuffer* pVertexRingBuffer, const QuadIndexBuffer* pQuadIndexBuffer);
+	~D3DBoardInstanceBackend() {};
+
+	void DrawBatch(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture);
+
+private:
+	/// <summary>
+	/// 単位板ポリをインスタンスのワールド行列で変換し4頂点を作成する
+	/// </summary>
+	/// <param name="rInstance">[in]変換するインスタンス</param>
+	/// <param name="pVertices">[out]4頂点を書き込む先</param>
+	static void ExpandInstance(const BoardInstance& rInstance, Vertex3D* pVertices);
+
+	//! 一度にリングバッファから確保するインスタンスの数 16bitのインデックスで表せる頂点数に収まるようにする
+	static const UINT m_INSTANCES_PER_LOCK = 8192;
+
+	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	RenderStateCache* m_pRenderStateCache = nullptr;
+
+	VertexRingBuffer* m_pVertexRingBuffer = nullptr;
+
+	const QuadIndexBuffer* m_pQuadIndexBuffer = nullptr;
+
+	//! リングバッファが使えない時に用いる
+	std::vector<Vertex3D> m_fallbackVertices;
+
+	std::vector<WORD> m_fallbackIndices;
+};
+
+#endif //! D3D_BOARD_INSTANCE_BACKEND_H
@@ -13,11 +13,20 @@
 #include <d3dx9.h>
 
 #include "D3DPP/D3DPP.h"
+#include "RenderStateCache/RenderStateCache.h"
 #include "ColorBlender/ColorBlender.h"
 #include "Light/Light.h"
 #include "TexStorage/TexStorage.h"
 #include "Camera/Camera.h"
+#include "Culler/Culler.h"
 #include "CustomVertexEditor/CustomVertexEditor.h"
+#include "QuadIndexBuffer/QuadIndexBuffer.h"
+#include "SpriteBatch/SpriteBatch.h"
+#include "VertexRingBuffer/VertexRingBuffer.h"
+#include "RenderQueue/RenderQueue.h"
+#include "D3DBoardInstanceBackend/D3DBoardInstanceBackend.h"
+#include "3DBoard/BoardInstanceRenderer/BoardInstanceRenderer.h"
+#include "GlyphCache/GlyphCache.h"
 #include "Renderer/Renderer.h"
 #include "FbxStorage/FbxStorage.h"
 #include "FontStorage/FontStorage.h"
@@ -30,24 +39,42 @@ DX3D::DX3D(HWND hWnd, RectSize wndSize, LPDIRECT3D9 pD3D)
 {
 	Create(pD3D);
 
-	m_pDX3DDev->SetRenderState(D3DRS_ZENABLE, true);
+	m_pRenderStateCache = new RenderStateCache(m_pDX3DDev);
+
+	m_pRenderStateCache->SetRenderState(D3DRS_ZENABLE, true);
 
 	//! コメントアウトしているときはカリングを行うということ(ポリゴンの裏を描画しない)
 	//m_pDX3DDev->SetRenderState(D3DRS_CULLMODE, D3DCULL_NONE);
 
-	m_pColorBlender = new ColorBlender(m_pDX3DDev);
+	m_pColorBlender = new ColorBlender(m_pRenderStateCache);
 	m_pColorBlender->DefaultColorBlending();
 
-	m_pLight = new Light(m_pDX3DDev);
+	m_pLight = new Light(m_pDX3DDev, m_pRenderStateCache);
 	m_pLight->DefaultLighting();
 
 	m_pTexStorage = new TexStorage(m_pDX3DDev);
 
 	m_pCamera = new Camera(m_pDX3DDev);
 
+	m_pCuller = new Culler(m_pCamera);
+
 	m_pCustomVertex = new CustomVertexEditor(m_pDX3DDev);
 
-	m_pRenderer = new Renderer(m_pDX3DDev);
+	m_pVertexRingBuffer = new VertexRingBuffer(m_pDX3DDev, m_pRenderStateCache);
+
+	m_pQuadIndexBuffer = new QuadIndexBuffer(m_pDX3DDev, m_pRenderStateCache);
+
+	m_pSpriteBatch = new SpriteBatch(m_pDX3DDev, m_pRenderStateCache, m_pVertexRingBuffer, m_pQuadIndexBuffer);
+
+	m_pGlyphCache = new GlyphCache(m_pDX3DDev, m_pSpriteBatch);
+
+	m_pRenderer = new Renderer(m_pDX3DDev, m_pRenderStateCache, m_pSpriteBatch, m_pVertexRingBuffer, m_pQuadIndexBuffer, m_pGlyphCache, m_pCuller);
+
+	m_pRenderQueue = new RenderQueue(m_pSpriteBatch, m_pColorBlender, m_pCuller);
+
+	m_pBoardInstanceBackend = new D3DBoardInstanceBackend(m_pDX3DDev, m_pRenderStateCache, m_pVertexRingBuffer, m_pQuadIndexBuffer);
+
+	m_pBoardInstanceRenderer = new BoardInstanceRenderer();
 
 	m_pFbxStorage = new FbxStorage(m_pDX3DDev);
 
@@ -71,10 +98,21 @@ void DX3D::PrepareRendering() const
 		0);
 
 	m_pDX3DDev->BeginScene();
+
+	m_pGlyphCache->BeginFrame();
+
+	m_pCuller->BeginFrame();
 }
 
 void DX3D::CleanUpRendering() const
 {
+	FlushBoardInstances();
+
+	m_pRenderQueue->Flush();
+
+	//! フレーム中に溜めた矩形を描画しきってから終了宣言を行う
+	m_pSpriteBatch->Flush();
+
 	m_pDX3DDev->EndScene();
 	m_pDX3DDev->Present(
 		NULL,
@@ -87,9 +125,15 @@ void DX3D::ToggleWndMode()
 {
 	D3DPRESENT_PARAMETERS D3DPP = m_D3DPP->ToggleD3DPPWndMode();
 
+	//! D3DPOOL_DEFAULTのリソースはReset前に開放しなければならない
+	m_pVertexRingBuffer->Release();
+
 	//! スワップチェーンのタイプ、サイズ、およびフォーマットをリセット
 	HRESULT hr = m_pDX3DDev->Reset(&D3DPP);
 
+	//! Resetでデバイスの状態は初期値に戻るので覚えている状態は使えない
+	m_pRenderStateCache->Invalidate();
+
 	InvalidateRect(m_HWND, NULL, false);
 	UpdateWindow(nullptr);
 
@@ -110,6 +154,8 @@ void DX3D::ToggleWndMode()
 		GWL_STYLE,
 		windowStyle);
 
+	m_pVertexRingBuffer->Create();
+
 	m_pColorBlender->DefaultColorBlending();
 
 	InitViewPort();
@@ -180,4 +226,6 @@ inline void DX3D::InitViewPort()
 	viewPort.X		= 0;
 	viewPort.Y		= 0;
 	m_pDX3DDev->SetViewport(&viewPort);
+
+	m_pCuller->SetViewport(viewPort);
 }
@@ -12,11 +12,21 @@
 #include <d3dx9.h>
 
 #include "D3DPP/D3DPP.h"
+#include "RenderStateCache/RenderStateCache.h"
 #include "ColorBlender/ColorBlender.h"
 #include "Light/Light.h"
 #include "TexStorage/TexStorage.h"
 #include "Camera/Camera.h"
+#include "Culler/Culler.h"
 #include "CustomVertexEditor/CustomVertexEditor.h"
+#include "CustomVertexEditor/Sprite/Sprite.h"
+#include "QuadIndexBuffer/QuadIndexBuffer.h"
+#include "SpriteBatch/SpriteBatch.h"
+#include "VertexRingBuffer/VertexRingBuffer.h"
+#include "RenderQueue/RenderQueue.h"
+#include "D3DBoardInstanceBackend/D3DBoardInstanceBackend.h"
+#include "3DBoard/BoardInstanceRenderer/BoardInstanceRenderer.h"
+#include "GlyphCache/GlyphCache.h"
 #include "Renderer/Renderer.h"
 #include "FbxStorage/FbxStorage.h"
 #include "FontStorage/FontStorage.h"
@@ -34,12 +44,21 @@ public:
 	~DX3D()
 	{
 		delete m_pFbxStorage;
+		delete m_pBoardInstanceRenderer;
+		delete m_pBoardInstanceBackend;
+		delete m_pRenderQueue;
 		delete m_pRenderer;
+		delete m_pGlyphCache;
+		delete m_pSpriteBatch;
+		delete m_pVertexRingBuffer;
+		delete m_pQuadIndexBuffer;
 		delete m_pCustomVertex;
+		delete m_pCuller;
 		delete m_pCamera;
 		delete m_pTexStorage;
 		delete m_pLight;
 		delete m_pColorBlender;
+		delete m_pRenderStateCache;
 		delete m_D3DPP;
 		delete m_pFont;
 		m_pDX3DDev->Release();
@@ -65,6 +84,11 @@ public:
 	*/
 	inline void DefaultBlendMode() const
 	{
+		if (m_pColorBlender->GetBlendMode() == ColorBlender::BLEND_MODE::DEFAULT) return;
+
+		//! 溜めている矩形は変更前の合成で描画しなければいけない
+		m_pSpriteBatch->Flush();
+
 		m_pColorBlender->DefaultBlendMode();
 	}
 
@@ -73,6 +97,10 @@ public:
 	*/
 	inline void AddtionBlendMode() const
 	{
+		if (m_pColorBlender->GetBlendMode() == ColorBlender::BLEND_MODE::ADDITION) return;
+
+		m_pSpriteBatch->Flush();
+
 		m_pColorBlender->AddtionBlendMode();
 	}
 
@@ -81,6 +109,8 @@ public:
 	*/
 	inline void DefaultColorBlending() const
 	{
+		m_pSpriteBatch->Flush();
+
 		m_pColorBlender->DefaultColorBlending();
 	}
 
@@ -165,10 +195,11 @@ public:
 	* @brief テクスチャを作成する
 	* @param pTexKey テクスチャにつける名前のポインタ キー 連想配列
 	* @param pTexPath 画像のパスのポインタ
+	* @return テクスチャのハンドル 既に作成されている場合はそのハンドル 作成できなかった場合何も指さない
 	*/
-	inline void CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
+	inline TexHandle CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
 	{
-		m_pTexStorage->CreateTex(pTexKey, pTexPath);
+		return m_pTexStorage->CreateTex(pTexKey, pTexPath);
 	}
 
 	/**
@@ -197,6 +228,26 @@ public:
 	{
 		return m_pTexStorage->GetTex(pTexKey);
 	}
+
+	/// <summary>
+	/// テクスチャのハンドルを取得する 毎フレーム描画するものは一度取得したハンドルを使い続ける
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャを作るときに決めたキー</param>
+	/// <returns>作成されていない場合何も指さない</returns>
+	inline TexHandle GetTexHandle(const TCHAR* pTexKey) const
+	{
+		return m_pTexStorage->GetTexHandle(pTexKey);
+	}
+
+	/// <summary>
+	/// ハンドルの指すテクスチャを取得する キーで取得するより速い
+	/// </summary>
+	/// <returns>何も指さないか,指していたテクスチャが開放されている場合nullptr</returns>
+	inline const LPDIRECT3DTEXTURE9 GetTex(TexHandle texHandle) const
+	{
+		return m_pTexStorage->GetTex(texHandle);
+	}
+
 	/**
 	* @brief テクスチャが生成されているか判断する
 	* @param pTexKey テクスチャを作るときに決めたキーのポインタ
@@ -207,6 +258,47 @@ public:
 		return m_pTexStorage->Exists(pTexKey);
 	}
 
+	/// <summary>
+	/// 画像をアトラスのページに詰めて作成する 同じページの画像同士はテクスチャを切り替えずに描画できる
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャにつける名前</param>
+	/// <param name="pTexPath">[in]画像のパス</param>
+	inline void CreateAtlasTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
+	{
+		m_pTexStorage->CreateAtlasTex(pTexKey, pTexPath);
+	}
+
+	/// <summary>
+	/// CreateAtlasTexで作成したテクスチャとその中での画像の座標を取得する
+	/// 座標はVerticesParam::m_texUVにそのまま入れられる
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャを作るときに決めた名前</param>
+	/// <returns>テクスチャと座標</returns>
+	inline AtlasTex GetAtlasTex(const TCHAR* pTexKey) const
+	{
+		return m_pTexStorage->GetAtlasTex(pTexKey);
+	}
+
+	/// <summary>
+	/// アトラスのページと画像の座標の表を書き出す
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]書き出すファイルのパスの先頭 ページは(先頭)(番号).png,表は(先頭).txtになる</param>
+	/// <returns>書き出せなかった場合false</returns>
+	inline bool SaveAtlas(const TCHAR* pFilePathPrefix) const
+	{
+		return m_pTexStorage->SaveAtlas(pFilePathPrefix);
+	}
+
+	/// <summary>
+	/// SaveAtlasで書き出したページと表を読み込む 読み込んだ画像はGetAtlasTexで取得できる
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]SaveAtlasに渡したファイルのパスの先頭</param>
+	/// <returns>読み込めなかった場合false</returns>
+	inline bool LoadAtlas(const TCHAR* pFilePathPrefix)
+	{
+		return m_pTexStorage->LoadAtlas(pFilePathPrefix);
+	}
+
 	/**
 	* @brief 現在のカメラの位置を取得する
 	* @param[out] pCameraPos カメラ位置を入れる
@@ -516,6 +608,50 @@ public:
 		m_pCustomVertex->Create(pCustomVertices, verticesParam);
 	}
 
+	/// <summary>
+	/// 複数の矩形の頂点データを連続した配列に作成する 共有のインデックスバッファでまとめて描画できる
+	/// </summary>
+	/// <param name="pCustomVertices">[out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pVerticesParams">[in]矩形の数の長さを持つオブジェクトの状態構造体配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void CreateRects(CustomVertex* pCustomVertices, const VerticesParam* pVerticesParams, UINT rectsNum) const
+	{
+		m_pCustomVertex->CreateRects(pCustomVertices, pVerticesParams, rectsNum);
+	}
+
+	/// <summary>
+	/// 複数の矩形をそれぞれの中心でXYZ順に回転させる
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pDegs">[in]矩形の数の長さを持つ度数法での角度の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void RotateRectsXYZ(CustomVertex* pCustomVertices, const D3DXVECTOR3* pDegs, UINT rectsNum) const
+	{
+		m_pCustomVertex->RotateXYZBatch(pCustomVertices, pDegs, rectsNum);
+	}
+
+	/// <summary>
+	/// 複数の矩形をそれぞれの中心で拡縮させる
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pScaleRates">[in]矩形の数の長さを持つ拡縮率の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void RescaleRects(CustomVertex* pCustomVertices, const D3DXVECTOR2* pScaleRates, UINT rectsNum) const
+	{
+		m_pCustomVertex->RescaleBatch(pCustomVertices, pScaleRates, rectsNum);
+	}
+
+	/// <summary>
+	/// 複数の矩形をそれぞれ移動させる
+	/// </summary>
+	/// <param name="pCustomVertices">[in,out]矩形の数*4の長さを持つ頂点データ配列の先頭アドレス</param>
+	/// <param name="pMovements">[in]矩形の数の長さを持つ移動量の配列の先頭アドレス</param>
+	/// <param name="rectsNum">矩形の数</param>
+	inline void MoveRects(CustomVertex* pCustomVertices, const D3DXVECTOR3* pMovements, UINT rectsNum) const
+	{
+		m_pCustomVertex->MoveBatch(pCustomVertices, pMovements, rectsNum);
+	}
+
 	/**
 	* @brief FBXの描画を行う
 	* @param rFBXModel FBXのクラス モデルを読み込んだ後でないといけない
@@ -548,6 +684,29 @@ public:
 		m_pRenderer->Render(pVertex3D, rWorld, pTexture);
 	}
 
+	/// <summary>
+	/// 連続して並んでいる複数の矩形をまとめて描画する
+	/// </summary>
+	/// <param name="pCustomVertices">[in]矩形の数*4の頂点データの先頭ポインタ CreateRectsで作成する</param>
+	/// <param name="rectsNum">矩形の数</param>
+	/// <param name="pTexture">ポリゴンに張り付けるテクスチャのポインタ</param>
+	inline void RenderRects(const CustomVertex* pCustomVertices, UINT rectsNum, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		m_pRenderer->Render(pCustomVertices, rectsNum, pTexture);
+	}
+
+	/// <summary>
+	/// 連続して並んでいる複数の板ポリを同じワールド行列で一度に描画する
+	/// </summary>
+	/// <param name="pVertices">[in]板ポリの数*4の頂点データの先頭ポインタ Board3D::CreateRectsで作成する</param>
+	/// <param name="boardsNum">板ポリの数</param>
+	/// <param name="rWorld">拡大回転移動行列をまとめた行列</param>
+	/// <param name="pTexture">板ポリに張り付けるテクスチャのポインタ</param>
+	inline void RenderBoards(const Vertex3D* pVertices, UINT boardsNum, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		m_pRenderer->Render(pVertices, boardsNum, rWorld, pTexture);
+	}
+
 	/// <summary>
 	/// 文字の描画を行う
 	/// </summary>
@@ -561,6 +720,19 @@ public:
 		m_pRenderer->Render(topLeft, pText, format, pFont, color);
 	}
 
+	/// <summary>
+	/// UTF-8の文字列の描画を行う
+	/// </summary>
+	/// <param name="topLeft">[in]左上の座標</param>
+	/// <param name="pText">[in]描画したいUTF-8の文字列</param>
+	/// <param name="format">文字のフォーマット DT_LEFT(左寄せ)等</param>
+	/// <param name="pFont">描画する際に使うフォントオブジェクト</param>
+	/// <param name="color">文字の色ARGB</param>
+	inline void RenderUTF8(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color)
+	{
+		m_pRenderer->RenderUTF8(topLeft, pText, format, pFont, color);
+	}
+
 	/// <summary>
 	/// 矩形の描画を行う
 	/// </summary>
@@ -575,6 +747,164 @@ public:
 		m_pRenderer->Render(vertices, pTexture);
 	}
 
+	/// <summary>
+	/// 矩形の描画命令を積む 描画の終了宣言の前に並べ替えられ,まとめて描画される
+	/// </summary>
+	/// <param name="verticesParam">頂点情報配列を作成するためのデータ</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	/// <param name="blendMode">矩形を描画する際の色の合成</param>
+	/// <param name="layer">描画する層 大きいほど後に描画される</param>
+	inline void Submit(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const
+	{
+		CustomVertex vertices[CustomVertex::m_RECT_VERTICES_NUM];
+
+		m_pCustomVertex->Create(vertices, verticesParam);
+
+		m_pRenderQueue->Submit(vertices, pTexture, blendMode, layer);
+	}
+
+	inline void Submit(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const
+	{
+		m_pRenderQueue->Submit(pCustomVertices, pTexture, blendMode, layer);
+	}
+
+	/// <summary>
+	/// 保持している頂点データで矩形の描画を行う 変更があった要素のみ頂点データを作り直す
+	/// </summary>
+	/// <param name="pSprite">[in,out]描画する矩形</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	inline void Render(Sprite* pSprite, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		pSprite->Update(*m_pCustomVertex);
+
+		m_pRenderer->Render(pSprite->GetVertices(), pTexture);
+	}
+
+	/// <summary>
+	/// 保持している頂点データで矩形の描画命令を積む 変更があった要素のみ頂点データを作り直す
+	/// </summary>
+	/// <param name="pSprite">[in,out]描画する矩形</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	/// <param name="blendMode">矩形を描画する際の色の合成</param>
+	/// <param name="layer">描画する層 大きいほど後に描画される</param>
+	inline void Submit(Sprite* pSprite, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const
+	{
+		pSprite->Update(*m_pCustomVertex);
+
+		m_pRenderQueue->Submit(pSprite->GetVertices(), pTexture, blendMode, layer);
+	}
+
+	/// <summary>
+	/// 最後に描画したフレームの描画命令の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const RenderQueueStats& GetRenderQueueStats() const
+	{
+		return m_pRenderQueue->GetStats();
+	}
+
+	/// <summary>
+	/// 3Dの板ポリとFBXの頂点を書き込む頂点バッファの確保の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const VertexRingBufferStats& GetVertexRingBufferStats() const
+	{
+		return m_pVertexRingBuffer->GetStats();
+	}
+
+	/// <summary>
+	/// 状態の設定をデバイスへ渡した回数と省いた回数の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const RenderStateCacheStats& GetRenderStateCacheStats() const
+	{
+		return m_pRenderStateCache->GetStats();
+	}
+
+	/// <summary>
+	/// 状態の設定の回数の統計を0にする
+	/// </summary>
+	inline void ResetRenderStateCacheStats() const
+	{
+		m_pRenderStateCache->ResetStats();
+	}
+
+	/// <summary>
+	/// 文字の画像を使いまわした回数と作成した回数の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const GlyphCacheStats& GetGlyphCacheStats() const
+	{
+		return m_pGlyphCache->GetStats();
+	}
+
+	/// <summary>
+	/// 文字の画像の統計を0にする
+	/// </summary>
+	inline void ResetGlyphCacheStats() const
+	{
+		m_pGlyphCache->ResetStats();
+	}
+
+	/// <summary>
+	/// 文字列の配置を使いまわした回数と保持している大きさの統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const TextLayoutCacheStats& GetTextLayoutCacheStats() const
+	{
+		return m_pGlyphCache->GetTextLayoutStats();
+	}
+
+	/// <summary>
+	/// 文字列の配置の統計を0にする
+	/// </summary>
+	inline void ResetTextLayoutCacheStats() const
+	{
+		m_pGlyphCache->ResetTextLayoutStats();
+	}
+
+	/// <summary>
+	/// 最後に終了したフレームで画面外として描画しなかった矩形とメッシュの数の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const CullerStats& GetCullerStats() const
+	{
+		return m_pCuller->GetStats();
+	}
+
+	/// <summary>
+	/// 板ポリのインスタンスを積む テクスチャごとにまとめて一度で描画される
+	/// </summary>
+	/// <param name="pInstances">[in]インスタンスの配列の先頭アドレス Board3D::CreateInstanceで作成する</param>
+	/// <param name="instancesNum">インスタンスの数</param>
+	/// <param name="pTexture">板ポリに張り付けるテクスチャのポインタ</param>
+	inline void RenderInstances(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const
+	{
+		m_pBoardInstanceRenderer->Submit(pInstances, instancesNum, pTexture);
+	}
+
+	/// <summary>
+	/// 積まれた板ポリのインスタンスを描画する 呼ばなくても描画の終了宣言の前に描画される
+	/// </summary>
+	inline void FlushBoardInstances() const
+	{
+		m_pSpriteBatch->Flush();
+
+		m_pBoardInstanceRenderer->Flush(m_pBoardInstanceBackend);
+	}
+
+	/// <summary>
+	/// 最後に板ポリのインスタンスを描画した際の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const BoardInstanceStats& GetBoardInstanceStats() const
+	{
+		return m_pBoardInstanceRenderer->GetStats();
+	}
+
 	/// <summary>
 	/// FBXオブジェクトの作成を行う
 	/// </summary>
@@ -600,6 +930,8 @@ public:
 	/// </summary>
 	inline void AllFontRelease()
 	{
+		m_pGlyphCache->Clear();
+
 		m_pFont->AllRelease();
 	}
 
@@ -609,6 +941,11 @@ public:
 	/// <param name="pFontKey">開放したいフォントのキー</param>
 	inline void ReleaseFont(const TCHAR* pFontKey)
 	{
+		if (!m_pFont->Exists(pFontKey)) return;
+
+		//! 開放されたフォントのアドレスが再利用されても古い文字の画像を使わないようにする
+		m_pGlyphCache->ReleaseFont(m_pFont->GetFont(pFontKey));
+
 		m_pFont->Release(pFontKey);
 	}
 
@@ -666,6 +1003,8 @@ private:
 
 	D3DPP* m_D3DPP = nullptr;
 
+	RenderStateCache* m_pRenderStateCache = nullptr;
+
 	ColorBlender* m_pColorBlender = nullptr;
 
 	Light* m_pLight = nullptr;
@@ -674,10 +1013,26 @@ private:
 
 	Camera* m_pCamera = nullptr;
 
+	Culler* m_pCuller = nullptr;
+
 	CustomVertexEditor* m_pCustomVertex = nullptr;
 
+	QuadIndexBuffer* m_pQuadIndexBuffer = nullptr;
+
+	SpriteBatch* m_pSpriteBatch = nullptr;
+
+	GlyphCache* m_pGlyphCache = nullptr;
+
+	VertexRingBuffer* m_pVertexRingBuffer = nullptr;
+
 	Renderer* m_pRenderer = nullptr;
 
+	RenderQueue* m_pRenderQueue = nullptr;
+
+	D3DBoardInstanceBackend* m_pBoardInstanceBackend = nullptr;
+
+	BoardInstanceRenderer* m_pBoardInstanceRenderer = nullptr;
+
 	FbxStorage* m_pFbxStorage = nullptr;
 
 	FontStorage* m_pFont = nullptr;
@@ -7,6 +7,8 @@
 #include <fbxsdk.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <cfloat>
 #include <crtdbg.h>
 #include "FbxModel.h"
 
@@ -18,15 +20,54 @@ FbxModel::FbxModel(const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE)
 	m_pDevice = m_pDX_GRAPHIC_DEVICE;
 
 	m_pFbxModelData = NULL;
+
+	//	GetPositionで頂点を読むたびに広げるので,最初は最小値と最大値を逆にしておく
+	maxX = maxY = maxZ = -FLT_MAX;
+	minX = minY = minZ = FLT_MAX;
+	maxR = 0.0f;
 }
 
 FbxModel::~FbxModel()
 {
 }
 
-void FbxModel::DrawFbx()
+void FbxModel::DrawFbx(VertexRingBuffer* pVertexRingBuffer, RenderStateCache* pRenderStateCache)
+{
+	UINT verticesNum = m_pFbxModelData->polygonCount * 3;
+	UINT startVertex = 0;
+
+	Vertex* pDstVertices = static_cast<Vertex*>(pVertexRingBuffer->Lock(verticesNum, sizeof(Vertex), &startVertex));
+
+	SetDrawStates(pRenderStateCache);
+
+	if (!pDstVertices)
+	{
+		m_pDevice->DrawPrimitiveUP(
+			D3DPT_TRIANGLELIST,
+			m_pFbxModelData->polygonCount,
+			m_pFbxModelData->pVertex,
+			sizeof(Vertex));
+
+		pRenderStateCache->OnDrawUP();
+
+		return;
+	}
+
+	memcpy(pDstVertices, m_pFbxModelData->pVertex, sizeof(Vertex) * verticesNum);
+
+	pVertexRingBuffer->Unlock();
+
+	pVertexRingBuffer->SetStreamSource(sizeof(Vertex));
+
+	m_pDevice->DrawPrimitive(
+		D3DPT_TRIANGLELIST,
+		startVertex,
+		m_pFbxModelData->polygonCount);
+}
+
+void FbxModel::SetDrawStates(RenderStateCache* pRenderStateCache)
 {
-	m_pDevice->SetFVF(MY_FVF);
+	pRenderStateCache->SetFVF(MY_FVF);
 
 	for (D3DMATERIAL9& i : m_pFbxModelData->MaterialData)
 	{
@@ -37,14 +78,8 @@ void FbxModel::DrawFbx()
 
 	for (unsigned int n = 0; n < m_pFbxModelData->pTextureData.size(); n++)
 	{
-		m_pDevice->SetTexture(n, m_pFbxModelData->pTextureData[n]->m_pTexture);
+		pRenderStateCache->SetTexture(n, m_pFbxModelData->pTextureData[n]->m_pTexture);
 	}
-
-	m_pDevice->DrawPrimitiveUP(
-		D3DPT_TRIANGLELIST,
-		m_pFbxModelData->polygonCount,
-		m_pFbxModelData->pVertex,
-		sizeof(Vertex));
 }
 
 void FbxModel::SetEmissive(const D3DXVECTOR4* pARGB)
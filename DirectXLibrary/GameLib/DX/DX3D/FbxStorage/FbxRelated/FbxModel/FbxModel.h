@@ -14,6 +14,9 @@
 #include <list>
 #include <vector>
 
+#include "DX\DX3D\VertexRingBuffer\VertexRingBuffer.h"
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
 #define MY_FVF (D3DFVF_XYZ | D3DFVF_NORMAL | D3DFVF_TEX2)
 
 /**
@@ -77,12 +80,14 @@ private:
 	FbxModelData* m_pFbxModelData;					//!<	全モデルデータ
 	IDirect3DDevice9*			m_pDevice;			//!<	Direct3Dのデバイス
 
+	void SetDrawStates(RenderStateCache* pRenderStateCache);							//!<	FVF,マテリアル,テクスチャの設定関数
+
 public:
 	float maxX, maxY, maxZ, minX, minY, minZ, maxR;
 
 	FbxModel(const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE);
 	~FbxModel();
-	void DrawFbx();
+	void DrawFbx(VertexRingBuffer* pVertexRingBuffer, RenderStateCache* pRenderStateCache);	//!<	頂点をリングバッファに書き込んで描画する 状態の設定はpRenderStateCacheを通す
 
 	void SetAmbient(const D3DXVECTOR4* pARGB);											//!<	モデルを発光させる関数
 	void SetDiffuse(const D3DXVECTOR4* pARGB);
@@ -37,6 +37,8 @@ public:
 		{
 			i.second->Release();
 		}
+
+		m_fonts.clear();
 	}
 
 	/// <summary>
@@ -0,0 +1,608 @@
+﻿/// <filename>
+/// GlyphCache.cpp
+/// </filename>
+/// <summary>
+/// 文字の画像をテクスチャに保持し矩形として描画するクラスのソース
+/// </summary>
+
+#include "GlyphCache.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <list>
+#include <map>
+#include <climits>
+#include <algorithm>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\SpriteBatch\SpriteBatch.h"
+#include "TextLayoutCache\TextLayoutCache.h"
+
+bool GlyphCache::Render(const D3DXVECTOR2& topLeft, const WCHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds)
+{
+	if (!m_pPageTexture && !CreatePage()) return false;
+
+	if (GetCellSizeClassIndex(pFont) == m_NO_CELL) return false;
+
+	const TextLayout* pLayout = m_textLayoutCache.Find(pFont, pText, format, m_generation);
+
+	if (pLayout)
+	{
+		TouchLayout(pFont, *pLayout);
+	}
+	else
+	{
+		if (!Layout(pText, format, pFont, &m_layout)) return false;
+
+		m_textLayoutCache.Store(pFont, pText, format, m_generation, m_layout);
+
+		pLayout = &m_layout;
+	}
+
+	int originX = static_cast<int>(topLeft.x);
+	int originY = static_cast<int>(topLeft.y);
+
+	for (const CustomVertex& rVertex : pLayout->m_vertices)
+	{
+		CustomVertex vertex = rVertex;
+
+		vertex.m_pos.x	+= static_cast<float>(originX);
+		vertex.m_pos.y	+= static_cast<float>(originY);
+		vertex.m_aRGB	= color;
+
+		m_vertices.push_back(vertex);
+	}
+
+	if (pBounds)
+	{
+		*pBounds = pLayout->m_bounds;
+
+		OffsetRect(pBounds, originX, originY);
+	}
+
+	SubmitVertices();
+
+	return true;
+}
+
+bool GlyphCache::Render(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds)
+{
+	return RenderMultiByte(CP_ACP, topLeft, pText, format, pFont, color, pBounds);
+}
+
+bool GlyphCache::RenderUTF8(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds)
+{
+	return RenderMultiByte(CP_UTF8, topLeft, pText, format, pFont, color, pBounds);
+}
+
+void GlyphCache::ReleaseFont(LPD3DXFONT pFont)
+{
+	//! 空いた区画に別の文字が書き込まれる前に描画しておく
+	SubmitVertices();
+	m_pSpriteBatch->Flush();
+
+	for (auto glyph = m_glyphs.begin(); glyph != m_glyphs.end();)
+	{
+		if (glyph->first.m_pFont != pFont)
+		{
+			++glyph;
+
+			continue;
+		}
+
+		UINT cellIndex = glyph->second.m_cellIndex;
+
+		if (cellIndex != m_NO_CELL)
+		{
+			CellSizeClass& rSizeClass = m_cellSizeClasses[m_cells[cellIndex].m_sizeClassIndex];
+
+			rSizeClass.m_freeCells.push_back(cellIndex);
+
+			rSizeClass.m_lru.erase(glyph->second.m_lruPosition);
+		}
+
+		glyph = m_glyphs.erase(glyph);
+	}
+
+	m_textMetrics.erase(pFont);
+	m_kerningPairs.erase(pFont);
+
+	m_textLayoutCache.ReleaseFont(pFont);
+}
+
+void GlyphCache::Clear()
+{
+	if (m_pPageTexture)
+	{
+		SubmitVertices();
+		m_pSpriteBatch->Flush();
+
+		m_pPageTexture->Release();
+		m_pPageTexture = nullptr;
+	}
+
+	m_glyphs.clear();
+	m_cells.clear();
+	m_cellSizeClasses.clear();
+	m_textMetrics.clear();
+	m_kerningPairs.clear();
+
+	m_rowsBottom = 0;
+
+	m_textLayoutCache.Clear();
+
+	++m_generation;
+}
+
+bool GlyphCache::Layout(const WCHAR* pText, UINT format, LPD3DXFONT pFont, TextLayout* pLayout)
+{
+	const TEXTMETRICW& rTextMetrics = GetTextMetrics(pFont);
+
+	const std::map<UINT, int>& rKerningPairs = GetKerningPairs(pFont);
+
+	bool isSingleLine = ((format & DT_SINGLELINE) != 0);
+
+	//! 中央寄せ,右寄せのために先に行ごとの幅を求める 文字はここで一度だけ取得し,配置にも使う
+	m_lineWidths.assign(1, 0);
+	m_layoutGlyphs.clear();
+	m_layoutKernings.clear();
+
+	UINT generation = m_generation;
+
+	for (const WCHAR* pChar = pText; *pChar; ++pChar)
+	{
+		if (*pChar == L'\n' && !isSingleLine)
+		{
+			m_layoutGlyphs.push_back(nullptr);
+			m_layoutKernings.push_back(0);
+			m_lineWidths.push_back(0);
+
+			continue;
+		}
+
+		const Glyph* pGlyph = Acquire(pFont, *pChar);
+
+		//! 描画できない文字を飛ばすと文字列が欠けるので,文字列ごとID3DXFontで描画させる
+		if (!pGlyph) return false;
+
+		//! 行の先頭の文字は前の文字がないので詰めない
+		int kerning = 0;
+
+		if (pChar != pText && m_layoutGlyphs.back())
+		{
+			auto kerningPair = rKerningPairs.find((static_cast<UINT>(*(pChar - 1)) << 16) | static_cast<UINT>(*pChar));
+
+			if (kerningPair != rKerningPairs.end()) kerning = kerningPair->second;
+		}
+
+		m_layoutGlyphs.push_back(pGlyph);
+		m_layoutKernings.push_back(kerning);
+
+		m_lineWidths.back() += kerning + pGlyph->m_advance;
+	}
+
+	//! 取得中に追い出しが起きた場合,先に取得した文字が追い出されていないかを引き直して確かめる
+	if (generation != m_generation)
+	{
+		for (size_t i = 0; i < m_layoutGlyphs.size(); ++i)
+		{
+			if (!m_layoutGlyphs[i]) continue;
+
+			GlyphKey key = { pFont, static_cast<UINT>(pText[i]) };
+
+			auto glyph = m_glyphs.find(key);
+
+			if (glyph == m_glyphs.end()) return false;
+
+			m_layoutGlyphs[i] = &glyph->second;
+		}
+	}
+
+	int blockWidth = *std::max_element(m_lineWidths.begin(), m_lineWidths.end());
+
+	auto GetLineLeft = [&](size_t line)
+	{
+		if (format & DT_CENTER) return (blockWidth - m_lineWidths[line]) / 2;
+
+		if (format & DT_RIGHT) return (blockWidth - m_lineWidths[line]);
+
+		return 0;
+	};
+
+	pLayout->m_vertices.clear();
+	pLayout->m_codePoints.clear();
+
+	size_t line = 0;
+
+	int penX		= GetLineLeft(line);
+	int baseLineY	= rTextMetrics.tmAscent;
+
+	for (size_t i = 0; pText[i]; ++i)
+	{
+		if (pText[i] == L'\n' && !isSingleLine)
+		{
+			++line;
+
+			penX		= GetLineLeft(line);
+			baseLineY	+= rTextMetrics.tmHeight;
+
+			continue;
+		}
+
+		const Glyph* pGlyph = m_layoutGlyphs[i];
+
+		if (!pGlyph) continue;
+
+		penX += m_layoutKernings[i];
+
+		if (pGlyph->m_cellIndex != m_NO_CELL)
+		{
+			const Cell& rCell = m_cells[pGlyph->m_cellIndex];
+
+			float cellLeft	= static_cast<float>(rCell.m_left);
+			float cellTop	= static_cast<float>(rCell.m_top);
+
+			//! テクセルとピクセルの中心を合わせるため0.5ずらす
+			float left		= static_cast<float>(penX + pGlyph->m_offsetX) - 0.5f;
+			float top		= static_cast<float>(baseLineY - pGlyph->m_offsetY) - 0.5f;
+			float width		= static_cast<float>(pGlyph->m_width);
+			float height	= static_cast<float>(pGlyph->m_height);
+
+			float pageSize = static_cast<float>(m_PAGE_SIZE);
+
+			CustomVertex vertices[CustomVertex::m_RECT_VERTICES_NUM];
+
+			//! CustomVertexEditor::Createと同じ頂点の順番
+			for (int i = 0; i < CustomVertex::m_RECT_VERTICES_NUM; ++i)
+			{
+				bool isRight	= (i == 1 || i == 2);
+				bool isBottom	= (i / 2 != 0);
+
+				vertices[i].m_pos = D3DXVECTOR3(left + (isRight ? width : 0.0f), top + (isBottom ? height : 0.0f), 0.0f);
+
+				vertices[i].m_texUV.x = (cellLeft + (isRight ? width : 0.0f)) / pageSize;
+				vertices[i].m_texUV.y = (cellTop + (isBottom ? height : 0.0f)) / pageSize;
+			}
+
+			pLayout->m_vertices.insert(pLayout->m_vertices.end(), vertices, vertices + CustomVertex::m_RECT_VERTICES_NUM);
+			pLayout->m_codePoints.push_back(static_cast<UINT>(pText[i]));
+		}
+
+		penX += pGlyph->m_advance;
+	}
+
+	SetRect(&pLayout->m_bounds, 0, 0, blockWidth, static_cast<int>(m_lineWidths.size()) * rTextMetrics.tmHeight);
+
+	return true;
+}
+
+const GlyphCache::Glyph* GlyphCache::Acquire(LPD3DXFONT pFont, UINT codePoint)
+{
+	//! GetGlyphOutlineWは基本多言語面の外の文字を扱えないので,サロゲートペアはID3DXFontに任せる
+	if (codePoint >= 0xD800 && codePoint <= 0xDFFF) return nullptr;
+
+	GlyphKey key = { pFont, codePoint };
+
+	auto glyph = m_glyphs.find(key);
+
+	if (glyph != m_glyphs.end())
+	{
+		Touch(&glyph->second);
+
+		++m_stats.m_hitsNum;
+
+		return &glyph->second;
+	}
+
+	Glyph newGlyph = {};
+
+	if (!Rasterize(pFont, codePoint, &newGlyph)) return nullptr;
+
+	newGlyph.m_lastUsedFrame = m_frame;
+
+	Glyph& rInsertedGlyph = m_glyphs[key] = newGlyph;
+
+	if (rInsertedGlyph.m_cellIndex != m_NO_CELL)
+	{
+		std::list<GlyphKey>& rLru = m_cellSizeClasses[m_cells[rInsertedGlyph.m_cellIndex].m_sizeClassIndex].m_lru;
+
+		rLru.push_front(key);
+
+		rInsertedGlyph.m_lruPosition = rLru.begin();
+	}
+
+	return &rInsertedGlyph;
+}
+
+void GlyphCache::TouchLayout(LPD3DXFONT pFont, const TextLayout& rLayout)
+{
+	//! 世代が変わっていないので配置した文字は全て残っている
+	for (UINT codePoint : rLayout.m_codePoints)
+	{
+		GlyphKey key = { pFont, codePoint };
+
+		auto glyph = m_glyphs.find(key);
+
+		if (glyph == m_glyphs.end()) continue;
+
+		Touch(&glyph->second);
+	}
+}
+
+void GlyphCache::Touch(Glyph* pGlyph)
+{
+	if (pGlyph->m_cellIndex != m_NO_CELL)
+	{
+		std::list<GlyphKey>& rLru = m_cellSizeClasses[m_cells[pGlyph->m_cellIndex].m_sizeClassIndex].m_lru;
+
+		rLru.splice(rLru.begin(), rLru, pGlyph->m_lruPosition);
+	}
+
+	pGlyph->m_lastUsedFrame = m_frame;
+}
+
+bool GlyphCache::Rasterize(LPD3DXFONT pFont, UINT codePoint, Glyph* pGlyph)
+{
+	//! ID3DXFontのDCには作成時のフォントが選択されている
+	HDC hDC = pFont->GetDC();
+
+	const MAT2 IDENTITY = { { 0, 1 }, { 0, 0 }, { 0, 0 }, { 0, 1 } };
+
+	GLYPHMETRICS glyphMetrics;
+
+	DWORD bytes = GetGlyphOutlineW(hDC, codePoint, GGO_GRAY8_BITMAP, &glyphMetrics, 0, NULL, &IDENTITY);
+
+	if (bytes == GDI_ERROR) return false;
+
+	pGlyph->m_cellIndex = m_NO_CELL;
+	pGlyph->m_offsetX	= glyphMetrics.gmptGlyphOrigin.x;
+	pGlyph->m_offsetY	= glyphMetrics.gmptGlyphOrigin.y;
+	pGlyph->m_width		= glyphMetrics.gmBlackBoxX;
+	pGlyph->m_height	= glyphMetrics.gmBlackBoxY;
+	pGlyph->m_advance	= glyphMetrics.gmCellIncX;
+
+	//! 空白などの画像を持たない文字は幅だけ使う
+	if (bytes == 0) return true;
+
+	//! 斜体や幅の広い文字は画像が行の高さを超えることがあるので,画像も収まる区画を選ぶ
+	UINT glyphSize = (std::max)({ static_cast<UINT>(GetTextMetrics(pFont).tmHeight), glyphMetrics.gmBlackBoxX, glyphMetrics.gmBlackBoxY });
+
+	UINT sizeClassIndex = GetCellSizeClassIndex(glyphSize);
+
+	if (sizeClassIndex == m_NO_CELL) return false;
+
+	m_grayBuffer.resize(bytes);
+
+	if (GetGlyphOutlineW(hDC, codePoint, GGO_GRAY8_BITMAP, &glyphMetrics, bytes, m_grayBuffer.data(), &IDENTITY) == GDI_ERROR) return false;
+
+	UINT cellIndex = AllocateCell(sizeClassIndex);
+
+	if (cellIndex == m_NO_CELL) return false;
+
+	//! GGO_GRAY8_BITMAPの各行は4バイト境界にそろえられている
+	UINT pitch = (glyphMetrics.gmBlackBoxX + 3) & ~3u;
+
+	if (!WriteCell(cellIndex, m_grayBuffer.data(), glyphMetrics.gmBlackBoxX, glyphMetrics.gmBlackBoxY, pitch))
+	{
+		m_cellSizeClasses[sizeClassIndex].m_freeCells.push_back(cellIndex);
+
+		return false;
+	}
+
+	pGlyph->m_cellIndex = cellIndex;
+
+	++m_stats.m_rasterizedGlyphsNum;
+
+	return true;
+}
+
+UINT GlyphCache::AllocateCell(UINT sizeClassIndex)
+{
+	CellSizeClass& rSizeClass = m_cellSizeClasses[sizeClassIndex];
+
+	if (rSizeClass.m_freeCells.empty()) AllocateRow(sizeClassIndex);
+
+	if (!rSizeClass.m_freeCells.empty())
+	{
+		UINT cellIndex = rSizeClass.m_freeCells.back();
+		rSizeClass.m_freeCells.pop_back();
+
+		return cellIndex;
+	}
+
+	if (rSizeClass.m_lru.empty()) return m_NO_CELL;
+
+	GlyphKey victimKey = rSizeClass.m_lru.back();
+
+	auto victim = m_glyphs.find(victimKey);
+
+	//! このフレームで使った文字の区画を上書きする場合は先に溜めている矩形を描画しておく
+	if (victim->second.m_lastUsedFrame == m_frame)
+	{
+		SubmitVertices();
+		m_pSpriteBatch->Flush();
+	}
+
+	UINT cellIndex = victim->second.m_cellIndex;
+
+	rSizeClass.m_lru.pop_back();
+	m_glyphs.erase(victim);
+
+	++m_stats.m_evictedGlyphsNum;
+
+	//! 区画の中身が変わったので保持している配置を使えなくする
+	++m_generation;
+
+	return cellIndex;
+}
+
+bool GlyphCache::AllocateRow(UINT sizeClassIndex)
+{
+	CellSizeClass& rSizeClass = m_cellSizeClasses[sizeClassIndex];
+
+	if (m_rowsBottom + rSizeClass.m_cellSize > m_PAGE_SIZE) return false;
+
+	UINT cellsNum = m_PAGE_SIZE / rSizeClass.m_cellSize;
+
+	//! 末尾から取り出すので左の区画から使われるよう右から積む
+	for (UINT i = cellsNum; i > 0; --i)
+	{
+		Cell cell = { (i - 1) * rSizeClass.m_cellSize, m_rowsBottom, sizeClassIndex };
+
+		rSizeClass.m_freeCells.push_back(static_cast<UINT>(m_cells.size()));
+
+		m_cells.push_back(cell);
+	}
+
+	m_rowsBottom += rSizeClass.m_cellSize;
+
+	return true;
+}
+
+UINT GlyphCache::GetCellSizeClassIndex(LPD3DXFONT pFont)
+{
+	return GetCellSizeClassIndex(static_cast<UINT>(GetTextMetrics(pFont).tmHeight));
+}
+
+UINT GlyphCache::GetCellSizeClassIndex(UINT size) const
+{
+	for (size_t i = 0; i < m_cellSizeClasses.size(); ++i)
+	{
+		if (size <= m_cellSizeClasses[i].m_cellSize) return static_cast<UINT>(i);
+	}
+
+	return m_NO_CELL;
+}
+
+bool GlyphCache::WriteCell(UINT cellIndex, const BYTE* pGray, UINT width, UINT height, UINT pitch)
+{
+	const Cell& rCell	= m_cells[cellIndex];
+	const UINT CELL_SIZE = m_cellSizeClasses[rCell.m_sizeClassIndex].m_cellSize;
+
+	LONG cellLeft	= static_cast<LONG>(rCell.m_left);
+	LONG cellTop	= static_cast<LONG>(rCell.m_top);
+
+	RECT cellArea = { cellLeft, cellTop, cellLeft + static_cast<LONG>(CELL_SIZE), cellTop + static_cast<LONG>(CELL_SIZE) };
+
+	D3DLOCKED_RECT lockedRect;
+
+	if (FAILED(m_pPageTexture->LockRect(0, &lockedRect, &cellArea, 0))) return false;
+
+	const UINT GRAY_LEVELS_MAX = 64;
+
+	for (UINT row = 0; row < CELL_SIZE; ++row)
+	{
+		DWORD* pTexels = reinterpret_cast<DWORD*>(static_cast<BYTE*>(lockedRect.pBits) + row * lockedRect.Pitch);
+
+		for (UINT column = 0; column < CELL_SIZE; ++column)
+		{
+			UINT alpha = 0;
+
+			if (row < height && column < width)
+			{
+				alpha = (std::min)(pGray[row * pitch + column] * 255u / GRAY_LEVELS_MAX, 255u);
+			}
+
+			//! 色は頂点の色で決めるので白にしアルファだけを変える
+			pTexels[column] = (alpha << 24) | 0x00FFFFFF;
+		}
+	}
+
+	m_pPageTexture->UnlockRect(0);
+
+	return true;
+}
+
+bool GlyphCache::CreatePage()
+{
+	if (FAILED(m_pDX_GRAPHIC_DEVICE->CreateTexture(
+		m_PAGE_SIZE, m_PAGE_SIZE,
+		1,
+		0,
+		D3DFMT_A8R8G8B8,
+		D3DPOOL_MANAGED,
+		&m_pPageTexture,
+		NULL)))
+	{
+		m_pPageTexture = nullptr;
+
+		return false;
+	}
+
+	//! 区画は使う大きさが決まってから行ごとに割り当てる
+	for (UINT cellSize = m_CELL_SIZE; cellSize && cellSize <= m_PAGE_SIZE; cellSize *= 2)
+	{
+		CellSizeClass sizeClass;
+		sizeClass.m_cellSize = cellSize;
+
+		m_cellSizeClasses.push_back(sizeClass);
+	}
+
+	return true;
+}
+
+void GlyphCache::SubmitVertices()
+{
+	if (m_vertices.empty()) return;
+
+	m_pSpriteBatch->Add(m_vertices.data(), static_cast<UINT>(m_vertices.size()) / CustomVertex::m_RECT_VERTICES_NUM, m_pPageTexture);
+
+	m_vertices.clear();
+}
+
+const TEXTMETRICW& GlyphCache::GetTextMetrics(LPD3DXFONT pFont)
+{
+	auto textMetrics = m_textMetrics.find(pFont);
+
+	if (textMetrics != m_textMetrics.end()) return textMetrics->second;
+
+	TEXTMETRICW& rTextMetrics = m_textMetrics[pFont];
+
+	GetTextMetricsW(pFont->GetDC(), &rTextMetrics);
+
+	return rTextMetrics;
+}
+
+const std::map<UINT, int>& GlyphCache::GetKerningPairs(LPD3DXFONT pFont)
+{
+	auto kerningPairs = m_kerningPairs.find(pFont);
+
+	if (kerningPairs != m_kerningPairs.end()) return kerningPairs->second;
+
+	std::map<UINT, int>& rKerningPairs = m_kerningPairs[pFont];
+
+	HDC hDC = pFont->GetDC();
+
+	DWORD pairsNum = GetKerningPairsW(hDC, 0, NULL);
+
+	if (pairsNum == 0) return rKerningPairs;
+
+	m_kerningPairBuffer.resize(pairsNum);
+
+	pairsNum = GetKerningPairsW(hDC, pairsNum, m_kerningPairBuffer.data());
+
+	for (DWORD i = 0; i < pairsNum; ++i)
+	{
+		const KERNINGPAIR& rKerningPair = m_kerningPairBuffer[i];
+
+		rKerningPairs[(static_cast<UINT>(rKerningPair.wFirst) << 16) | rKerningPair.wSecond] = rKerningPair.iKernAmount;
+	}
+
+	return rKerningPairs;
+}
+
+bool GlyphCache::RenderMultiByte(UINT codePage, const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds)
+{
+	int length = MultiByteToWideChar(codePage, 0, pText, -1, NULL, 0);
+
+	if (length <= 0) return false;
+
+	m_convertedText.resize(length);
+
+	MultiByteToWideChar(codePage, 0, pText, -1, m_convertedText.data(), length);
+
+	return Render(topLeft, m_convertedText.data(), format, pFont, color, pBounds);
+}
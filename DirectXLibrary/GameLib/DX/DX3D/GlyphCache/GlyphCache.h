@@ -0,0 +1,336 @@
+﻿/// <filename>
+/// GlyphCache.h
+/// </filename>
+/// <summary>
+/// 文字の画像をテクスチャに保持し矩形として描画するクラスのヘッダ
+/// </summary>
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <list>
+#include <map>
+#include <climits>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\SpriteBatch\SpriteBatch.h"
+#include "TextLayoutCache\TextLayoutCache.h"
+
+/// <summary>
+/// 文字の作成と破棄の回数などの統計
+/// </summary>
+struct GlyphCacheStats
+{
+public:
+	//! 作成済みの文字を使いまわした回数
+	UINT m_hitsNum = 0;
+
+	//! 文字をテクスチャに書き込んだ回数
+	UINT m_rasterizedGlyphsNum = 0;
+
+	//! 空きがなく長く使われていない文字を破棄した回数
+	UINT m_evictedGlyphsNum = 0;
+};
+
+/// <summary>
+/// フォントと文字ごとに一度だけGDIで文字の画像を作成してテクスチャの区画に書き込み,
+/// 文字列を矩形の並びとしてSpriteBatchで描画するクラス
+/// </summary>
+/// <remarks>
+/// 区画の大きさはcellSizeを2倍ずつしたものからフォントの行の高さと文字の画像が収まる一番小さいものを選ぶ
+/// テクスチャは上から行単位で区画の大きさごとに割り当て,割り当てた行は全て破棄するまで同じ大きさで使う
+/// 区画が足りなくなった場合は同じ大きさの区画のうち最後に使われたのが一番古い文字の区画を使いまわす
+/// ページより大きなフォントや文字,サロゲートペアを含む文字列,行を割り当てられない場合はRenderがfalseを返す
+/// その場合はID3DXFontで描画する
+/// 配置した結果はTextLayoutCacheに保持し,変化しない文字列は位置と色を書き換えるだけで描画する
+/// </remarks>
+class GlyphCache
+{
+public:
+	/// <param name="dXGraphicDevice">デバイス</param>
+	/// <param name="pSpriteBatch">文字の矩形を描画するのに用いる</param>
+	/// <param name="pageSize">文字を書き込むテクスチャの幅と高さ(ピクセル)</param>
+	/// <param name="cellSize">文字一つ分の区画の一番小さい幅と高さ(ピクセル)</param>
+	GlyphCache(const LPDIRECT3DDEVICE9 dXGraphicDevice, SpriteBatch* pSpriteBatch,
+		UINT pageSize = m_DEFAULT_PAGE_SIZE, UINT cellSize = m_DEFAULT_CELL_SIZE)
+		:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_pSpriteBatch(pSpriteBatch), m_PAGE_SIZE(pageSize), m_CELL_SIZE(cellSize) {};
+
+	~GlyphCache()
+	{
+		Clear();
+	}
+
+	/// <summary>
+	/// フレームの始まりを知らせる このフレームで使った文字を描画前に上書きしないようにするため
+	/// </summary>
+	inline void BeginFrame()
+	{
+		++m_frame;
+	}
+
+	/// <summary>
+	/// 文字列を描画する DT_CALCRECTで求めた矩形の左上をtopLeftに合わせたID3DXFont::DrawTextと同じ配置になる
+	/// </summary>
+	/// <param name="topLeft">[in]左上の座標</param>
+	/// <param name="pText">[in]UTF-16の文字列</param>
+	/// <param name="format">文字のフォーマット DT_LEFT,DT_CENTER,DT_RIGHT,DT_SINGLELINEを扱う</param>
+	/// <param name="pFont">描画する際に使うフォントオブジェクト</param>
+	/// <param name="color">文字の色ARGB</param>
+	/// <param name="pBounds">[out]描画した文字列全体を囲む矩形 不要ならnullptr</param>
+	/// <returns>フォントがページより大きいか,区画を割り当てられず描画できない場合false</returns>
+	bool Render(const D3DXVECTOR2& topLeft, const WCHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds = nullptr);
+
+	/// <param name="pText">[in]システムの既定のコードページ(日本語環境ではShift-JIS)の文字列</param>
+	bool Render(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds = nullptr);
+
+	/// <param name="pText">[in]UTF-8の文字列</param>
+	bool RenderUTF8(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds = nullptr);
+
+	/// <summary>
+	/// 引数のフォントの文字を全て破棄する フォントを開放する前に呼ぶ
+	/// </summary>
+	void ReleaseFont(LPD3DXFONT pFont);
+
+	/// <summary>
+	/// 全ての文字とテクスチャを破棄する
+	/// </summary>
+	void Clear();
+
+	inline const GlyphCacheStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+	inline void ResetStats()
+	{
+		m_stats = GlyphCacheStats();
+	}
+
+	inline const TextLayoutCacheStats& GetTextLayoutStats() const
+	{
+		return m_textLayoutCache.GetStats();
+	}
+
+	inline void ResetTextLayoutStats()
+	{
+		m_textLayoutCache.ResetStats();
+	}
+
+private:
+	struct GlyphKey
+	{
+	public:
+		LPD3DXFONT m_pFont;
+
+		UINT m_codePoint;
+
+		inline bool operator<(const GlyphKey& rRight) const
+		{
+			if (m_pFont != rRight.m_pFont) return m_pFont < rRight.m_pFont;
+
+			return m_codePoint < rRight.m_codePoint;
+		}
+	};
+
+	struct Glyph
+	{
+	public:
+		//! 画像を持たない文字(空白など)はm_NO_CELL
+		UINT m_cellIndex;
+
+		//! ペンの位置から画像の左上までのずれ
+		int m_offsetX;
+		int m_offsetY;
+
+		UINT m_width;
+		UINT m_height;
+
+		//! 次の文字までの幅
+		int m_advance;
+
+		UINT m_lastUsedFrame;
+
+		//! 画像を持つ文字のみ区画の大きさごとのm_lruの中の位置を指す
+		std::list<GlyphKey>::iterator m_lruPosition;
+	};
+
+	/// <summary>
+	/// テクスチャ上の文字一つ分の区画
+	/// </summary>
+	struct Cell
+	{
+	public:
+		UINT m_left;
+		UINT m_top;
+
+		//! m_cellSizeClassesの添え字
+		UINT m_sizeClassIndex;
+	};
+
+	/// <summary>
+	/// 同じ大きさの区画をまとめたもの
+	/// </summary>
+	struct CellSizeClass
+	{
+	public:
+		UINT m_cellSize;
+
+		std::vector<UINT> m_freeCells;
+
+		//! この大きさの区画に画像を持つ文字を最後に使われた順に並べたもの 先頭が一番新しい
+		std::list<GlyphKey> m_lru;
+	};
+
+	/// <summary>
+	/// 左上を(0, 0)として文字列を配置する 文字の間隔はフォントのカーニングペアで調整する
+	/// </summary>
+	/// <returns>作成できない文字があるか,配置中に文字の画像の追い出しが起き配置が使えない場合はfalse</returns>
+	bool Layout(const WCHAR* pText, UINT format, LPD3DXFONT pFont, TextLayout* pLayout);
+
+	/// <summary>
+	/// 保持していた配置の文字をこのフレームで使ったものとしてLRUの先頭に移す
+	/// </summary>
+	void TouchLayout(LPD3DXFONT pFont, const TextLayout& rLayout);
+
+	/// <summary>
+	/// 文字を取得する 作成されていなければ作成する
+	/// </summary>
+	/// <returns>サロゲートの場合と作成できなかった場合nullptr</returns>
+	const Glyph* Acquire(LPD3DXFONT pFont, UINT codePoint);
+
+	/// <summary>
+	/// 文字をこのフレームで使ったものとしてLRUの先頭に移す
+	/// </summary>
+	void Touch(Glyph* pGlyph);
+
+	/// <summary>
+	/// 文字の画像を作成し,行の高さと画像が収まる区画のうち空いているものに書き込む
+	/// </summary>
+	/// <returns>画像がページより大きいか,区画を割り当てられない場合false</returns>
+	bool Rasterize(LPD3DXFONT pFont, UINT codePoint, Glyph* pGlyph);
+
+	/// <summary>
+	/// 空いている区画を取得する 空きがなければ行を割り当て,割り当てられなければ同じ大きさで一番使われていない文字を破棄する
+	/// </summary>
+	/// <returns>取得できない場合m_NO_CELL</returns>
+	UINT AllocateCell(UINT sizeClassIndex);
+
+	/// <summary>
+	/// テクスチャの空いている部分から区画の大きさの高さの行を割り当て,その行の区画を空いている区画に加える
+	/// </summary>
+	/// <returns>行を割り当てる高さが残っていない場合false</returns>
+	bool AllocateRow(UINT sizeClassIndex);
+
+	/// <summary>
+	/// フォントの行の高さが収まる一番小さい区画の大きさを求める
+	/// </summary>
+	/// <returns>m_cellSizeClassesの添え字 ページより大きい場合m_NO_CELL</returns>
+	UINT GetCellSizeClassIndex(LPD3DXFONT pFont);
+
+	/// <summary>
+	/// 幅と高さが収まる一番小さい区画の大きさを求める
+	/// </summary>
+	/// <returns>m_cellSizeClassesの添え字 ページより大きい場合m_NO_CELL</returns>
+	UINT GetCellSizeClassIndex(UINT size) const;
+
+	/// <summary>
+	/// 区画に画像を書き込む 画像のない部分は透明にする
+	/// </summary>
+	/// <param name="pGray">[in]GGO_GRAY8_BITMAPで作成した画像 0~64の濃淡</param>
+	bool WriteCell(UINT cellIndex, const BYTE* pGray, UINT width, UINT height, UINT pitch);
+
+	/// <summary>
+	/// 文字を書き込むテクスチャを作成し,区画の大きさの種類を用意する
+	/// </summary>
+	bool CreatePage();
+
+	/// <summary>
+	/// 溜めている文字の矩形をSpriteBatchに渡す
+	/// </summary>
+	void SubmitVertices();
+
+	/// <summary>
+	/// フォントの行の高さなどを取得する
+	/// </summary>
+	const TEXTMETRICW& GetTextMetrics(LPD3DXFONT pFont);
+
+	/// <summary>
+	/// フォントのカーニングペアを取得する フォントごとに一度だけGDIから読み込む
+	/// </summary>
+	/// <returns>前の文字を上位16bit,後ろの文字を下位16bitにしたキーと,文字の間隔に足す幅</returns>
+	const std::map<UINT, int>& GetKerningPairs(LPD3DXFONT pFont);
+
+	/// <summary>
+	/// 複数バイトの文字列をUTF-16に変換して描画する
+	/// </summary>
+	bool RenderMultiByte(UINT codePage, const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color, RECT* pBounds);
+
+	static const UINT m_DEFAULT_PAGE_SIZE = 1024;
+
+	static const UINT m_DEFAULT_CELL_SIZE = 32;
+
+	static const UINT m_NO_CELL = UINT_MAX;
+
+	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	SpriteBatch* m_pSpriteBatch = nullptr;
+
+	const UINT m_PAGE_SIZE = 0;
+
+	const UINT m_CELL_SIZE = 0;
+
+	LPDIRECT3DTEXTURE9 m_pPageTexture = nullptr;
+
+	std::map<GlyphKey, Glyph> m_glyphs;
+
+	//! 割り当てた行の区画 添え字がGlyph::m_cellIndexになる
+	std::vector<Cell> m_cells;
+
+	//! 小さい順に並んだ区画の大きさの種類
+	std::vector<CellSizeClass> m_cellSizeClasses;
+
+	//! 行を割り当て終わったテクスチャの高さ
+	UINT m_rowsBottom = 0;
+
+	std::map<LPD3DXFONT, TEXTMETRICW> m_textMetrics;
+
+	std::map<LPD3DXFONT, std::map<UINT, int>> m_kerningPairs;
+
+	//! GetKerningPairsWの出力先
+	std::vector<KERNINGPAIR> m_kerningPairBuffer;
+
+	//! SpriteBatchに渡す前の文字の矩形
+	std::vector<CustomVertex> m_vertices;
+
+	//! GetGlyphOutlineWの出力先
+	std::vector<BYTE> m_grayBuffer;
+
+	std::vector<WCHAR> m_convertedText;
+
+	TextLayoutCache m_textLayoutCache;
+
+	//! 配置を作成する際の作業用
+	TextLayout m_layout;
+
+	//! 配置を作成する際に文字列の文字ごとに取得した文字 改行や取得できなかった文字はnullptr
+	std::vector<const Glyph*> m_layoutGlyphs;
+
+	//! 配置を作成する際に文字列の文字ごとに求めた,前の文字との間隔に足すカーニングの幅
+	std::vector<int> m_layoutKernings;
+
+	std::vector<int> m_lineWidths;
+
+	UINT m_frame = 0;
+
+	//! 文字の画像の追い出しやClearのたびに増える 保持している配置が使えるかの判別に使う
+	UINT m_generation = 0;
+
+	GlyphCacheStats m_stats;
+};
+
+#endif //! GLYPH_CACHE_H
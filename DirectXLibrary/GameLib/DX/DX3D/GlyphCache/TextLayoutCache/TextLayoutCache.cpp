@@ -0,0 +1,127 @@
+﻿/// <filename>
+/// TextLayoutCache.cpp
+/// </filename>
+/// <summary>
+/// 文字列の配置結果を保持するクラスのソース
+/// </summary>
+
+#include "TextLayoutCache.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <list>
+#include <map>
+#include <string>
+#include <cwchar>
+#include <iterator>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+
+const TextLayout* TextLayoutCache::Find(LPD3DXFONT pFont, const WCHAR* pText, UINT format, UINT generation)
+{
+	auto entry = m_entries.find(CreateKey(pFont, pText, format));
+
+	if (entry == m_entries.end())
+	{
+		++m_stats.m_missesNum;
+
+		return nullptr;
+	}
+
+	if (entry->second.m_generation != generation || entry->second.m_text != pText)
+	{
+		Erase(entry);
+
+		++m_stats.m_missesNum;
+
+		return nullptr;
+	}
+
+	m_lru.splice(m_lru.begin(), m_lru, entry->second.m_lruPosition);
+
+	++m_stats.m_hitsNum;
+
+	return &entry->second.m_layout;
+}
+
+void TextLayoutCache::Store(LPD3DXFONT pFont, const WCHAR* pText, UINT format, UINT generation, const TextLayout& rLayout)
+{
+	LayoutKey key = CreateKey(pFont, pText, format);
+
+	auto sameKeyEntry = m_entries.find(key);
+
+	if (sameKeyEntry != m_entries.end()) Erase(sameKeyEntry);
+
+	size_t textLength = wcslen(pText);
+
+	size_t bytes = sizeof(Entry) + sizeof(CustomVertex) * rLayout.m_vertices.size() + sizeof(UINT) * rLayout.m_codePoints.size() + sizeof(WCHAR) * (textLength + 1);
+
+	if (bytes > m_BYTES_MAX) return;
+
+	while (m_stats.m_usedBytes + bytes > m_BYTES_MAX)
+	{
+		Erase(m_entries.find(m_lru.back()));
+
+		++m_stats.m_evictedLayoutsNum;
+	}
+
+	Entry& rEntry = m_entries[key];
+
+	rEntry.m_text.assign(pText, textLength);
+	rEntry.m_generation	= generation;
+	rEntry.m_layout		= rLayout;
+	rEntry.m_bytes		= bytes;
+
+	m_lru.push_front(key);
+	rEntry.m_lruPosition = m_lru.begin();
+
+	m_stats.m_usedBytes += bytes;
+}
+
+void TextLayoutCache::ReleaseFont(LPD3DXFONT pFont)
+{
+	for (auto entry = m_entries.begin(); entry != m_entries.end();)
+	{
+		auto nextEntry = std::next(entry);
+
+		if (entry->first.m_pFont == pFont) Erase(entry);
+
+		entry = nextEntry;
+	}
+}
+
+void TextLayoutCache::Clear()
+{
+	m_entries.clear();
+	m_lru.clear();
+
+	m_stats.m_usedBytes = 0;
+}
+
+TextLayoutCache::LayoutKey TextLayoutCache::CreateKey(LPD3DXFONT pFont, const WCHAR* pText, UINT format) const
+{
+	//! FNV-1a
+	UINT textHash = 2166136261u;
+
+	for (const WCHAR* pChar = pText; *pChar; ++pChar)
+	{
+		textHash ^= static_cast<UINT>(*pChar);
+		textHash *= 16777619u;
+	}
+
+	LayoutKey key = { pFont, format, textHash };
+
+	return key;
+}
+
+void TextLayoutCache::Erase(std::map<LayoutKey, Entry>::iterator entry)
+{
+	m_stats.m_usedBytes -= entry->second.m_bytes;
+
+	m_lru.erase(entry->second.m_lruPosition);
+
+	m_entries.erase(entry);
+}
@@ -0,0 +1,159 @@
+﻿/// <filename>
+/// TextLayoutCache.h
+/// </filename>
+/// <summary>
+/// 文字列の配置結果を保持するクラスのヘッダ
+/// </summary>
+
+#ifndef TEXT_LAYOUT_CACHE_H
+#define TEXT_LAYOUT_CACHE_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <list>
+#include <map>
+#include <string>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+
+/// <summary>
+/// 配置済みの文字列
+/// </summary>
+struct TextLayout
+{
+public:
+	//! 左上を(0, 0)とした文字の矩形 色は描画時に設定する
+	std::vector<CustomVertex> m_vertices;
+
+	//! 画像を持つ文字のコードポイント 配置を使いまわす際に文字を使ったことにするため
+	std::vector<UINT> m_codePoints;
+
+	//! 左上を(0, 0)とした文字列全体を囲む矩形
+	RECT m_bounds;
+};
+
+struct TextLayoutCacheStats
+{
+public:
+	UINT m_hitsNum = 0;
+
+	UINT m_missesNum = 0;
+
+	//! 上限を超えたため破棄した配置の数
+	UINT m_evictedLayoutsNum = 0;
+
+	//! 保持している配置の大きさ
+	size_t m_usedBytes = 0;
+};
+
+/// <summary>
+/// フォント,文字列,フォーマットごとに文字列の配置結果を保持するクラス
+/// 上限を超えた場合は長く使われていないものから破棄する
+/// </summary>
+class TextLayoutCache
+{
+public:
+	explicit TextLayoutCache(size_t bytesMax = m_DEFAULT_BYTES_MAX) :m_BYTES_MAX(bytesMax) {};
+
+	~TextLayoutCache() {};
+
+	/// <summary>
+	/// 配置を探す
+	/// </summary>
+	/// <param name="pFont">フォントオブジェクト</param>
+	/// <param name="pText">[in]文字列</param>
+	/// <param name="format">文字のフォーマット</param>
+	/// <param name="generation">文字の画像の世代 保持時と異なれば使えないものとして破棄する</param>
+	/// <returns>見つかった配置のポインタ 見つからなければnullptr</returns>
+	const TextLayout* Find(LPD3DXFONT pFont, const WCHAR* pText, UINT format, UINT generation);
+
+	/// <summary>
+	/// 配置を保持する
+	/// </summary>
+	/// <param name="pFont">フォントオブジェクト</param>
+	/// <param name="pText">[in]文字列</param>
+	/// <param name="format">文字のフォーマット</param>
+	/// <param name="generation">配置を作成したときの文字の画像の世代</param>
+	/// <param name="rLayout">[in]保持する配置</param>
+	void Store(LPD3DXFONT pFont, const WCHAR* pText, UINT format, UINT generation, const TextLayout& rLayout);
+
+	/// <summary>
+	/// 指定したフォントの配置をすべて破棄する
+	/// </summary>
+	/// <param name="pFont">フォントオブジェクト</param>
+	void ReleaseFont(LPD3DXFONT pFont);
+
+	void Clear();
+
+	inline const TextLayoutCacheStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+	/// <summary>
+	/// 使用量以外の統計を0にする
+	/// </summary>
+	inline void ResetStats()
+	{
+		size_t usedBytes = m_stats.m_usedBytes;
+
+		m_stats = TextLayoutCacheStats();
+
+		m_stats.m_usedBytes = usedBytes;
+	}
+
+private:
+	struct LayoutKey
+	{
+	public:
+		LPD3DXFONT m_pFont;
+
+		UINT m_format;
+
+		UINT m_textHash;
+
+		inline bool operator<(const LayoutKey& rRight) const
+		{
+			if (m_pFont != rRight.m_pFont) return m_pFont < rRight.m_pFont;
+
+			if (m_format != rRight.m_format) return m_format < rRight.m_format;
+
+			return m_textHash < rRight.m_textHash;
+		}
+	};
+
+	struct Entry
+	{
+	public:
+		//! ハッシュが衝突した場合に備え文字列そのものも持つ
+		std::basic_string<WCHAR> m_text;
+
+		UINT m_generation;
+
+		TextLayout m_layout;
+
+		size_t m_bytes;
+
+		std::list<LayoutKey>::iterator m_lruPosition;
+	};
+
+	LayoutKey CreateKey(LPD3DXFONT pFont, const WCHAR* pText, UINT format) const;
+
+	void Erase(std::map<LayoutKey, Entry>::iterator entry);
+
+	static const size_t m_DEFAULT_BYTES_MAX = 256 * 1024;
+
+	const size_t m_BYTES_MAX = 0;
+
+	std::map<LayoutKey, Entry> m_entries;
+
+	//! 最後に使われた順に並べたキー 先頭が一番新しい
+	std::list<LayoutKey> m_lru;
+
+	TextLayoutCacheStats m_stats;
+};
+
+#endif //! TEXT_LAYOUT_CACHE_H
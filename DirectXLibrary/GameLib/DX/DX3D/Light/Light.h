@@ -10,13 +10,16 @@
 
 #include <d3dx9.h>
 
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
 /**
 * @brief ライトクラス
 */
 class Light
 {
 public:
-	Light(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice) {};
+	Light(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache)
+		:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_pRenderStateCache(pRenderStateCache) {};
 	~Light() {};
 
 	/**
@@ -53,7 +56,7 @@ public:
 	*/
 	inline void EnableLighting() const
 	{
-		m_pDX_GRAPHIC_DEVICE->SetRenderState(D3DRS_LIGHTING, true);
+		m_pRenderStateCache->SetRenderState(D3DRS_LIGHTING, true);
 	}
 
 	/**
@@ -61,7 +64,7 @@ public:
 	*/
 	inline void DisableLighting() const
 	{
-		m_pDX_GRAPHIC_DEVICE->SetRenderState(D3DRS_LIGHTING, false);
+		m_pRenderStateCache->SetRenderState(D3DRS_LIGHTING, false);
 	}
 
 	/**
@@ -70,7 +73,7 @@ public:
 	*/
 	inline void ChangeAmbientIntensity(DWORD aRGB) const
 	{
-		m_pDX_GRAPHIC_DEVICE->SetRenderState(D3DRS_AMBIENT, aRGB);
+		m_pRenderStateCache->SetRenderState(D3DRS_AMBIENT, aRGB);
 	}
 
 	/**
@@ -78,7 +81,7 @@ public:
 	*/
 	inline void EnableSpecular() const
 	{
-		m_pDX_GRAPHIC_DEVICE->SetRenderState(D3DRS_SPECULARENABLE, true);
+		m_pRenderStateCache->SetRenderState(D3DRS_SPECULARENABLE, true);
 	}
 
 	/**
@@ -86,7 +89,7 @@ public:
 	*/
 	inline void DisaableSpecular() const
 	{
-		m_pDX_GRAPHIC_DEVICE->SetRenderState(D3DRS_SPECULARENABLE, false);
+		m_pRenderStateCache->SetRenderState(D3DRS_SPECULARENABLE, false);
 	}
 
 	/**
@@ -100,6 +103,8 @@ public:
 
 private:
 	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	RenderStateCache* m_pRenderStateCache = nullptr;
 };
 
 #endif // !LIGHT_H
@@ -0,0 +1,100 @@
+﻿/// <filename>
+/// QuadIndexBuffer.cpp
+/// </filename>
+/// <summary>
+/// 矩形の描画で共有する静的インデックスバッファのソース
+/// </summary>
+
+#include "QuadIndexBuffer.h"
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+QuadIndexBuffer::QuadIndexBuffer(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache)
+	:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_pRenderStateCache(pRenderStateCache)
+{
+	Create();
+}
+
+void QuadIndexBuffer::Release()
+{
+	if (!m_pIndexBuffer) return;
+
+	m_pIndexBuffer->Release();
+	m_pIndexBuffer = nullptr;
+
+	m_quadsMax = 0;
+}
+
+bool QuadIndexBuffer::DrawQuads(UINT baseVertex, UINT quadsNum) const
+{
+	if (!m_pIndexBuffer || quadsNum == 0 || quadsNum > m_quadsMax) return false;
+
+	UINT verticesNum = quadsNum * m_QUAD_VERTICES_NUM;
+
+	//! 開始頂点の番号を足したインデックスがデバイスの上限を超える場合は描画できない
+	if (baseVertex + verticesNum - 1 > m_maxVertexIndex) return false;
+
+	m_pRenderStateCache->SetIndices(m_pIndexBuffer);
+
+	//! 矩形一つにつき三角形二つ
+	return SUCCEEDED(m_pDX_GRAPHIC_DEVICE->DrawIndexedPrimitive(
+		D3DPT_TRIANGLELIST,
+		baseVertex,
+		0,
+		verticesNum,
+		0,
+		quadsNum * 2));
+}
+
+void QuadIndexBuffer::Create()
+{
+	D3DCAPS9 caps;
+
+	if (FAILED(m_pDX_GRAPHIC_DEVICE->GetDeviceCaps(&caps))) return;
+
+	m_maxVertexIndex = caps.MaxVertexIndex;
+
+	bool uses32BitIndices = (caps.MaxVertexIndex > 0xFFFF);
+
+	UINT quadsMax = (uses32BitIndices) ? m_QUADS_MAX : m_QUADS_MAX_16;
+	UINT indexBytes = (uses32BitIndices) ? sizeof(DWORD) : sizeof(WORD);
+
+	if (FAILED(m_pDX_GRAPHIC_DEVICE->CreateIndexBuffer(
+		quadsMax * m_QUAD_INDICES_NUM * indexBytes,
+		D3DUSAGE_WRITEONLY,
+		(uses32BitIndices) ? D3DFMT_INDEX32 : D3DFMT_INDEX16,
+		D3DPOOL_MANAGED,
+		&m_pIndexBuffer,
+		NULL)))
+	{
+		m_pIndexBuffer = nullptr;
+
+		return;
+	}
+
+	m_quadsMax = quadsMax;
+
+	bool filled = (uses32BitIndices) ? Fill<DWORD>() : Fill<WORD>();
+
+	if (filled) return;
+
+	Release();
+}
+
+template<typename T>
+bool QuadIndexBuffer::Fill()
+{
+	void* pIndices = nullptr;
+
+	if (FAILED(m_pIndexBuffer->Lock(0, 0, &pIndices, 0))) return false;
+
+	WriteIndices(static_cast<T*>(pIndices), m_quadsMax);
+
+	m_pIndexBuffer->Unlock();
+
+	return true;
+}
@@ -0,0 +1,113 @@
+﻿/// <filename>
+/// QuadIndexBuffer.h
+/// </filename>
+/// <summary>
+/// 矩形の描画で共有する静的インデックスバッファのヘッダ
+/// </summary>
+
+#ifndef QUAD_INDEX_BUFFER_H
+#define QUAD_INDEX_BUFFER_H
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+/// <summary>
+/// 4頂点ずつ並んだ矩形を三角形リストで描画するためのインデックスバッファを一つ持つクラス
+/// </summary>
+/// <remarks>
+/// CustomVertexEditor::Create,Board3D::CreateRectの頂点順に合わせ0-1-2,0-2-3で三角形を作る
+/// D3DPOOL_MANAGEDなのでデバイスのReset時に作り直す必要はない
+/// 32bitのインデックスに対応していないデバイスでは16bitで表せる分の矩形しか描画できない
+/// </remarks>
+class QuadIndexBuffer
+{
+public:
+	QuadIndexBuffer(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache);
+	~QuadIndexBuffer()
+	{
+		Release();
+	}
+
+	/// <summary>
+	/// インデックスバッファを開放する
+	/// </summary>
+	void Release();
+
+	/// <summary>
+	/// 連続して並んでいる矩形を一度に描画する
+	/// 頂点バッファとFVFは設定済みでなければならない
+	/// </summary>
+	/// <param name="baseVertex">ストリーム内の先頭の矩形の最初の頂点の番号</param>
+	/// <param name="quadsNum">矩形の数 GetQuadsMax以下でなければならない</param>
+	/// <returns>描画できなかった場合false</returns>
+	bool DrawQuads(UINT baseVertex, UINT quadsNum) const;
+
+	/// <summary>
+	/// 一度に描画できる矩形の最大数を取得する
+	/// </summary>
+	inline UINT GetQuadsMax() const
+	{
+		return m_quadsMax;
+	}
+
+	/// <summary>
+	/// 矩形のインデックスを書き込む
+	/// </summary>
+	/// <param name="pIndices">[out]矩形の数*6の長さを持つ書き込み先</param>
+	/// <param name="quadsNum">矩形の数</param>
+	template<typename T>
+	static void WriteIndices(T* pIndices, UINT quadsNum)
+	{
+		for (UINT i = 0; i < quadsNum; ++i)
+		{
+			T firstVertex = static_cast<T>(i * m_QUAD_VERTICES_NUM);
+			T* pQuadIndices = &pIndices[i * m_QUAD_INDICES_NUM];
+
+			pQuadIndices[0] = firstVertex;
+			pQuadIndices[1] = firstVertex + 1;
+			pQuadIndices[2] = firstVertex + 2;
+
+			pQuadIndices[3] = firstVertex;
+			pQuadIndices[4] = firstVertex + 2;
+			pQuadIndices[5] = firstVertex + 3;
+		}
+	}
+
+	static const UINT m_QUAD_VERTICES_NUM = 4;
+
+	static const UINT m_QUAD_INDICES_NUM = 6;
+
+private:
+	/// <summary>
+	/// デバイスの能力に合わせインデックスの大きさを決めインデックスバッファを作成する
+	/// </summary>
+	void Create();
+
+	/// <summary>
+	/// 作成したインデックスバッファにインデックスを書き込む
+	/// </summary>
+	template<typename T>
+	bool Fill();
+
+	//! 32bitのインデックスを使える場合の矩形の最大数
+	static const UINT m_QUADS_MAX = 65536;
+
+	//! 16bitのインデックスで表せる頂点数に収まる矩形の最大数
+	static const UINT m_QUADS_MAX_16 = 16384;
+
+	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	RenderStateCache* m_pRenderStateCache = nullptr;
+
+	LPDIRECT3DINDEXBUFFER9 m_pIndexBuffer = nullptr;
+
+	UINT m_quadsMax = 0;
+
+	//! 開始頂点の番号を足した後のインデックスの上限
+	DWORD m_maxVertexIndex = 0;
+};
+
+#endif //! QUAD_INDEX_BUFFER_H
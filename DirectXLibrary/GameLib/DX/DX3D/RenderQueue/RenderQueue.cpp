@@ -0,0 +1,207 @@
+﻿/// <filename>
+/// RenderQueue.cpp
+/// </filename>
+/// <summary>
+/// 描画命令を並べ替えてから描画するクラスのソース
+/// </summary>
+
+#include "RenderQueue.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\ColorBlender\ColorBlender.h"
+#include "DX\DX3D\SpriteBatch\SpriteBatch.h"
+#include "DX\DX3D\Culler\Culler.h"
+
+void RenderQueue::Submit(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture,
+	ColorBlender::BLEND_MODE blendMode, BYTE layer)
+{
+	//! 画面外の矩形は並べ替えの対象にもしない
+	if (!m_pCuller->IsVisible(pCustomVertices)) return;
+
+	Command command;
+	std::copy(pCustomVertices, pCustomVertices + CustomVertex::m_RECT_VERTICES_NUM, command.m_vertices);
+	command.m_pTexture	= pTexture;
+	command.m_blendMode = blendMode;
+
+	float depth = 0.0f;
+
+	for (const CustomVertex& rVertex : command.m_vertices)
+	{
+		depth += rVertex.m_pos.z;
+	}
+
+	depth /= CustomVertex::m_RECT_VERTICES_NUM;
+
+	SortElement sortElement;
+	sortElement.m_key			= CreateKey(layer, blendMode, GetTexId(pTexture), depth);
+	sortElement.m_commandIndex	= static_cast<UINT>(m_commands.size());
+
+	m_commands.push_back(command);
+	m_sortElements.push_back(sortElement);
+}
+
+void RenderQueue::Flush()
+{
+	m_stats = RenderQueueStats();
+
+	if (m_commands.empty()) return;
+
+	m_stats.m_commandsNum = static_cast<UINT>(m_commands.size());
+
+	m_stats.m_unsortedBindsNum = CountBinds(false);
+
+	RadixSort();
+
+	m_stats.m_bindsNum = CountBinds(true);
+
+	//! 符号なしの引き算で桁あふれしないよう,増えた場合は0にする
+	m_stats.m_savedBindsNum = (m_stats.m_unsortedBindsNum > m_stats.m_bindsNum) ? m_stats.m_unsortedBindsNum - m_stats.m_bindsNum : 0;
+
+	ColorBlender::BLEND_MODE prevBlendMode = m_pColorBlender->GetBlendMode();
+
+	//! SpriteBatchはテクスチャが変わった時のみ描画するので,ここでは色の合成の切り替えだけ行う
+	for (const SortElement& rSortElement : m_sortElements)
+	{
+		const Command& rCommand = m_commands[rSortElement.m_commandIndex];
+
+		if (rCommand.m_blendMode != m_pColorBlender->GetBlendMode())
+		{
+			m_pSpriteBatch->Flush();
+
+			if (rCommand.m_blendMode == ColorBlender::BLEND_MODE::ADDITION)
+			{
+				m_pColorBlender->AddtionBlendMode();
+			}
+			else
+			{
+				m_pColorBlender->DefaultBlendMode();
+			}
+		}
+
+		m_pSpriteBatch->Add(rCommand.m_vertices, rCommand.m_pTexture);
+	}
+
+	if (prevBlendMode != m_pColorBlender->GetBlendMode())
+	{
+		m_pSpriteBatch->Flush();
+
+		if (prevBlendMode == ColorBlender::BLEND_MODE::ADDITION)
+		{
+			m_pColorBlender->AddtionBlendMode();
+		}
+		else
+		{
+			m_pColorBlender->DefaultBlendMode();
+		}
+	}
+
+	m_commands.clear();
+	m_sortElements.clear();
+	m_texIds.clear();
+}
+
+UINT64 RenderQueue::CreateKey(BYTE layer, ColorBlender::BLEND_MODE blendMode, WORD texId, float depth)
+{
+	//! 浮動小数のビット列を符号なし整数として大小比較できる形に直す
+	UINT32 depthBits = 0;
+	memcpy(&depthBits, &depth, sizeof(depthBits));
+	depthBits = (depthBits & 0x80000000) ? ~depthBits : (depthBits | 0x80000000);
+
+	//! 奥から描画するため反転させて降順にする
+	depthBits = ~depthBits;
+
+	return (static_cast<UINT64>(layer) << 56) |
+		(static_cast<UINT64>(blendMode) << 48) |
+		(static_cast<UINT64>(texId) << 32) |
+		static_cast<UINT64>(depthBits);
+}
+
+WORD RenderQueue::GetTexId(const LPDIRECT3DTEXTURE9 pTexture)
+{
+	auto texId = m_texIds.find(pTexture);
+
+	if (texId != m_texIds.end()) return texId->second;
+
+	//! 65536枚を超えた場合番号が重なるが,まとめられる数が減るだけで描画結果は変わらない
+	WORD newTexId = static_cast<WORD>(m_texIds.size());
+
+	m_texIds.emplace(pTexture, newTexId);
+
+	return newTexId;
+}
+
+void RenderQueue::RadixSort()
+{
+	const int RADIX_BITS	= 8;
+	const int BUCKETS_NUM	= 1 << RADIX_BITS;
+	const int PASSES_NUM	= 64 / RADIX_BITS;
+
+	m_sortBuffer.resize(m_sortElements.size());
+
+	for (int pass = 0; pass < PASSES_NUM; ++pass)
+	{
+		const int SHIFT = pass * RADIX_BITS;
+
+		UINT bucketOffsets[BUCKETS_NUM] = {};
+
+		for (const SortElement& rSortElement : m_sortElements)
+		{
+			++bucketOffsets[(rSortElement.m_key >> SHIFT) & (BUCKETS_NUM - 1)];
+		}
+
+		//! 全ての要素が同じ桁ならこの桁での並べ替えは不要
+		if (bucketOffsets[(m_sortElements[0].m_key >> SHIFT) & (BUCKETS_NUM - 1)] == m_sortElements.size()) continue;
+
+		UINT offset = 0;
+
+		for (UINT& rBucketOffset : bucketOffsets)
+		{
+			UINT bucketSize = rBucketOffset;
+			rBucketOffset = offset;
+			offset += bucketSize;
+		}
+
+		for (const SortElement& rSortElement : m_sortElements)
+		{
+			m_sortBuffer[bucketOffsets[(rSortElement.m_key >> SHIFT) & (BUCKETS_NUM - 1)]++] = rSortElement;
+		}
+
+		m_sortElements.swap(m_sortBuffer);
+	}
+}
+
+UINT RenderQueue::CountBinds(bool isSorted) const
+{
+	UINT bindsNum = 0;
+
+	const Command* pPrevCommand = nullptr;
+
+	for (size_t i = 0; i < m_sortElements.size(); ++i)
+	{
+		//! 並べ替え前はm_sortElementsも積まれた順になっている
+		const Command& rCommand = m_commands[(isSorted) ? m_sortElements[i].m_commandIndex : i];
+
+		if (!pPrevCommand)
+		{
+			bindsNum += 2;
+		}
+		else
+		{
+			if (rCommand.m_pTexture != pPrevCommand->m_pTexture) ++bindsNum;
+			if (rCommand.m_blendMode != pPrevCommand->m_blendMode) ++bindsNum;
+		}
+
+		pPrevCommand = &rCommand;
+	}
+
+	return bindsNum;
+}
@@ -0,0 +1,146 @@
+﻿/// <filename>
+/// RenderQueue.h
+/// </filename>
+/// <summary>
+/// 描画命令を並べ替えてから描画するクラスのヘッダ
+/// </summary>
+
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <unordered_map>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\ColorBlender\ColorBlender.h"
+#include "DX\DX3D\SpriteBatch\SpriteBatch.h"
+#include "DX\DX3D\Culler\Culler.h"
+
+/// <summary>
+/// 最後にFlushしたフレームの統計
+/// </summary>
+struct RenderQueueStats
+{
+public:
+	//! 積まれた描画命令の数
+	UINT m_commandsNum = 0;
+
+	//! 並べ替え後のテクスチャと色の合成の切り替えの数
+	UINT m_bindsNum = 0;
+
+	//! 積まれた順に描画していた場合のテクスチャと色の合成の切り替えの数
+	UINT m_unsortedBindsNum = 0;
+
+	//! 積まれた順に描画していた場合と比べて減った切り替えの数
+	//! レイヤー,色の合成,テクスチャの順に並べるので増えることもあり,その場合は0 m_bindsNumとm_unsortedBindsNumで比べる
+	UINT m_savedBindsNum = 0;
+};
+
+/// <summary>
+/// 矩形の描画命令を溜め,64bitのキーでフレームに一度基数ソートしてからSpriteBatchへ送るクラス
+/// </summary>
+/// <remarks>
+/// キーは上位からレイヤー8bit,色の合成8bit,テクスチャ番号16bit,深度32bit
+/// レイヤーの小さいものから描画し,同じレイヤー内では切り替えが最小になるよう色の合成とテクスチャでまとめ,
+/// 最後に奥(Zの大きい方)から手前の順に並べる
+/// 重なりの前後を保証したいものはレイヤーを分ける
+/// </remarks>
+class RenderQueue
+{
+public:
+	RenderQueue(SpriteBatch* pSpriteBatch, ColorBlender* pColorBlender, Culler* pCuller)
+		:m_pSpriteBatch(pSpriteBatch), m_pColorBlender(pColorBlender), m_pCuller(pCuller) {};
+	~RenderQueue() {};
+
+	/// <summary>
+	/// 描画命令を積む 実際の描画はFlushで行う
+	/// </summary>
+	/// <param name="pCustomVertices">[in]描画する矩形の頂点データの先頭ポインタ</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	/// <param name="blendMode">矩形を描画する際の色の合成</param>
+	/// <param name="layer">描画する層 大きいほど後に描画される</param>
+	void Submit(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture,
+		ColorBlender::BLEND_MODE blendMode, BYTE layer);
+
+	/// <summary>
+	/// 積まれた描画命令を並べ替えて描画し,命令を空にする
+	/// 色の合成は描画前の状態に戻す
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// 最後にFlushしたフレームの統計を取得する
+	/// </summary>
+	inline const RenderQueueStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+private:
+	/// <summary>
+	/// 積まれた描画命令
+	/// </summary>
+	struct Command
+	{
+	public:
+		CustomVertex m_vertices[CustomVertex::m_RECT_VERTICES_NUM];
+
+		LPDIRECT3DTEXTURE9 m_pTexture = nullptr;
+
+		ColorBlender::BLEND_MODE m_blendMode = ColorBlender::BLEND_MODE::DEFAULT;
+	};
+
+	/// <summary>
+	/// 並べ替えに使う要素 キーと命令の番号
+	/// </summary>
+	struct SortElement
+	{
+	public:
+		UINT64 m_key = 0;
+
+		UINT m_commandIndex = 0;
+	};
+
+	/// <summary>
+	/// キーを作成する
+	/// </summary>
+	static UINT64 CreateKey(BYTE layer, ColorBlender::BLEND_MODE blendMode, WORD texId, float depth);
+
+	/// <summary>
+	/// テクスチャにフレーム内での番号を割り振る
+	/// </summary>
+	WORD GetTexId(const LPDIRECT3DTEXTURE9 pTexture);
+
+	/// <summary>
+	/// m_sortElementsをキーの昇順に並べ替える 8bitずつの安定なLSD基数ソート
+	/// </summary>
+	void RadixSort();
+
+	/// <summary>
+	/// テクスチャと色の合成の切り替えの数を数える
+	/// </summary>
+	/// <param name="isSorted">trueなら並べ替え後の順,falseなら積まれた順で数える</param>
+	UINT CountBinds(bool isSorted) const;
+
+	SpriteBatch* m_pSpriteBatch = nullptr;
+
+	ColorBlender* m_pColorBlender = nullptr;
+
+	Culler* m_pCuller = nullptr;
+
+	std::vector<Command> m_commands;
+
+	std::vector<SortElement> m_sortElements;
+
+	std::vector<SortElement> m_sortBuffer;
+
+	std::unordered_map<LPDIRECT3DTEXTURE9, WORD> m_texIds;
+
+	RenderQueueStats m_stats;
+};
+
+#endif //! RENDER_QUEUE_H
@@ -0,0 +1,39 @@
+﻿/// <filename>
+/// RenderStateCache.cpp
+/// </filename>
+/// <summary>
+/// デバイスに設定した状態を覚えておき同じ値の設定を省くクラスのソース
+/// </summary>
+
+#include "RenderStateCache.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include <d3dx9.h>
+
+void RenderStateCache::UnbindStreamSource(LPDIRECT3DVERTEXBUFFER9 pVertexBuffer)
+{
+	//! 不明な場合も設定されている可能性があるので外す
+	if (m_streamSourceIsKnown && m_pStreamSource != pVertexBuffer) return;
+
+	SetStreamSource(nullptr, 0);
+}
+
+void RenderStateCache::Invalidate()
+{
+	std::fill(std::begin(m_renderStatesAreKnown), std::end(m_renderStatesAreKnown), false);
+
+	for (bool* pStageStatesAreKnown : m_textureStageStatesAreKnown)
+	{
+		std::fill(pStageStatesAreKnown, pStageStatesAreKnown + m_TEXTURE_STAGE_STATES_NUM, false);
+	}
+
+	std::fill(std::begin(m_texturesAreKnown), std::end(m_texturesAreKnown), false);
+
+	m_fVFIsKnown			= false;
+	m_streamSourceIsKnown	= false;
+	m_indicesAreKnown		= false;
+}
@@ -0,0 +1,242 @@
+﻿/// <filename>
+/// RenderStateCache.h
+/// </filename>
+/// <summary>
+/// デバイスに設定した状態を覚えておき同じ値の設定を省くクラスのヘッダ
+/// </summary>
+
+#ifndef RENDER_STATE_CACHE_H
+#define RENDER_STATE_CACHE_H
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+/// <summary>
+/// 状態の設定の呼び出し回数の統計
+/// </summary>
+struct RenderStateCacheStats
+{
+public:
+	//! デバイスへ渡した設定の回数
+	UINT m_forwardedCallsNum = 0;
+
+	//! 現在の値と同じだったため省いた設定の回数
+	UINT m_filteredCallsNum = 0;
+};
+
+/// <summary>
+/// ライブラリとデバイスの間に入り,最後に設定した値と同じ状態の設定を省くクラス
+/// </summary>
+/// <remarks>
+/// デバイスの状態を直接変更した場合やデバイスのReset後はInvalidateを呼ばなければならない
+/// DrawPrimitiveUP,DrawIndexedPrimitiveUPはストリーム0とインデックスバッファを外すので呼んだ後はOnDrawUPを呼ぶ
+/// </remarks>
+class RenderStateCache
+{
+public:
+	explicit RenderStateCache(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice)
+	{
+		Invalidate();
+	}
+
+	~RenderStateCache() {};
+
+	inline void SetRenderState(D3DRENDERSTATETYPE state, DWORD value)
+	{
+		if (state >= m_RENDER_STATES_NUM)
+		{
+			Forward(m_pDX_GRAPHIC_DEVICE->SetRenderState(state, value));
+
+			return;
+		}
+
+		if (m_renderStatesAreKnown[state] && m_renderStates[state] == value)
+		{
+			++m_stats.m_filteredCallsNum;
+
+			return;
+		}
+
+		if (!Forward(m_pDX_GRAPHIC_DEVICE->SetRenderState(state, value))) return;
+
+		m_renderStates[state]			= value;
+		m_renderStatesAreKnown[state]	= true;
+	}
+
+	inline void SetTextureStageState(DWORD stage, D3DTEXTURESTAGESTATETYPE type, DWORD value)
+	{
+		if (stage >= m_TEXTURE_STAGES_NUM || type >= m_TEXTURE_STAGE_STATES_NUM)
+		{
+			Forward(m_pDX_GRAPHIC_DEVICE->SetTextureStageState(stage, type, value));
+
+			return;
+		}
+
+		if (m_textureStageStatesAreKnown[stage][type] && m_textureStageStates[stage][type] == value)
+		{
+			++m_stats.m_filteredCallsNum;
+
+			return;
+		}
+
+		if (!Forward(m_pDX_GRAPHIC_DEVICE->SetTextureStageState(stage, type, value))) return;
+
+		m_textureStageStates[stage][type]			= value;
+		m_textureStageStatesAreKnown[stage][type]	= true;
+	}
+
+	inline void SetTexture(DWORD stage, LPDIRECT3DBASETEXTURE9 pTexture)
+	{
+		if (stage >= m_TEXTURE_STAGES_NUM)
+		{
+			Forward(m_pDX_GRAPHIC_DEVICE->SetTexture(stage, pTexture));
+
+			return;
+		}
+
+		if (m_texturesAreKnown[stage] && m_pTextures[stage] == pTexture)
+		{
+			++m_stats.m_filteredCallsNum;
+
+			return;
+		}
+
+		if (!Forward(m_pDX_GRAPHIC_DEVICE->SetTexture(stage, pTexture))) return;
+
+		m_pTextures[stage]			= pTexture;
+		m_texturesAreKnown[stage]	= true;
+	}
+
+	inline void SetFVF(DWORD fVF)
+	{
+		if (m_fVFIsKnown && m_fVF == fVF)
+		{
+			++m_stats.m_filteredCallsNum;
+
+			return;
+		}
+
+		if (!Forward(m_pDX_GRAPHIC_DEVICE->SetFVF(fVF))) return;
+
+		m_fVF			= fVF;
+		m_fVFIsKnown	= true;
+	}
+
+	/// <summary>
+	/// ストリーム0に頂点バッファを設定する
+	/// </summary>
+	inline void SetStreamSource(LPDIRECT3DVERTEXBUFFER9 pVertexBuffer, UINT stride)
+	{
+		if (m_streamSourceIsKnown && m_pStreamSource == pVertexBuffer && m_streamStride == stride)
+		{
+			++m_stats.m_filteredCallsNum;
+
+			return;
+		}
+
+		if (!Forward(m_pDX_GRAPHIC_DEVICE->SetStreamSource(0, pVertexBuffer, 0, stride))) return;
+
+		m_pStreamSource			= pVertexBuffer;
+		m_streamStride			= stride;
+		m_streamSourceIsKnown	= true;
+	}
+
+	inline void SetIndices(LPDIRECT3DINDEXBUFFER9 pIndexBuffer)
+	{
+		if (m_indicesAreKnown && m_pIndices == pIndexBuffer)
+		{
+			++m_stats.m_filteredCallsNum;
+
+			return;
+		}
+
+		if (!Forward(m_pDX_GRAPHIC_DEVICE->SetIndices(pIndexBuffer))) return;
+
+		m_pIndices			= pIndexBuffer;
+		m_indicesAreKnown	= true;
+	}
+
+	/// <summary>
+	/// 引数の頂点バッファがストリーム0に設定されていれば外す
+	/// D3DPOOL_DEFAULTの頂点バッファを開放する前に呼ぶ デバイスが参照を持ったままだとResetに失敗する
+	/// </summary>
+	void UnbindStreamSource(LPDIRECT3DVERTEXBUFFER9 pVertexBuffer);
+
+	/// <summary>
+	/// DrawPrimitiveUP,DrawIndexedPrimitiveUPでデバイスが外したストリーム0とインデックスバッファを記録する
+	/// </summary>
+	inline void OnDrawUP()
+	{
+		m_pStreamSource			= nullptr;
+		m_streamSourceIsKnown	= true;
+
+		m_pIndices			= nullptr;
+		m_indicesAreKnown	= true;
+	}
+
+	/// <summary>
+	/// 覚えている全ての状態を不明にし,次の設定を必ずデバイスへ渡すようにする
+	/// </summary>
+	void Invalidate();
+
+	/// <summary>
+	/// 設定の回数の統計を取得する
+	/// </summary>
+	inline const RenderStateCacheStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+	/// <summary>
+	/// 統計を0にする
+	/// </summary>
+	inline void ResetStats()
+	{
+		m_stats = RenderStateCacheStats();
+	}
+
+private:
+	/// <summary>
+	/// デバイスへ渡した回数を数え,成功したかを返す
+	/// </summary>
+	inline bool Forward(HRESULT hr)
+	{
+		++m_stats.m_forwardedCallsNum;
+
+		return SUCCEEDED(hr);
+	}
+
+	//! D3DRS_BLENDOPALPHA(209)までを覚える
+	static const UINT m_RENDER_STATES_NUM = 256;
+
+	static const DWORD m_TEXTURE_STAGES_NUM = 8;
+
+	//! D3DTSS_CONSTANT(32)までを覚える
+	static const UINT m_TEXTURE_STAGE_STATES_NUM = 33;
+
+	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	DWORD m_renderStates[m_RENDER_STATES_NUM];
+	bool m_renderStatesAreKnown[m_RENDER_STATES_NUM];
+
+	DWORD m_textureStageStates[m_TEXTURE_STAGES_NUM][m_TEXTURE_STAGE_STATES_NUM];
+	bool m_textureStageStatesAreKnown[m_TEXTURE_STAGES_NUM][m_TEXTURE_STAGE_STATES_NUM];
+
+	LPDIRECT3DBASETEXTURE9 m_pTextures[m_TEXTURE_STAGES_NUM];
+	bool m_texturesAreKnown[m_TEXTURE_STAGES_NUM];
+
+	DWORD m_fVF = 0;
+	bool m_fVFIsKnown = false;
+
+	LPDIRECT3DVERTEXBUFFER9 m_pStreamSource = nullptr;
+	UINT m_streamStride = 0;
+	bool m_streamSourceIsKnown = false;
+
+	LPDIRECT3DINDEXBUFFER9 m_pIndices = nullptr;
+	bool m_indicesAreKnown = false;
+
+	RenderStateCacheStats m_stats;
+};
+
+#endif //! RENDER_STATE_CACHE_H
@@ -9,66 +9,130 @@
 
 #include <Windows.h>
 
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
 #include <d3dx9.h>
 
 #include "CustomVertex.h"
 #include "VerticesParam.h"
 #include "3DBoard\3DBoard.h"
 #include "DX\DX3D\FbxStorage\FbxStorage.h"
+#include "DX\DX3D\SpriteBatch\SpriteBatch.h"
+#include "DX\DX3D\VertexRingBuffer\VertexRingBuffer.h"
+#include "DX\DX3D\QuadIndexBuffer\QuadIndexBuffer.h"
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+#include "DX\DX3D\GlyphCache\GlyphCache.h"
+#include "DX\DX3D\Culler\Culler.h"
 
 void Renderer::Render(const FbxRelated& rFBXModel, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture) const
 {
+	//! 描画順を守るため溜めている矩形を先に描画する
+	m_pSpriteBatch->Flush();
+
 	m_pDX_GRAPHIC_DEVICE->SetTransform(D3DTS_WORLD, &rWorld);
 
-	m_pDX_GRAPHIC_DEVICE->SetTexture(0, pTexture);
+	m_pRenderStateCache->SetTexture(0, pTexture);
+
+	m_pCuller->SetWorld(rWorld);
 
 	for (FbxModel* pI : rFBXModel.m_pModel)
 	{
-		pI->DrawFbx();
+		if (!m_pCuller->IsVisible(D3DXVECTOR3(pI->minX, pI->minY, pI->minZ), D3DXVECTOR3(pI->maxX, pI->maxY, pI->maxZ))) continue;
+
+		pI->DrawFbx(m_pVertexRingBuffer, m_pRenderStateCache);
 	}
 }
 
 void Renderer::Render(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture) const
 {
-	m_pDX_GRAPHIC_DEVICE->SetFVF(
-		D3DFVF_XYZRHW |
-		D3DFVF_DIFFUSE |
-		D3DFVF_TEX1);
+	Render(pCustomVertices, 1, pTexture);
+}
+
+void Renderer::Render(const CustomVertex* pCustomVertices, UINT rectsNum, const LPDIRECT3DTEXTURE9 pTexture) const
+{
+	//! 画面内の矩形が連続している範囲ごとにまとめて渡す
+	UINT visibleFirst = 0;
+
+	for (UINT i = 0; i < rectsNum; ++i)
+	{
+		if (m_pCuller->IsVisible(&pCustomVertices[i * CustomVertex::m_RECT_VERTICES_NUM])) continue;
+
+		if (i > visibleFirst)
+		{
+			m_pSpriteBatch->Add(&pCustomVertices[visibleFirst * CustomVertex::m_RECT_VERTICES_NUM], i - visibleFirst, pTexture);
+		}
 
-	m_pDX_GRAPHIC_DEVICE->SetTexture(0, pTexture);
+		visibleFirst = i + 1;
+	}
 
-	m_pDX_GRAPHIC_DEVICE->DrawPrimitiveUP(
-		D3DPT_TRIANGLEFAN,
-		2,
-		pCustomVertices, sizeof(CustomVertex));
+	if (rectsNum > visibleFirst)
+	{
+		m_pSpriteBatch->Add(&pCustomVertices[visibleFirst * CustomVertex::m_RECT_VERTICES_NUM], rectsNum - visibleFirst, pTexture);
+	}
 }
 
 void Renderer::Render(const Vertex3D* pVertex, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture) const
 {
-	LPDIRECT3DVERTEXBUFFER9 pBuffer = nullptr;
+	Render(pVertex, 1, rWorld, pTexture);
+}
+
+void Renderer::Render(const Vertex3D* pVertices, UINT boardsNum, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture) const
+{
+	m_pSpriteBatch->Flush();
 
 	m_pDX_GRAPHIC_DEVICE->SetTransform(D3DTS_WORLD, &rWorld);
 
-	m_pDX_GRAPHIC_DEVICE->CreateVertexBuffer(
-		4 * sizeof(Vertex3D),
-		D3DUSAGE_WRITEONLY,
-		D3DFVF_XYZ | D3DFVF_DIFFUSE | D3DFVF_TEX1,
-		D3DPOOL_MANAGED,
-		&pBuffer,
-		NULL);
+	m_pRenderStateCache->SetFVF(
+		D3DFVF_XYZ |
+		D3DFVF_NORMAL |
+		D3DFVF_DIFFUSE |
+		D3DFVF_TEX1);
+
+	m_pRenderStateCache->SetTexture(0, pTexture);
+
+	UINT boardsPerDraw = (std::max)(m_pQuadIndexBuffer->GetQuadsMax(), 1u);
+
+	for (UINT first = 0; first < boardsNum; first += boardsPerDraw)
+	{
+		UINT drawBoardsNum		= (std::min)(boardsPerDraw, boardsNum - first);
+		UINT drawVerticesNum	= drawBoardsNum * QuadIndexBuffer::m_QUAD_VERTICES_NUM;
 
-	m_pDX_GRAPHIC_DEVICE->SetStreamSource(0, pBuffer, 0, sizeof(Vertex3D));
+		const Vertex3D* pSrcVertices = &pVertices[first * QuadIndexBuffer::m_QUAD_VERTICES_NUM];
 
-	m_pDX_GRAPHIC_DEVICE->SetTexture(0, pTexture);
+		UINT startVertex = 0;
 
-	m_pDX_GRAPHIC_DEVICE->DrawPrimitive(D3DPT_TRIANGLEFAN, 0, 2);
+		Vertex3D* pDstVertices = static_cast<Vertex3D*>(m_pVertexRingBuffer->Lock(drawVerticesNum, sizeof(Vertex3D), &startVertex));
 
-	//! 頂点バッファはグラボのメモリに書き込むので開放必須
-	pBuffer->Release();
+		if (pDstVertices)
+		{
+			memcpy(pDstVertices, pSrcVertices, sizeof(Vertex3D) * drawVerticesNum);
+
+			m_pVertexRingBuffer->Unlock();
+
+			m_pVertexRingBuffer->SetStreamSource(sizeof(Vertex3D));
+
+			if (m_pQuadIndexBuffer->DrawQuads(startVertex, drawBoardsNum)) continue;
+		}
+
+		//! デバイスのロスト中などで頂点バッファ,インデックスバッファが使えない場合
+		for (UINT i = 0; i < drawBoardsNum; ++i)
+		{
+			m_pDX_GRAPHIC_DEVICE->DrawPrimitiveUP(D3DPT_TRIANGLEFAN, 2, &pSrcVertices[i * QuadIndexBuffer::m_QUAD_VERTICES_NUM], sizeof(Vertex3D));
+		}
+
+		m_pRenderStateCache->OnDrawUP();
+	}
 }
 
 void Renderer::Render(const D3DXVECTOR2& topLeft, const TCHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color) const
 {
+	if (m_pGlyphCache->Render(topLeft, pText, format, pFont, color)) return;
+
+	//! 区画に収まらない大きさのフォントはID3DXFontで直接描画する
+	m_pSpriteBatch->Flush();
+
 	RECT rect;
 	SetRectEmpty(&rect);
 
@@ -79,3 +143,27 @@ void Renderer::Render(const D3DXVECTOR2& topLeft, const TCHAR* pText, UINT forma
 
 	pFont->DrawText(NULL, pText, -1, &rect, format, color);
 }
+
+void Renderer::RenderUTF8(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color) const
+{
+	if (m_pGlyphCache->RenderUTF8(topLeft, pText, format, pFont, color)) return;
+
+	int length = MultiByteToWideChar(CP_UTF8, 0, pText, -1, NULL, 0);
+
+	if (length <= 0) return;
+
+	std::vector<WCHAR> text(length);
+	MultiByteToWideChar(CP_UTF8, 0, pText, -1, text.data(), length);
+
+	m_pSpriteBatch->Flush();
+
+	RECT rect;
+	SetRectEmpty(&rect);
+
+	//! ここでは矩形を作成しているだけで描画はしていない
+	pFont->DrawTextW(NULL, text.data(), -1, &rect, format | DT_CALCRECT, color);
+
+	OffsetRect(&rect, static_cast<int>(topLeft.x), static_cast<int>(topLeft.y));
+
+	pFont->DrawTextW(NULL, text.data(), -1, &rect, format, color);
+}
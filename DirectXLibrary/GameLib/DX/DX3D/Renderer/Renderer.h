@@ -8,12 +8,20 @@
 
 #include <Windows.h>
 
+#include <vector>
+
 #include <d3dx9.h>
 
 #include "CustomVertex.h"
 #include "VerticesParam.h"
 #include "3DBoard\3DBoard.h"
 #include "DX\DX3D\FbxStorage\FbxStorage.h"
+#include "DX\DX3D\SpriteBatch\SpriteBatch.h"
+#include "DX\DX3D\VertexRingBuffer\VertexRingBuffer.h"
+#include "DX\DX3D\QuadIndexBuffer\QuadIndexBuffer.h"
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+#include "DX\DX3D\GlyphCache\GlyphCache.h"
+#include "DX\DX3D\Culler\Culler.h"
 
 /**
 * @brief FBXとCustomVertexの描画クラス
@@ -21,7 +29,12 @@
 class Renderer
 {
 public:
-	Renderer(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice) {};
+	Renderer(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache,
+		SpriteBatch* pSpriteBatch, VertexRingBuffer* pVertexRingBuffer, const QuadIndexBuffer* pQuadIndexBuffer,
+		GlyphCache* pGlyphCache, Culler* pCuller)
+		:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_pRenderStateCache(pRenderStateCache),
+		m_pSpriteBatch(pSpriteBatch), m_pVertexRingBuffer(pVertexRingBuffer), m_pQuadIndexBuffer(pQuadIndexBuffer),
+		m_pGlyphCache(pGlyphCache), m_pCuller(pCuller) {};
 	~Renderer() {};
 
 	/**
@@ -33,12 +46,20 @@ public:
 	void Render(const FbxRelated& rFBXModel, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const;
 
 	/**
-	* @brief CustomVertexの描画を行う
+	* @brief CustomVertexの描画を行う 実際の描画はSpriteBatchでまとめて行われる
 	* @param pCustomVertices 描画する矩形の頂点データの先頭ポインタ
 	* @param pTexture ポリゴンに張り付けるテクスチャのポインタ
 	*/
 	void Render(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const;
 
+	/// <summary>
+	/// 連続して並んでいる複数の矩形の描画を行う 実際の描画はSpriteBatchでまとめて行われる
+	/// </summary>
+	/// <param name="pCustomVertices">[in]矩形の数*4の頂点データの先頭ポインタ CustomVertexEditor::CreateRectsで作成する</param>
+	/// <param name="rectsNum">矩形の数</param>
+	/// <param name="pTexture">ポリゴンに張り付けるテクスチャのポインタ</param>
+	void Render(const CustomVertex* pCustomVertices, UINT rectsNum, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const;
+
 	/**
 	* @brief 3Dの板ポリにテクスチャを張り付けて描画する
 	* @param pVertex 板ポリの先頭アドレス
@@ -48,7 +69,16 @@ public:
 	void Render(const Vertex3D* pVertex, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture = nullptr)const ;
 
 	/// <summary>
-	/// 文字の描画を行う
+	/// 連続して並んでいる複数の板ポリを同じワールド行列で一度に描画する
+	/// </summary>
+	/// <param name="pVertices">[in]板ポリの数*4の頂点データの先頭ポインタ Board3D::CreateRectsで作成する</param>
+	/// <param name="boardsNum">板ポリの数</param>
+	/// <param name="rWorld">拡大回転移動行列をまとめた行列</param>
+	/// <param name="pTexture">板ポリに張り付けるテクスチャのポインタ</param>
+	void Render(const Vertex3D* pVertices, UINT boardsNum, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const;
+
+	/// <summary>
+	/// 文字の描画を行う 文字の画像はGlyphCacheに保持され矩形としてまとめて描画される
 	/// </summary>
 	/// <param name="topLeft">[in]左上の座標</param>
 	/// <param name="pText">[in]描画したい文字列</param>
@@ -57,8 +87,30 @@ public:
 	/// <param name="color">文字の色ARGB</param>
 	void Render(const D3DXVECTOR2& topLeft, const TCHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color) const;
 
+	/// <summary>
+	/// UTF-8の文字列の描画を行う
+	/// </summary>
+	/// <param name="topLeft">[in]左上の座標</param>
+	/// <param name="pText">[in]描画したいUTF-8の文字列</param>
+	/// <param name="format">文字のフォーマット DT_LEFT(左寄せ)等</param>
+	/// <param name="pFont">描画する際に使うフォントオブジェクト</param>
+	/// <param name="color">文字の色ARGB</param>
+	void RenderUTF8(const D3DXVECTOR2& topLeft, const CHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color) const;
+
 private:
 	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	RenderStateCache* m_pRenderStateCache = nullptr;
+
+	SpriteBatch* m_pSpriteBatch = nullptr;
+
+	VertexRingBuffer* m_pVertexRingBuffer = nullptr;
+
+	const QuadIndexBuffer* m_pQuadIndexBuffer = nullptr;
+
+	GlyphCache* m_pGlyphCache = nullptr;
+
+	Culler* m_pCuller = nullptr;
 };
 
 #endif //! RENDERER_H
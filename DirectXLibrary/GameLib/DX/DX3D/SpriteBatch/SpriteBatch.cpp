@@ -0,0 +1,128 @@
+﻿/// <filename>
+/// SpriteBatch.cpp
+/// </filename>
+/// <summary>
+/// 矩形をまとめて描画するクラスのソース
+/// </summary>
+
+#include "SpriteBatch.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\VertexRingBuffer\VertexRingBuffer.h"
+#include "DX\DX3D\QuadIndexBuffer\QuadIndexBuffer.h"
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+SpriteBatch::SpriteBatch(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache,
+	VertexRingBuffer* pVertexRingBuffer, const QuadIndexBuffer* pQuadIndexBuffer)
+	:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_pRenderStateCache(pRenderStateCache),
+	m_pVertexRingBuffer(pVertexRingBuffer), m_pQuadIndexBuffer(pQuadIndexBuffer)
+{
+	m_vertices.reserve(m_RECTS_MAX * CustomVertex::m_RECT_VERTICES_NUM);
+
+	m_fallbackIndices.resize(m_RECTS_MAX * QuadIndexBuffer::m_QUAD_INDICES_NUM);
+
+	QuadIndexBuffer::WriteIndices(m_fallbackIndices.data(), m_RECTS_MAX);
+}
+
+void SpriteBatch::Add(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture)
+{
+	Add(pCustomVertices, 1, pTexture);
+}
+
+void SpriteBatch::Add(const CustomVertex* pCustomVertices, UINT rectsNum, const LPDIRECT3DTEXTURE9 pTexture)
+{
+	if (pTexture != m_pTexture)
+	{
+		Flush();
+
+		m_pTexture = pTexture;
+	}
+
+	while (rectsNum > 0)
+	{
+		UINT storedRectsNum = static_cast<UINT>(m_vertices.size()) / CustomVertex::m_RECT_VERTICES_NUM;
+
+		if (storedRectsNum >= m_RECTS_MAX)
+		{
+			Flush();
+
+			storedRectsNum = 0;
+		}
+
+		UINT addedRectsNum		= (std::min)(rectsNum, m_RECTS_MAX - storedRectsNum);
+		UINT addedVerticesNum	= addedRectsNum * CustomVertex::m_RECT_VERTICES_NUM;
+
+		m_vertices.insert(m_vertices.end(), pCustomVertices, pCustomVertices + addedVerticesNum);
+
+		pCustomVertices	+= addedVerticesNum;
+		rectsNum		-= addedRectsNum;
+	}
+}
+
+void SpriteBatch::Flush()
+{
+	if (m_vertices.empty()) return;
+
+	UINT verticesNum	= static_cast<UINT>(m_vertices.size());
+	UINT rectsNum		= verticesNum / CustomVertex::m_RECT_VERTICES_NUM;
+
+	m_pRenderStateCache->SetFVF(
+		D3DFVF_XYZRHW |
+		D3DFVF_DIFFUSE |
+		D3DFVF_TEX1);
+
+	m_pRenderStateCache->SetTexture(0, m_pTexture);
+
+	UINT startVertex = 0;
+
+	void* pDstVertices = m_pVertexRingBuffer->Lock(verticesNum, sizeof(CustomVertex), &startVertex);
+
+	if (!pDstVertices)
+	{
+		FlushUP();
+
+		return;
+	}
+
+	memcpy(pDstVertices, m_vertices.data(), sizeof(CustomVertex) * verticesNum);
+
+	m_pVertexRingBuffer->Unlock();
+
+	m_pVertexRingBuffer->SetStreamSource(sizeof(CustomVertex));
+
+	if (!m_pQuadIndexBuffer->DrawQuads(startVertex, rectsNum))
+	{
+		FlushUP();
+
+		return;
+	}
+
+	m_vertices.clear();
+}
+
+void SpriteBatch::FlushUP()
+{
+	UINT verticesNum	= static_cast<UINT>(m_vertices.size());
+	UINT rectsNum		= verticesNum / CustomVertex::m_RECT_VERTICES_NUM;
+
+	//! 矩形一つにつき三角形二つ
+	m_pDX_GRAPHIC_DEVICE->DrawIndexedPrimitiveUP(
+		D3DPT_TRIANGLELIST,
+		0,
+		verticesNum,
+		rectsNum * 2,
+		m_fallbackIndices.data(), D3DFMT_INDEX16,
+		m_vertices.data(), sizeof(CustomVertex));
+
+	m_pRenderStateCache->OnDrawUP();
+
+	m_vertices.clear();
+}
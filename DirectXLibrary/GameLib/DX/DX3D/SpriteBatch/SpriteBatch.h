@@ -0,0 +1,81 @@
+﻿/// <filename>
+/// SpriteBatch.h
+/// </filename>
+/// <summary>
+/// 矩形をまとめて描画するクラスのヘッダ
+/// </summary>
+
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <Windows.h>
+
+#include <vector>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\VertexRingBuffer\VertexRingBuffer.h"
+#include "DX\DX3D\QuadIndexBuffer\QuadIndexBuffer.h"
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+/// <summary>
+/// 矩形の頂点を溜めておき,テクスチャが変わった時などにまとめて描画するクラス
+/// </summary>
+class SpriteBatch
+{
+public:
+	SpriteBatch(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache,
+		VertexRingBuffer* pVertexRingBuffer, const QuadIndexBuffer* pQuadIndexBuffer);
+	~SpriteBatch() {};
+
+	/// <summary>
+	/// 矩形を追加する
+	/// テクスチャが溜めている矩形と異なる場合は溜めている矩形を先に描画する
+	/// </summary>
+	/// <param name="pCustomVertices">[in]追加する矩形の頂点データの先頭ポインタ</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	void Add(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture);
+
+	/// <summary>
+	/// 連続して並んでいる複数の矩形を追加する
+	/// </summary>
+	/// <param name="pCustomVertices">[in]矩形の数*4の頂点データの先頭ポインタ</param>
+	/// <param name="rectsNum">矩形の数</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	void Add(const CustomVertex* pCustomVertices, UINT rectsNum, const LPDIRECT3DTEXTURE9 pTexture);
+
+	/// <summary>
+	/// 溜めている矩形をリングバッファへ書き込み,共有のインデックスバッファで一度に描画する
+	/// </summary>
+	/// <remarks>
+	/// 色の合成の変更,別の描画,描画の終了宣言の前に必ず呼ぶ
+	/// </remarks>
+	void Flush();
+
+private:
+	/// <summary>
+	/// 頂点バッファが使えない時にメモリ上の頂点から描画する
+	/// </summary>
+	void FlushUP();
+
+	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	RenderStateCache* m_pRenderStateCache = nullptr;
+
+	VertexRingBuffer* m_pVertexRingBuffer = nullptr;
+
+	const QuadIndexBuffer* m_pQuadIndexBuffer = nullptr;
+
+	//! 16bitのインデックスで表せる頂点数に収まるようにする
+	static const UINT m_RECTS_MAX = 4096;
+
+	std::vector<CustomVertex> m_vertices;
+
+	//! 頂点バッファが使えない時に用いる
+	std::vector<WORD> m_fallbackIndices;
+
+	LPDIRECT3DTEXTURE9 m_pTexture = nullptr;
+};
+
+#endif //! SPRITE_BATCH_H
@@ -0,0 +1,134 @@
+﻿/// <filename>
+/// SkylinePacker.cpp
+/// </filename>
+/// <summary>
+/// 矩形を一枚の領域に詰めていくクラスのソース
+/// </summary>
+
+#include "SkylinePacker.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+
+SkylinePacker::SkylinePacker(UINT width, UINT height) :m_WIDTH(width), m_HEIGHT(height)
+{
+	Clear();
+}
+
+bool SkylinePacker::Insert(UINT width, UINT height, UINT* pX, UINT* pY)
+{
+	if (width == 0 || height == 0) return false;
+
+	const size_t NOT_FOUND = m_nodes.size();
+
+	size_t bestIndex = NOT_FOUND;
+	UINT bestBottom = UINT_MAX;
+	UINT bestWidth	= UINT_MAX;
+	UINT bestY		= 0;
+
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		UINT y = 0;
+
+		if (!Fits(i, width, height, &y)) continue;
+
+		//! 下端が一番上になる位置を選び,同じなら輪郭の幅が狭い方を選んで隙間を減らす
+		UINT bottom = y + height;
+
+		if (bottom > bestBottom || (bottom == bestBottom && m_nodes[i].m_width >= bestWidth)) continue;
+
+		bestIndex	= i;
+		bestBottom	= bottom;
+		bestWidth	= m_nodes[i].m_width;
+		bestY		= y;
+	}
+
+	if (bestIndex == NOT_FOUND) return false;
+
+	*pX = m_nodes[bestIndex].m_x;
+	*pY = bestY;
+
+	AddLevel(bestIndex, *pX, *pY, width, height);
+
+	return true;
+}
+
+void SkylinePacker::Clear()
+{
+	m_nodes.clear();
+
+	m_nodes.push_back({ 0, 0, m_WIDTH });
+}
+
+bool SkylinePacker::Fits(size_t nodeIndex, UINT width, UINT height, UINT* pY) const
+{
+	UINT x = m_nodes[nodeIndex].m_x;
+
+	if (x + width > m_WIDTH) return false;
+
+	UINT y = 0;
+	UINT remainingWidth = width;
+
+	//! 矩形の幅に掛かる輪郭のうち一番低いところに乗せる
+	for (size_t i = nodeIndex; remainingWidth > 0; ++i)
+	{
+		if (i >= m_nodes.size()) return false;
+
+		y = (std::max)(y, m_nodes[i].m_y);
+
+		if (y + height > m_HEIGHT) return false;
+
+		remainingWidth -= (std::min)(remainingWidth, m_nodes[i].m_width);
+	}
+
+	*pY = y;
+
+	return true;
+}
+
+void SkylinePacker::AddLevel(size_t nodeIndex, UINT x, UINT y, UINT width, UINT height)
+{
+	m_nodes.insert(m_nodes.begin() + nodeIndex, { x, y + height, width });
+
+	UINT right = x + width;
+
+	//! 新しい輪郭に隠れた輪郭を削るか縮める
+	for (size_t i = nodeIndex + 1; i < m_nodes.size();)
+	{
+		SkylineNode& rNode = m_nodes[i];
+
+		if (rNode.m_x >= right) break;
+
+		UINT nodeRight = rNode.m_x + rNode.m_width;
+
+		if (nodeRight <= right)
+		{
+			m_nodes.erase(m_nodes.begin() + i);
+
+			continue;
+		}
+
+		rNode.m_width	= nodeRight - right;
+		rNode.m_x		= right;
+
+		break;
+	}
+
+	//! 同じ高さで隣り合う輪郭をまとめる
+	for (size_t i = 0; i + 1 < m_nodes.size();)
+	{
+		if (m_nodes[i].m_y != m_nodes[i + 1].m_y)
+		{
+			++i;
+
+			continue;
+		}
+
+		m_nodes[i].m_width += m_nodes[i + 1].m_width;
+
+		m_nodes.erase(m_nodes.begin() + i + 1);
+	}
+}
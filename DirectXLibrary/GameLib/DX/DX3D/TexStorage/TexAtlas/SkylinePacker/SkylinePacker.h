@@ -0,0 +1,71 @@
+﻿/// <filename>
+/// SkylinePacker.h
+/// </filename>
+/// <summary>
+/// 矩形を一枚の領域に詰めていくクラスのヘッダ
+/// </summary>
+
+#ifndef SKYLINE_PACKER_H
+#define SKYLINE_PACKER_H
+
+#include <Windows.h>
+
+#include <vector>
+
+/// <summary>
+/// 詰めた矩形の上端の輪郭(スカイライン)を保持し,新しい矩形をできるだけ低く左の位置に置くクラス
+/// </summary>
+class SkylinePacker
+{
+public:
+	SkylinePacker(UINT width, UINT height);
+	~SkylinePacker() {};
+
+	/// <summary>
+	/// 矩形を置く位置を決める
+	/// </summary>
+	/// <param name="width">矩形の幅</param>
+	/// <param name="height">矩形の高さ</param>
+	/// <param name="pX">[out]矩形の左上のx座標</param>
+	/// <param name="pY">[out]矩形の左上のy座標</param>
+	/// <returns>置ける場所がない場合false</returns>
+	bool Insert(UINT width, UINT height, UINT* pX, UINT* pY);
+
+	/// <summary>
+	/// 置いた矩形を全て取り除く
+	/// </summary>
+	void Clear();
+
+private:
+	struct SkylineNode
+	{
+	public:
+		UINT m_x;
+		UINT m_y;
+		UINT m_width;
+	};
+
+	/// <summary>
+	/// 引数の輪郭の左端から矩形を置けるか判別し,置ける場合の高さを求める
+	/// </summary>
+	/// <param name="nodeIndex">矩形の左端を合わせる輪郭の番号</param>
+	/// <param name="width">矩形の幅</param>
+	/// <param name="height">矩形の高さ</param>
+	/// <param name="pY">[out]矩形の上端のy座標</param>
+	/// <returns>置けない場合false</returns>
+	bool Fits(size_t nodeIndex, UINT width, UINT height, UINT* pY) const;
+
+	/// <summary>
+	/// 置いた矩形の下端を新しい輪郭として加え,隠れた輪郭を削る
+	/// </summary>
+	void AddLevel(size_t nodeIndex, UINT x, UINT y, UINT width, UINT height);
+
+	const UINT m_WIDTH = 0;
+
+	const UINT m_HEIGHT = 0;
+
+	//! x座標の昇順に並んだ輪郭
+	std::vector<SkylineNode> m_nodes;
+};
+
+#endif //! SKYLINE_PACKER_H
@@ -0,0 +1,353 @@
+﻿/// <filename>
+/// TexAtlas.cpp
+/// </filename>
+/// <summary>
+/// 小さな画像を共有のテクスチャにまとめるクラスのソース
+/// </summary>
+
+#include "TexAtlas.h"
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include <d3dx9.h>
+
+#include "VerticesParam.h"
+#include "SkylinePacker/SkylinePacker.h"
+
+namespace
+{
+	//! ワイド文字のキーはUTF-8で読み書きし,マルチバイト文字のキーはそのまま読み書きする
+#ifdef _UNICODE
+	const TCHAR* const TABLE_WRITE_MODE = _T("w, ccs=UTF-8");
+	const TCHAR* const TABLE_READ_MODE	= _T("r, ccs=UTF-8");
+#else
+	const TCHAR* const TABLE_WRITE_MODE = _T("w");
+	const TCHAR* const TABLE_READ_MODE	= _T("r");
+#endif
+}
+
+bool TexAtlas::Add(const TCHAR* pTexKey, const TCHAR* pTexPath)
+{
+	if (Exists(pTexKey)) return true;
+
+	D3DXIMAGE_INFO imageInfo;
+	LPDIRECT3DTEXTURE9 pSrcTexture = nullptr;
+
+	//! CPUから読むだけなのでD3DPOOL_SCRATCHに元の大きさのまま読み込む
+	if (FAILED(D3DXCreateTextureFromFileEx(
+		m_pDX_GRAPHIC_DEVICE,
+		pTexPath,
+		D3DX_DEFAULT_NONPOW2, D3DX_DEFAULT_NONPOW2,
+		1,
+		0,
+		D3DFMT_A8R8G8B8,
+		D3DPOOL_SCRATCH,
+		D3DX_FILTER_NONE,
+		D3DX_DEFAULT,
+		0,
+		&imageInfo,
+		NULL,
+		&pSrcTexture)))
+	{
+		return false;
+	}
+
+	UINT paddedWidth	= imageInfo.Width + m_PADDING * 2;
+	UINT paddedHeight	= imageInfo.Height + m_PADDING * 2;
+
+	UINT x = 0;
+	UINT y = 0;
+
+	size_t pageIndex = 0;
+
+	for (; pageIndex < m_pages.size(); ++pageIndex)
+	{
+		if (m_pages[pageIndex].m_packer.Insert(paddedWidth, paddedHeight, &x, &y)) break;
+	}
+
+	bool isPlaced = (pageIndex < m_pages.size());
+
+	//! どのページにも入らない場合は新しいページに置く 新しいページにも入らない大きさなら詰めない
+	if (!isPlaced && paddedWidth <= m_PAGE_SIZE && paddedHeight <= m_PAGE_SIZE && CreatePage())
+	{
+		isPlaced = m_pages.back().m_packer.Insert(paddedWidth, paddedHeight, &x, &y);
+	}
+
+	D3DLOCKED_RECT srcRect;
+
+	if (!isPlaced || FAILED(pSrcTexture->LockRect(0, &srcRect, NULL, D3DLOCK_READONLY)))
+	{
+		pSrcTexture->Release();
+
+		return false;
+	}
+
+	bool isBlitted = Blit(m_pages[pageIndex].m_pTexture, x, y, srcRect, imageInfo.Width, imageInfo.Height);
+
+	pSrcTexture->UnlockRect(0);
+	pSrcTexture->Release();
+
+	if (!isBlitted) return false;
+
+	AtlasTex atlasTex;
+	atlasTex.m_pTexture		= m_pages[pageIndex].m_pTexture;
+	atlasTex.m_pageIndex	= static_cast<UINT>(pageIndex);
+
+	float pageSize = static_cast<float>(m_PAGE_SIZE);
+
+	atlasTex.m_texUV.m_startTU	= static_cast<float>(x + m_PADDING) / pageSize;
+	atlasTex.m_texUV.m_startTV	= static_cast<float>(y + m_PADDING) / pageSize;
+	atlasTex.m_texUV.m_endTU	= static_cast<float>(x + m_PADDING + imageInfo.Width) / pageSize;
+	atlasTex.m_texUV.m_endTV	= static_cast<float>(y + m_PADDING + imageInfo.Height) / pageSize;
+
+	m_atlasTexMap[pTexKey] = atlasTex;
+
+	return true;
+}
+
+bool TexAtlas::Get(const TCHAR* pTexKey, AtlasTex* pAtlasTex) const
+{
+	auto atlasTex = m_atlasTexMap.find(pTexKey);
+
+	if (atlasTex == m_atlasTexMap.end()) return false;
+
+	*pAtlasTex = atlasTex->second;
+
+	return true;
+}
+
+void TexAtlas::AllRelease()
+{
+	for (Page& rPage : m_pages)
+	{
+		rPage.m_pTexture->Release();
+	}
+
+	m_pages.clear();
+
+	m_atlasTexMap.clear();
+}
+
+bool TexAtlas::Save(const TCHAR* pFilePathPrefix) const
+{
+	TCHAR filePath[MAX_PATH];
+
+	for (size_t i = 0; i < m_pages.size(); ++i)
+	{
+		_stprintf_s(filePath, MAX_PATH, _T("%s%u.png"), pFilePathPrefix, static_cast<UINT>(i));
+
+		if (FAILED(D3DXSaveTextureToFile(filePath, D3DXIFF_PNG, m_pages[i].m_pTexture, NULL))) return false;
+	}
+
+	_stprintf_s(filePath, MAX_PATH, _T("%s.txt"), pFilePathPrefix);
+
+	FILE* pFile = nullptr;
+
+	if (_tfopen_s(&pFile, filePath, TABLE_WRITE_MODE) != 0) return false;
+
+	//! キー ページ番号 startTU startTV endTU endTVをタブ区切りで一行ずつ書き出す
+	//! %fでは小数点以下6桁で丸められ大きなページでずれるので,floatを読み戻して同じ値になる9桁で書く
+	for (const auto& rAtlasTex : m_atlasTexMap)
+	{
+		const TexUV& rTexUV = rAtlasTex.second.m_texUV;
+
+		_ftprintf(pFile, _T("%s\t%u\t%.9g\t%.9g\t%.9g\t%.9g\n"),
+			rAtlasTex.first.c_str(),
+			rAtlasTex.second.m_pageIndex,
+			rTexUV.m_startTU, rTexUV.m_startTV,
+			rTexUV.m_endTU, rTexUV.m_endTV);
+	}
+
+	fclose(pFile);
+
+	return true;
+}
+
+bool TexAtlas::Load(const TCHAR* pFilePathPrefix)
+{
+	TCHAR filePath[MAX_PATH];
+
+	_stprintf_s(filePath, MAX_PATH, _T("%s.txt"), pFilePathPrefix);
+
+	FILE* pFile = nullptr;
+
+	if (_tfopen_s(&pFile, filePath, TABLE_READ_MODE) != 0) return false;
+
+	std::vector<std::pair<std::basic_string<TCHAR>, AtlasTex>> loadedAtlasTexs;
+
+	UINT loadedPagesNum = 0;
+
+	bool isValid = true;
+
+	TCHAR line[MAX_PATH + 128];
+
+	while (_fgetts(line, _countof(line), pFile))
+	{
+		//! キーの後ろのタブで区切り,残りの数値を読む
+		TCHAR* pTab = _tcschr(line, _T('\t'));
+
+		if (!pTab)
+		{
+			if (line[0] == _T('\n') || line[0] == _T('\0')) continue;
+
+			isValid = false;
+
+			break;
+		}
+
+		*pTab = _T('\0');
+
+		AtlasTex atlasTex;
+		TexUV& rTexUV = atlasTex.m_texUV;
+
+		if (_stscanf_s(pTab + 1, _T("%u %f %f %f %f"), &atlasTex.m_pageIndex,
+			&rTexUV.m_startTU, &rTexUV.m_startTV, &rTexUV.m_endTU, &rTexUV.m_endTV) != 5)
+		{
+			isValid = false;
+
+			break;
+		}
+
+		loadedPagesNum = (std::max)(loadedPagesNum, atlasTex.m_pageIndex + 1);
+
+		loadedAtlasTexs.emplace_back(line, atlasTex);
+	}
+
+	fclose(pFile);
+
+	if (!isValid) return false;
+
+	std::vector<LPDIRECT3DTEXTURE9> pLoadedPageTextures;
+
+	for (UINT i = 0; i < loadedPagesNum; ++i)
+	{
+		_stprintf_s(filePath, MAX_PATH, _T("%s%u.png"), pFilePathPrefix, i);
+
+		LPDIRECT3DTEXTURE9 pPageTexture = nullptr;
+
+		//! 書き出した時と同じ大きさと形式で読み込み,CreatePageと同じくD3DPOOL_MANAGEDに置く
+		if (FAILED(D3DXCreateTextureFromFileEx(
+			m_pDX_GRAPHIC_DEVICE,
+			filePath,
+			D3DX_DEFAULT_NONPOW2, D3DX_DEFAULT_NONPOW2,
+			1,
+			0,
+			D3DFMT_A8R8G8B8,
+			D3DPOOL_MANAGED,
+			D3DX_FILTER_NONE,
+			D3DX_DEFAULT,
+			0,
+			NULL,
+			NULL,
+			&pPageTexture)))
+		{
+			for (LPDIRECT3DTEXTURE9 pLoadedPageTexture : pLoadedPageTextures)
+			{
+				pLoadedPageTexture->Release();
+			}
+
+			return false;
+		}
+
+		pLoadedPageTextures.push_back(pPageTexture);
+	}
+
+	UINT firstPageIndex = static_cast<UINT>(m_pages.size());
+
+	for (LPDIRECT3DTEXTURE9 pPageTexture : pLoadedPageTextures)
+	{
+		//! 空いている場所が分からないので,大きさ0のパッカーで以降の画像を詰めないようにする
+		Page page = { pPageTexture, SkylinePacker(0, 0) };
+
+		m_pages.push_back(page);
+	}
+
+	for (auto& rLoadedAtlasTex : loadedAtlasTexs)
+	{
+		AtlasTex& rAtlasTex = rLoadedAtlasTex.second;
+		rAtlasTex.m_pageIndex	+= firstPageIndex;
+		rAtlasTex.m_pTexture	= m_pages[rAtlasTex.m_pageIndex].m_pTexture;
+
+		m_atlasTexMap.emplace(rLoadedAtlasTex.first, rAtlasTex);
+	}
+
+	return true;
+}
+
+bool TexAtlas::CreatePage()
+{
+	Page page = { nullptr, SkylinePacker(m_PAGE_SIZE, m_PAGE_SIZE) };
+
+	if (FAILED(m_pDX_GRAPHIC_DEVICE->CreateTexture(
+		m_PAGE_SIZE, m_PAGE_SIZE,
+		1,
+		0,
+		D3DFMT_A8R8G8B8,
+		D3DPOOL_MANAGED,
+		&page.m_pTexture,
+		NULL)))
+	{
+		return false;
+	}
+
+	D3DLOCKED_RECT pageRect;
+
+	if (FAILED(page.m_pTexture->LockRect(0, &pageRect, NULL, 0)))
+	{
+		page.m_pTexture->Release();
+
+		return false;
+	}
+
+	for (UINT row = 0; row < m_PAGE_SIZE; ++row)
+	{
+		memset(static_cast<BYTE*>(pageRect.pBits) + row * pageRect.Pitch, 0, m_PAGE_SIZE * sizeof(DWORD));
+	}
+
+	page.m_pTexture->UnlockRect(0);
+
+	m_pages.push_back(page);
+
+	return true;
+}
+
+bool TexAtlas::Blit(LPDIRECT3DTEXTURE9 pPageTexture, UINT x, UINT y, const D3DLOCKED_RECT& rSrc, UINT width, UINT height) const
+{
+	UINT paddedWidth	= width + m_PADDING * 2;
+	UINT paddedHeight	= height + m_PADDING * 2;
+
+	RECT dstArea = { static_cast<LONG>(x), static_cast<LONG>(y), static_cast<LONG>(x + paddedWidth), static_cast<LONG>(y + paddedHeight) };
+
+	D3DLOCKED_RECT dstRect;
+
+	if (FAILED(pPageTexture->LockRect(0, &dstRect, &dstArea, 0))) return false;
+
+	for (UINT row = 0; row < paddedHeight; ++row)
+	{
+		//! 余白は一番近い画像の端の色で埋める
+		UINT srcRow = (std::min)((std::max)(row, m_PADDING) - m_PADDING, height - 1);
+
+		const DWORD* pSrcTexels = reinterpret_cast<const DWORD*>(static_cast<const BYTE*>(rSrc.pBits) + srcRow * rSrc.Pitch);
+		DWORD* pDstTexels		= reinterpret_cast<DWORD*>(static_cast<BYTE*>(dstRect.pBits) + row * dstRect.Pitch);
+
+		for (UINT column = 0; column < m_PADDING; ++column)
+		{
+			pDstTexels[column]							= pSrcTexels[0];
+			pDstTexels[m_PADDING + width + column]		= pSrcTexels[width - 1];
+		}
+
+		memcpy(&pDstTexels[m_PADDING], pSrcTexels, width * sizeof(DWORD));
+	}
+
+	pPageTexture->UnlockRect(0);
+
+	return true;
+}
@@ -0,0 +1,151 @@
+﻿/// <filename>
+/// TexAtlas.h
+/// </filename>
+/// <summary>
+/// 小さな画像を共有のテクスチャにまとめるクラスのヘッダ
+/// </summary>
+
+#ifndef TEX_ATLAS_H
+#define TEX_ATLAS_H
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <vector>
+#include <map>
+#include <string>
+
+#include <d3dx9.h>
+
+#include "VerticesParam.h"
+#include "SkylinePacker/SkylinePacker.h"
+
+/// <summary>
+/// アトラスに詰めた画像の場所
+/// </summary>
+struct AtlasTex
+{
+public:
+	//! 画像が詰められているページのテクスチャ 描画の際に渡す
+	LPDIRECT3DTEXTURE9 m_pTexture = nullptr;
+
+	UINT m_pageIndex = 0;
+
+	//! VerticesParam::m_texUV,CustomVertexEditor::SetTexUVにそのまま渡せるページ内の座標
+	TexUV m_texUV;
+};
+
+/// <summary>
+/// 画像を一定の大きさのページに詰めていき,同じページの画像をテクスチャの切り替えなしで描画できるようにするクラス
+/// </summary>
+/// <remarks>
+/// 画像の周りには余白を設け,画像の端の色で埋めることでバイリニア補間時に隣の画像の色がにじまないようにしている
+/// ページはD3DPOOL_MANAGEDなのでデバイスのReset時に作り直す必要はない
+/// </remarks>
+class TexAtlas
+{
+public:
+	/// <param name="dXGraphicDevice">デバイス</param>
+	/// <param name="pageSize">ページの幅と高さ(ピクセル)</param>
+	/// <param name="padding">画像の周りに設ける余白(ピクセル)</param>
+	TexAtlas(const LPDIRECT3DDEVICE9 dXGraphicDevice, UINT pageSize = m_DEFAULT_PAGE_SIZE, UINT padding = m_DEFAULT_PADDING)
+		:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_PAGE_SIZE(pageSize), m_PADDING(padding) {};
+
+	~TexAtlas()
+	{
+		AllRelease();
+	}
+
+	/// <summary>
+	/// 画像を読み込みページに詰める 既に同じキーがある場合は何もしない
+	/// </summary>
+	/// <param name="pTexKey">[in]画像につける名前</param>
+	/// <param name="pTexPath">[in]画像のパス</param>
+	/// <returns>読み込めない,もしくは余白を含めページより大きい場合false</returns>
+	bool Add(const TCHAR* pTexKey, const TCHAR* pTexPath);
+
+	/// <summary>
+	/// 詰めた画像の場所を取得する
+	/// </summary>
+	/// <param name="pTexKey">[in]画像を詰めるときに決めた名前</param>
+	/// <param name="pAtlasTex">[out]画像の場所</param>
+	/// <returns>詰められていない場合false</returns>
+	bool Get(const TCHAR* pTexKey, AtlasTex* pAtlasTex) const;
+
+	inline bool Exists(const TCHAR* pTexKey) const
+	{
+		return (m_atlasTexMap.find(pTexKey) != m_atlasTexMap.end());
+	}
+
+	/// <summary>
+	/// 全てのページを開放する
+	/// </summary>
+	void AllRelease();
+
+	/// <summary>
+	/// 全てのページを画像として,詰めた画像の場所の表をテキストとして書き出す
+	/// 書き出したものを事前に作成しておけば実行時に詰める必要がなくなる
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]書き出すファイルのパスの先頭 ページは(先頭)(番号).png,表は(先頭).txtになる</param>
+	/// <returns>書き出せなかった場合false</returns>
+	bool Save(const TCHAR* pFilePathPrefix) const;
+
+	/// <summary>
+	/// Saveで書き出したページと表を読み込み,画像を詰め直さずに使えるようにする
+	/// 読み込んだページは既存のページの後ろに加え,既にあるキーの画像は読み込んだ表で上書きしない
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]Saveに渡したファイルのパスの先頭</param>
+	/// <returns>表かページを読み込めなかった場合false その場合何も加えない</returns>
+	/// <remarks>読み込んだページの空きは分からないので,以降のAddでは新しいページに詰める</remarks>
+	bool Load(const TCHAR* pFilePathPrefix);
+
+	inline UINT GetPagesNum() const
+	{
+		return static_cast<UINT>(m_pages.size());
+	}
+
+private:
+	/// <summary>
+	/// 画像を詰める一枚のテクスチャ
+	/// </summary>
+	struct Page
+	{
+	public:
+		LPDIRECT3DTEXTURE9 m_pTexture;
+
+		SkylinePacker m_packer;
+	};
+
+	/// <summary>
+	/// 透明で埋めたページを作成し末尾に加える
+	/// </summary>
+	/// <returns>作成できなかった場合false</returns>
+	bool CreatePage();
+
+	/// <summary>
+	/// 画像をページに書き込み,余白を画像の端の色で埋める
+	/// </summary>
+	/// <param name="pPageTexture">書き込み先のページ</param>
+	/// <param name="x">余白を含めた書き込み先の左上のx座標</param>
+	/// <param name="y">余白を含めた書き込み先の左上のy座標</param>
+	/// <param name="rSrc">[in]ロックした画像</param>
+	/// <param name="width">画像の幅</param>
+	/// <param name="height">画像の高さ</param>
+	bool Blit(LPDIRECT3DTEXTURE9 pPageTexture, UINT x, UINT y, const D3DLOCKED_RECT& rSrc, UINT width, UINT height) const;
+
+	static const UINT m_DEFAULT_PAGE_SIZE = 1024;
+
+	static const UINT m_DEFAULT_PADDING = 2;
+
+	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	const UINT m_PAGE_SIZE = 0;
+
+	const UINT m_PADDING = 0;
+
+	std::vector<Page> m_pages;
+
+	std::map<std::basic_string<TCHAR>, AtlasTex> m_atlasTexMap;
+};
+
+#endif //! TEX_ATLAS_H
@@ -4,3 +4,99 @@
 /// <summary>
 /// テクスチャ保管クラスのソース
 /// </summary>
+
+#include "TexStorage.h"
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <vector>
+#include <map>
+#include <string>
+#include <climits>
+
+#include <d3dx9.h>
+
+#include "TexAtlas/TexAtlas.h"
+
+TexHandle TexStorage::CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
+{
+	TexHandle texHandle = GetTexHandle(pTexKey);
+
+	if (!texHandle.IsNull() || !pTexKey) return texHandle;
+
+	//! 添え字が世代のビットにあふれないよう,空きがなく枠を増やせない場合は作成しない
+	if (m_freeSlotIndices.empty() && m_texSlots.size() >= TexHandle::m_INDEX_MASK) return TexHandle();
+
+	LPDIRECT3DTEXTURE9 pTexture = nullptr;
+
+	if (FAILED(D3DXCreateTextureFromFile(
+		m_pDX_GRAPHIC_DEVICE,
+		pTexPath,
+		&pTexture)))
+	{
+		return TexHandle();
+	}
+
+	UINT index = 0;
+
+	if (m_freeSlotIndices.empty())
+	{
+		index = static_cast<UINT>(m_texSlots.size());
+
+		m_texSlots.emplace_back();
+	}
+	else
+	{
+		index = m_freeSlotIndices.back();
+
+		m_freeSlotIndices.pop_back();
+	}
+
+	TexSlot& rTexSlot = m_texSlots[index];
+	rTexSlot.m_pTexture = pTexture;
+
+	texHandle = TexHandle(index, rTexSlot.m_generation);
+
+	m_texHandles[pTexKey] = texHandle;
+
+	return texHandle;
+}
+
+void TexStorage::AllRelease()
+{
+	for (auto& i : m_texHandles)
+	{
+		ReleaseSlot(i.second.GetIndex());
+	}
+
+	m_texHandles.clear();
+
+	m_texAtlas.AllRelease();
+}
+
+void TexStorage::Release(const TCHAR* pTexKey)
+{
+	if (!pTexKey) return;
+
+	auto texHandle = m_texHandles.find(pTexKey);
+
+	if (texHandle == m_texHandles.end()) return;
+
+	ReleaseSlot(texHandle->second.GetIndex());
+
+	m_texHandles.erase(texHandle);
+}
+
+void TexStorage::ReleaseSlot(UINT index)
+{
+	TexSlot& rTexSlot = m_texSlots[index];
+
+	rTexSlot.m_pTexture->Release();
+	rTexSlot.m_pTexture = nullptr;
+
+	//! 0は何も指さないハンドルと区別できないので飛ばす
+	rTexSlot.m_generation = (rTexSlot.m_generation >= TexHandle::m_GENERATION_MAX) ? 1 : rTexSlot.m_generation + 1;
+
+	m_freeSlotIndices.push_back(index);
+}
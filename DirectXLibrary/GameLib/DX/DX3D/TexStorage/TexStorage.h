@@ -9,17 +9,73 @@
 #include <Windows.h>
 #include <tchar.h>
 
+#include <vector>
 #include <map>
+#include <string>
+#include <climits>
 
 #include <d3dx9.h>
 
+#include "TexAtlas/TexAtlas.h"
+
+/// <summary>
+/// TexStorageのテクスチャを指すハンドル 枠の添え字と世代を32bitに詰めたもの
+/// テクスチャが開放された後は何も指さなくなる
+/// </summary>
+struct TexHandle
+{
+public:
+	TexHandle() {};
+
+	TexHandle(UINT index, UINT generation) :m_value((generation << m_INDEX_BITS) | index) {};
+
+	inline UINT GetIndex() const
+	{
+		return m_value & m_INDEX_MASK;
+	}
+
+	inline UINT GetGeneration() const
+	{
+		return m_value >> m_INDEX_BITS;
+	}
+
+	/// <summary>
+	/// 何も指していないか テクスチャが開放されたかはTexStorage::GetTexで判別する
+	/// </summary>
+	inline bool IsNull() const
+	{
+		return m_value == 0;
+	}
+
+	inline bool operator==(const TexHandle& rRight) const
+	{
+		return m_value == rRight.m_value;
+	}
+
+	inline bool operator!=(const TexHandle& rRight) const
+	{
+		return m_value != rRight.m_value;
+	}
+
+	//! 下位のビットを添え字に,残りを世代に用いる
+	static const UINT m_INDEX_BITS = 20;
+
+	static const UINT m_INDEX_MASK = (1 << m_INDEX_BITS) - 1;
+
+	//! 世代はこれを超えると1に戻る
+	static const UINT m_GENERATION_MAX = UINT_MAX >> m_INDEX_BITS;
+
+	//! 世代は1から振るので0は何も指さない
+	UINT m_value = 0;
+};
+
 /**
 * @brief テクスチャを作成保存しそれを渡したりするクラス
 */
 class TexStorage
 {
 public:
-	TexStorage(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice) {};
+	TexStorage(const LPDIRECT3DDEVICE9 dXGraphicDevice) :m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_texAtlas(dXGraphicDevice) {};
 	~TexStorage()
 	{
 		AllRelease();
@@ -29,52 +85,114 @@ public:
 	* @brief テクスチャを作成する
 	* @param pTexKey テクスチャにつける名前のポインタ キー 連想配列
 	* @param pTexPath 画像のパスのポインタ
+	* @return テクスチャのハンドル 既に作成されている場合はそのハンドル 作成できなかった場合何も指さない
 	*/
-	inline void CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
+	TexHandle CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath);
+
+	/**
+	* @brief 全てのテクスチャの開放 作成済みのハンドルは全て何も指さなくなる
+	*/
+	void AllRelease();
+
+	/// <summary>
+	/// 画像をアトラスのページに詰めて作成する 同じページの画像同士はテクスチャを切り替えずに描画できる
+	/// ページに入らない大きさの画像はCreateTexと同じく単体のテクスチャとして作成する
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャにつける名前</param>
+	/// <param name="pTexPath">[in]画像のパス</param>
+	inline void CreateAtlasTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
 	{
-		if (Exists(pTexKey)) return;
+		if (m_texAtlas.Add(pTexKey, pTexPath)) return;
 
-		D3DXCreateTextureFromFile(
-			m_pDX_GRAPHIC_DEVICE, 
-			pTexPath, 
-			&m_pTexMap[pTexKey]);
+		CreateTex(pTexKey, pTexPath);
 	}
 
-	/**
-	* @brief 全てのテクスチャの開放
-	*/
-	inline void AllRelease()
+	/// <summary>
+	/// CreateAtlasTexで作成したテクスチャとその中での画像の座標を取得する
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャを作るときに決めた名前</param>
+	/// <returns>
+	/// テクスチャと座標 単体のテクスチャとして作成された場合は座標はテクスチャ全体になる
+	/// 作成されていない場合テクスチャはnullptr
+	/// </returns>
+	inline AtlasTex GetAtlasTex(const TCHAR* pTexKey)
 	{
-		for (auto i : m_pTexMap)
-		{
-			if (!i.second) continue;
+		AtlasTex atlasTex;
+
+		if (m_texAtlas.Get(pTexKey, &atlasTex)) return atlasTex;
+
+		atlasTex.m_pTexture = GetTex(pTexKey);
+
+		return atlasTex;
+	}
 
-			(i.second)->Release();
-		}
+	/// <summary>
+	/// アトラスのページと画像の座標の表を書き出す
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]書き出すファイルのパスの先頭 ページは(先頭)(番号).png,表は(先頭).txtになる</param>
+	/// <returns>書き出せなかった場合false</returns>
+	inline bool SaveAtlas(const TCHAR* pFilePathPrefix) const
+	{
+		return m_texAtlas.Save(pFilePathPrefix);
+	}
 
-		m_pTexMap.clear();
+	/// <summary>
+	/// SaveAtlasで書き出したページと表を読み込む 読み込んだ画像はGetAtlasTexで取得できる
+	/// </summary>
+	/// <param name="pFilePathPrefix">[in]SaveAtlasに渡したファイルのパスの先頭</param>
+	/// <returns>読み込めなかった場合false</returns>
+	inline bool LoadAtlas(const TCHAR* pFilePathPrefix)
+	{
+		return m_texAtlas.Load(pFilePathPrefix);
 	}
 
 	/// <summary>
-	/// 指定したテクスチャの開放を行う
+	/// 指定したテクスチャの開放を行う テクスチャを指していたハンドルは何も指さなくなる
 	/// </summary>
 	/// <param name="pTexKey">[in]開放したいテクスチャのパス</param>
-	inline void Release(const TCHAR* pTexKey)
+	void Release(const TCHAR* pTexKey);
+
+	/// <summary>
+	/// テクスチャのハンドルを取得する 毎フレーム描画するものは一度取得したハンドルを使い続ける
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャを作るときに決めたキー</param>
+	/// <returns>作成されていない場合何も指さない</returns>
+	inline TexHandle GetTexHandle(const TCHAR* pTexKey) const
 	{
-		if (!Exists(pTexKey)) return;
+		if (!pTexKey) return TexHandle();
+
+		auto texHandle = m_texHandles.find(pTexKey);
 
-		m_pTexMap[pTexKey]->Release();
-		m_pTexMap.erase(pTexKey);
+		if (texHandle == m_texHandles.end()) return TexHandle();
+
+		return texHandle->second;
+	}
+
+	/// <summary>
+	/// ハンドルの指すテクスチャを取得する 配列の添え字を引くだけなので毎フレーム呼んでよい
+	/// </summary>
+	/// <returns>何も指さないか,指していたテクスチャが開放されている場合nullptr</returns>
+	inline const LPDIRECT3DTEXTURE9 GetTex(TexHandle texHandle) const
+	{
+		UINT index = texHandle.GetIndex();
+
+		if (index >= m_texSlots.size()) return nullptr;
+
+		const TexSlot& rTexSlot = m_texSlots[index];
+
+		if (rTexSlot.m_generation != texHandle.GetGeneration()) return nullptr;
+
+		return rTexSlot.m_pTexture;
 	}
 
 	/**
 	* @brief テクスチャを取得する
 	* @param pTexKey テクスチャを作るときに決めたキーのポインタ
-	* @return テクスチャのポインタ
+	* @return テクスチャのポインタ 作成されていない場合nullptr
 	*/
-	inline const LPDIRECT3DTEXTURE9 GetTex(const TCHAR* pTexKey)
+	inline const LPDIRECT3DTEXTURE9 GetTex(const TCHAR* pTexKey) const
 	{
-		return m_pTexMap[pTexKey];
+		return GetTex(GetTexHandle(pTexKey));
 	}
 
 	/**
@@ -84,13 +202,36 @@ public:
 	*/
 	inline const bool Exists(const TCHAR* pTexKey) const
 	{
-		return (m_pTexMap.find(pTexKey) != m_pTexMap.end());
+		return !GetTexHandle(pTexKey).IsNull();
 	}
 
 private:
+	struct TexSlot
+	{
+	public:
+		//! 空いている枠はnullptr
+		LPDIRECT3DTEXTURE9 m_pTexture = nullptr;
+
+		//! テクスチャを開放するたびに増やし,古いハンドルを無効にする
+		UINT m_generation = 1;
+	};
+
+	/// <summary>
+	/// 枠のテクスチャを開放し,枠を空ける
+	/// </summary>
+	void ReleaseSlot(UINT index);
+
 	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
 
-	std::map<const TCHAR*, LPDIRECT3DTEXTURE9> m_pTexMap;
+	//! キーは文字列の中身で比べる
+	std::map<std::basic_string<TCHAR>, TexHandle> m_texHandles;
+
+	//! ハンドルの添え字で引く 枠は開放しても詰めない
+	std::vector<TexSlot> m_texSlots;
+
+	std::vector<UINT> m_freeSlotIndices;
+
+	TexAtlas m_texAtlas;
 };
 
 #endif //! TEX_STORAGE_H
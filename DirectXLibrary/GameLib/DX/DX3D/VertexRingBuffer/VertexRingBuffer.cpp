@@ -0,0 +1,97 @@
+﻿/// <filename>
+/// VertexRingBuffer.cpp
+/// </filename>
+/// <summary>
+/// 使いまわす動的頂点バッファのソース
+/// </summary>
+
+#include "VertexRingBuffer.h"
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+VertexRingBuffer::VertexRingBuffer(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache, UINT bufferBytes)
+	:m_pDX_GRAPHIC_DEVICE(dXGraphicDevice), m_pRenderStateCache(pRenderStateCache), m_BUFFER_BYTES(bufferBytes)
+{
+	Create();
+}
+
+void VertexRingBuffer::Create()
+{
+	if (m_pVertexBuffer) return;
+
+	//! 様々な頂点の形式で使いまわすのでFVFは指定しない
+	if (FAILED(m_pDX_GRAPHIC_DEVICE->CreateVertexBuffer(
+		m_BUFFER_BYTES,
+		D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY,
+		0,
+		D3DPOOL_DEFAULT,
+		&m_pVertexBuffer,
+		NULL)))
+	{
+		m_pVertexBuffer = nullptr;
+
+		return;
+	}
+
+	m_offset		= 0;
+	m_needsDiscard	= true;
+}
+
+void VertexRingBuffer::Release()
+{
+	if (!m_pVertexBuffer) return;
+
+	m_pRenderStateCache->UnbindStreamSource(m_pVertexBuffer);
+
+	m_pVertexBuffer->Release();
+	m_pVertexBuffer = nullptr;
+}
+
+void* VertexRingBuffer::Lock(UINT verticesNum, UINT stride, UINT* pStartVertex)
+{
+	UINT bytes = verticesNum * stride;
+
+	if (!m_pVertexBuffer || bytes == 0 || bytes > m_BUFFER_BYTES) return nullptr;
+
+	//! 開始頂点の番号で位置を指定するので頂点の大きさの倍数にそろえる
+	UINT offset = (m_offset + stride - 1) / stride * stride;
+
+	DWORD lockFlags = D3DLOCK_NOOVERWRITE;
+
+	if (m_needsDiscard || offset + bytes > m_BUFFER_BYTES)
+	{
+		if (!m_needsDiscard) ++m_stats.m_wrapsNum;
+
+		offset		= 0;
+		lockFlags	= D3DLOCK_DISCARD;
+
+		m_needsDiscard = false;
+	}
+
+	void* pVertices = nullptr;
+
+	if (FAILED(m_pVertexBuffer->Lock(offset, bytes, &pVertices, lockFlags))) return nullptr;
+
+	m_offset = offset + bytes;
+
+	*pStartVertex = offset / stride;
+
+	++m_stats.m_allocationsNum;
+	m_stats.m_allocatedBytes += bytes;
+
+	return pVertices;
+}
+
+void VertexRingBuffer::Unlock()
+{
+	m_pVertexBuffer->Unlock();
+}
+
+void VertexRingBuffer::SetStreamSource(UINT stride) const
+{
+	m_pRenderStateCache->SetStreamSource(m_pVertexBuffer, stride);
+}
@@ -0,0 +1,119 @@
+﻿/// <filename>
+/// VertexRingBuffer.h
+/// </filename>
+/// <summary>
+/// 使いまわす動的頂点バッファのヘッダ
+/// </summary>
+
+#ifndef VERTEX_RING_BUFFER_H
+#define VERTEX_RING_BUFFER_H
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "DX\DX3D\RenderStateCache\RenderStateCache.h"
+
+/// <summary>
+/// 頂点バッファの確保の回数などの統計
+/// </summary>
+struct VertexRingBufferStats
+{
+public:
+	//! Lockで領域を確保した回数
+	UINT m_allocationsNum = 0;
+
+	//! 末尾に達しDISCARDで先頭から確保しなおした回数
+	UINT m_wrapsNum = 0;
+
+	//! Lockで確保したバイト数の合計
+	UINT64 m_allocatedBytes = 0;
+};
+
+/// <summary>
+/// D3DPOOL_DEFAULTの動的頂点バッファを一つ持ち,描画ごとに領域を前から順に貸し出すクラス
+/// </summary>
+/// <remarks>
+/// 末尾に達するまではD3DLOCK_NOOVERWRITEで書き込み,GPUが使用中の領域を上書きしない
+/// 末尾に達した場合はD3DLOCK_DISCARDで新しい領域を受け取り先頭から確保しなおす
+/// D3DPOOL_DEFAULTなのでデバイスのReset前にRelease,Reset後にCreateを呼ばなければならない
+/// </remarks>
+class VertexRingBuffer
+{
+public:
+	/// <param name="dXGraphicDevice">デバイス</param>
+	/// <param name="pRenderStateCache">ストリームの設定に用いる</param>
+	/// <param name="bufferBytes">頂点バッファの大きさ(バイト)</param>
+	VertexRingBuffer(const LPDIRECT3DDEVICE9 dXGraphicDevice, RenderStateCache* pRenderStateCache, UINT bufferBytes = m_DEFAULT_BUFFER_BYTES);
+	~VertexRingBuffer()
+	{
+		Release();
+	}
+
+	/// <summary>
+	/// 頂点バッファを作成する 作成済みの場合は何もしない
+	/// </summary>
+	void Create();
+
+	/// <summary>
+	/// 頂点バッファを開放する ストリームに設定されている場合は外してから開放する
+	/// </summary>
+	void Release();
+
+	/// <summary>
+	/// 引数の頂点数分の領域を確保しロックする 書き込み後は必ずUnlockを呼ぶ
+	/// </summary>
+	/// <param name="verticesNum">確保する頂点の数</param>
+	/// <param name="stride">頂点一つのバイト数</param>
+	/// <param name="pStartVertex">[out]DrawPrimitiveに渡す開始頂点の番号</param>
+	/// <returns>書き込み先のポインタ バッファより大きい,もしくはバッファがない場合はnullptr</returns>
+	void* Lock(UINT verticesNum, UINT stride, UINT* pStartVertex);
+
+	/// <summary>
+	/// Lockした領域のロックを解除する
+	/// </summary>
+	void Unlock();
+
+	/// <summary>
+	/// 頂点バッファをストリーム0に設定する
+	/// </summary>
+	/// <param name="stride">頂点一つのバイト数 Lockで渡したものと同じもの</param>
+	void SetStreamSource(UINT stride) const;
+
+	/// <summary>
+	/// 確保の回数などの統計を取得する
+	/// </summary>
+	inline const VertexRingBufferStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+	/// <summary>
+	/// 統計を0にする
+	/// </summary>
+	inline void ResetStats()
+	{
+		m_stats = VertexRingBufferStats();
+	}
+
+private:
+	static const UINT m_DEFAULT_BUFFER_BYTES = 4 * 1024 * 1024;
+
+	const LPDIRECT3DDEVICE9 m_pDX_GRAPHIC_DEVICE = nullptr;
+
+	RenderStateCache* m_pRenderStateCache = nullptr;
+
+	const UINT m_BUFFER_BYTES = 0;
+
+	LPDIRECT3DVERTEXBUFFER9 m_pVertexBuffer = nullptr;
+
+	//! 次に確保を始める位置(バイト)
+	UINT m_offset = 0;
+
+	//! 作成直後の最初のロックはDISCARDで行う
+	bool m_needsDiscard = true;
+
+	VertexRingBufferStats m_stats;
+};
+
+#endif //! VERTEX_RING_BUFFER_H
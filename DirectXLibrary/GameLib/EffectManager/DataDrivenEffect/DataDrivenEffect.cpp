@@ -0,0 +1,176 @@
+﻿/// <filename>
+/// DataDrivenEffect.cpp
+/// </filename>
+/// <summary>
+/// ファイルから読み込んだ設定で動くエフェクトのソース
+/// </summary>
+
+#include "DataDrivenEffect.h"
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "EffectManager\Effect\Effect.h"
+#include "EffectManager\EffectDesc\EffectDesc.h"
+
+DataDrivenEffect::DataDrivenEffect(const EffectDesc* pEffectDesc, const D3DXVECTOR3& center)
+	:Effect(pEffectDesc->m_particlesNum, pEffectDesc->GetTexPath(), pEffectDesc->m_activeCount), m_pEFFECT_DESC(pEffectDesc)
+{
+	Reset(pEffectDesc, center);
+}
+
+void DataDrivenEffect::Reset(const EffectDesc* pEffectDesc, const D3DXVECTOR3& center)
+{
+	//! プールは設定ごとに分かれているので,pEffectDescはコンストラクタで受け取ったものと同じ
+	m_center = center;
+
+	Restart();
+
+	RunEmitModules(0, GetParticlesNum());
+}
+
+void DataDrivenEffect::Update()
+{
+	InitActivatedParticle();
+
+	if (!RunUpdateModules()) return;
+
+	UpdateParticles();
+}
+
+void DataDrivenEffect::RunEmitModules(UINT begin, UINT end)
+{
+	for (const auto& rEffectModule : m_pEFFECT_DESC->m_emitModules)
+	{
+		const float* pParams = rEffectModule.m_params;
+
+		switch (rEffectModule.m_type)
+		{
+		case EffectModule::SHAPE:
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).FormatShape(D3DXVECTOR2(pParams[0], pParams[1]), pParams[2]);
+			}
+
+			break;
+
+		case EffectModule::COLOR:
+		{
+			DWORD aRGB = D3DCOLOR_ARGB(
+				static_cast<DWORD>(pParams[0]), static_cast<DWORD>(pParams[1]),
+				static_cast<DWORD>(pParams[2]), static_cast<DWORD>(pParams[3]));
+
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).SetColor(aRGB);
+			}
+
+			break;
+		}
+
+		case EffectModule::CENTER:
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).FormatCenter(m_center, pParams[0]);
+			}
+
+			break;
+
+		case EffectModule::RING_CENTER:
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).FormatCenter(m_center, pParams[0], pParams[1]);
+			}
+
+			break;
+
+		case EffectModule::VELOCITY:
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).FormatInitialVelocity(pParams[0], pParams[1], pParams[2]);
+			}
+
+			break;
+
+		case EffectModule::RADIATION_VELOCITY:
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).FormatRadiationInitialVelocity(pParams[0], pParams[1]);
+			}
+
+			break;
+
+		case EffectModule::ABSORPTION_VELOCITY:
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).FormatAbsorptionInitialVelocity(pParams[0], pParams[1]);
+			}
+
+			break;
+
+		case EffectModule::ACCELERATE:
+			for (UINT i = begin; i < end; ++i)
+			{
+				GetParticle(i).Accelarate(D3DXVECTOR2(pParams[0], pParams[1]));
+			}
+
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+bool DataDrivenEffect::RunUpdateModules()
+{
+	for (const auto& rEffectModule : m_pEFFECT_DESC->m_updateModules)
+	{
+		const float* pParams = rEffectModule.m_params;
+
+		switch (rEffectModule.m_type)
+		{
+		case EffectModule::END_AFTER:
+			if (GetMaxLifeFrame() <= static_cast<int>(pParams[0])) break;
+
+			m_ends = true;
+
+			return false;
+
+		case EffectModule::FADE_IN:
+			FadeInParticles(static_cast<int>(pParams[0]), static_cast<int>(pParams[1]));
+
+			break;
+
+		case EffectModule::FADE_OUT:
+			FadeOutParticles(static_cast<int>(pParams[0]), static_cast<int>(pParams[1]));
+
+			break;
+
+		case EffectModule::ROTATE:
+			RotateParticles(RotateValueXYZ(pParams[0], pParams[1], pParams[2]));
+
+			break;
+
+		case EffectModule::ACCELERATE:
+			AccelerateParticles(D3DXVECTOR2(pParams[0], pParams[1]));
+
+			break;
+
+		case EffectModule::CIRCULATION_Z:
+			//! 回転量に乱数を使うのでパーティクルごとに処理する
+			for (UINT i = 0; i < GetParticlesNum(); ++i)
+			{
+				GetParticle(i).CirculationZ(pParams[0], pParams[1]);
+			}
+
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return true;
+}
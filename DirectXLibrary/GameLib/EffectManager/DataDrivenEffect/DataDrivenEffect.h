@@ -0,0 +1,66 @@
+﻿/// <filename>
+/// DataDrivenEffect.h
+/// </filename>
+/// <summary>
+/// ファイルから読み込んだ設定で動くエフェクトのヘッダ
+/// </summary>
+
+#ifndef DATA_DRIVEN_EFFECT_H
+#define DATA_DRIVEN_EFFECT_H
+
+#include <Windows.h>
+
+#include <d3dx9.h>
+
+#include "EffectManager\Effect\Effect.h"
+#include "EffectManager\EffectDesc\EffectDesc.h"
+
+/// <summary>
+/// EffectDescの処理を先頭から順に全てのパーティクルに対して行うエフェクト
+/// </summary>
+/// <remarks>
+/// 処理ごとに全てのパーティクルをまとめて扱うので,パーティクルごとに仮想関数を呼ぶことはない
+/// 設定ごとにプールが分かれているので,使いまわされる際も同じ設定が渡される
+/// </remarks>
+class DataDrivenEffect :public Effect
+{
+public:
+	/// <param name="pEffectDesc">[in]EffectDescStorageが保持している設定 エフェクトより長く存在しなければならない</param>
+	/// <param name="center">パーティクルを出現させる位置</param>
+	DataDrivenEffect(const EffectDesc* pEffectDesc, const D3DXVECTOR3& center);
+
+	~DataDrivenEffect() {};
+
+	/// <summary>
+	/// EffectManagerのプールで使いまわされる際に呼ばれる
+	/// </summary>
+	void Reset(const EffectDesc* pEffectDesc, const D3DXVECTOR3& center);
+
+	void Update();
+
+protected:
+	inline void Init(Particle particle)
+	{
+		UINT index = particle.GetIndex();
+
+		RunEmitModules(index, index + 1);
+	}
+
+private:
+	/// <summary>
+	/// 添え字がbegin以上end未満のパーティクルに増えたときの処理を行う
+	/// </summary>
+	void RunEmitModules(UINT begin, UINT end);
+
+	/// <summary>
+	/// 毎フレームの処理を行う
+	/// </summary>
+	/// <returns>エフェクトが終了した場合false</returns>
+	bool RunUpdateModules();
+
+	const EffectDesc* const m_pEFFECT_DESC = nullptr;
+
+	D3DXVECTOR3 m_center;
+};
+
+#endif //! DATA_DRIVEN_EFFECT_H
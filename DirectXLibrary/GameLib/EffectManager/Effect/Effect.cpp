@@ -9,59 +9,224 @@
 
 #include <Windows.h>
 
-#include <d3dx9.h>
-
 #include <vector>
+#include <climits>
+#include <cstring>
+#include <random>
+
+#include <d3dx9.h>
 
 #include "IGameLibRenderer\IGameLibRenderer.h"
 #include "Particle/Particle.h"
+#include "ParticleStorage/ParticleStorage.h"
+#include "EffectManager\ParticleStoragePool\ParticleStoragePool.h"
+#include "EffectManager\ParticleCollisionWorld\ParticleCollisionWorld.h"
 #include "Algorithm\Algorithm.h"
+#include "VerticesParam.h"
 
 IGameLibRenderer* Effect::m_pIGameLibRenderer = nullptr;
 
-void Effect::Render()
+ParticleStoragePool* Effect::m_pParticleStoragePool = nullptr;
+
+const ParticleCollisionWorld* Effect::m_pParticleCollisionWorld = nullptr;
+
+const char Effect::m_SNAPSHOT_MAGIC[4] = { 'E', 'F', 'X', 'S' };
+
+Effect::Effect(size_t particlesNum, const TCHAR* pTexPath, int activeCount)
+	:m_PARTICLES_MAX(static_cast<UINT>(particlesNum)), m_pTexName(pTexPath), m_COUNT_TO_ACTIVE_MAX(activeCount)
 {
-	m_pIGameLibRenderer->AddtionBlendMode();
+	if (m_pParticleStoragePool)
+	{
+		m_pParticleStorage = m_pParticleStoragePool->Acquire(m_PARTICLES_MAX);
+	}
+	else
+	{
+		m_pParticleStorage = new ParticleStorage(m_PARTICLES_MAX);
+
+		std::random_device randDevForSeed;
+		m_pParticleStorage->Seed(randDevForSeed());
+	}
+
+	Restart();
+}
 
-	for (int i = 0; i < m_particles.size(); ++i)
+Effect::~Effect()
+{
+	if (m_pParticleStoragePool)
 	{
-		if (i > m_activeLimit) continue;
+		m_pParticleStoragePool->Release(m_pParticleStorage);
 
-		m_particles[i]->Render();
+		return;
 	}
 
-	m_pIGameLibRenderer->DefaultBlendMode();
+	delete m_pParticleStorage;
+}
+
+void Effect::Step()
+{
+	m_pParticleStorage->SaveRenderState();
+
+	//! 更新を飛ばした場合も状態を保持しなおし,補間で前回の動きを繰り返さないようにする
+	//! パーティクルを増やすカウントも止めて,増やす間隔を延ばす
+	if (m_skipsUpdate) return;
+
+	Update();
 
 	CountUpActiveLimit();
 }
 
-void Effect::CountUpActiveLimit()
+void Effect::FastForward(UINT stepsNum)
 {
-	//! m_COUNT_TO_ACTIVE_MAXが0の場合全てのパーティクルをアクティベートする
-	if (m_COUNT_TO_ACTIVE_MAX == 0)
+	for (UINT i = 0; i < stepsNum; ++i)
 	{
-		m_activeLimit = static_cast<int>(m_particles.size());
+		if (m_ends) break;
 
-		return;
+		Update();
+
+		CountUpActiveLimit();
 	}
 
-	auto CountActivelimitUp = [this]() {++m_activeLimit; };
-	Algorithm::CountUp(&m_countToActive, m_COUNT_TO_ACTIVE_MAX - 1, CountActivelimitUp);
+	//! 進めた後の状態から補間せずに描画する
+	m_pParticleStorage->SaveRenderState();
+}
+
+void Effect::SaveSnapshot(std::vector<BYTE>* pBytes) const
+{
+	SnapshotHeader header;
+	memcpy(header.m_magic, m_SNAPSHOT_MAGIC, sizeof(m_SNAPSHOT_MAGIC));
+	header.m_version		= m_SNAPSHOT_VERSION;
+	header.m_particlesMax	= m_PARTICLES_MAX;
+	header.m_countToActive	= m_countToActive;
 
-	int particleSize = static_cast<int>(m_particles.size());
+	pBytes->resize(sizeof(header));
+	memcpy(pBytes->data(), &header, sizeof(header));
 
-	if (m_activeLimit >= particleSize) m_activeLimit = particleSize;
+	m_pParticleStorage->WriteState(pBytes);
 }
 
-void Effect::InitActivatedParticle()
+bool Effect::LoadSnapshot(const BYTE* pBytes, size_t bytesSize)
 {
-	for (int i = 0; i < m_particles.size(); ++i)
+	SnapshotHeader header;
+
+	if (!pBytes || bytesSize < sizeof(header)) return false;
+
+	memcpy(&header, pBytes, sizeof(header));
+
+	if (memcmp(header.m_magic, m_SNAPSHOT_MAGIC, sizeof(m_SNAPSHOT_MAGIC)) != 0 || header.m_version != m_SNAPSHOT_VERSION) return false;
+
+	//! 別の種類のエフェクトの状態を読み込まないよう最大数だけは確かめる
+	if (header.m_particlesMax != m_PARTICLES_MAX) return false;
+
+	if (header.m_countToActive < 0 || (m_COUNT_TO_ACTIVE_MAX != 0 && header.m_countToActive >= m_COUNT_TO_ACTIVE_MAX)) return false;
+
+	if (!m_pParticleStorage->ReadState(pBytes + sizeof(header), bytesSize - sizeof(header), m_PARTICLES_MAX)) return false;
+
+	m_countToActive = header.m_countToActive;
+	m_ends			= false;
+
+	return true;
+}
+
+void Effect::Render(float interpolation)
+{
+	const LPDIRECT3DTEXTURE9 pTexture = m_pIGameLibRenderer->GetTex(m_texHandle);
+
+	VerticesParam verticesParam;
+
+	//! 色の合成の切り替えはRenderQueueが並べ替えた後にまとめて行う
+	for (UINT i = 0; i < m_pParticleStorage->GetAliveNum(); ++i)
 	{
-		if (i == m_activeLimit && m_countToActive == 0 && m_COUNT_TO_ACTIVE_MAX != 0)
-		{
-			Init(m_particles[i]);
+		GetParticle(i).GetVerticesParam(&verticesParam, interpolation);
 
-			break;
-		}
+		m_pIGameLibRenderer->Submit(verticesParam, pTexture, ColorBlender::BLEND_MODE::ADDITION, m_layer);
 	}
 }
+
+void Effect::Restart()
+{
+	m_pParticleStorage->Clear();
+
+	m_countToActive = 0;
+	m_ends = false;
+	m_layer = 0;
+
+	//! 優先度と最低限の数は種類ごとに設定するものなので,プールで使いまわしても保持する
+	m_particlesBudget	= UINT_MAX;
+	m_skipsUpdate		= false;
+	m_collides			= false;
+
+	//! テクスチャは全てのパーティクルで共通なのでエフェクトで一度だけ作る
+	//! プールにある間にテクスチャが開放されていても作り直されるよう,使いまわすたびに取得する
+	if (m_pTexName) m_texHandle = m_pIGameLibRenderer->CreateTex(m_pTexName, m_pTexName);
+
+	//! m_COUNT_TO_ACTIVE_MAXが0の場合全てのパーティクルを初めから存在させる
+	if (m_COUNT_TO_ACTIVE_MAX != 0) return;
+
+	UINT index = 0;
+
+	while (Emit(&index));
+}
+
+UINT Effect::GetRequestedParticlesNum() const
+{
+	UINT aliveNum = m_pParticleStorage->GetAliveNum();
+
+	//! 存在している数だけを求めると,割り当てが足りた途端に増えて超えるのを繰り返すので一つずつ増やさせる
+	bool isEmissionBlocked = (m_particlesBudget != UINT_MAX && m_COUNT_TO_ACTIVE_MAX != 0 && aliveNum < m_PARTICLES_MAX);
+
+	return (isEmissionBlocked) ? aliveNum + 1 : aliveNum;
+}
+
+UINT Effect::ApplyParticlesBudget(UINT particlesBudget)
+{
+	if (particlesBudget >= GetRequestedParticlesNum())
+	{
+		m_particlesBudget	= UINT_MAX;
+		m_skipsUpdate		= false;
+
+		return 0;
+	}
+
+	m_particlesBudget = particlesBudget;
+
+	//! 足りない間は1フレームおきに更新する
+	m_skipsUpdate = !m_skipsUpdate;
+
+	UINT aliveNum = m_pParticleStorage->GetAliveNum();
+
+	if (particlesBudget >= aliveNum) return 0;
+
+	UINT killsNum = aliveNum - particlesBudget;
+
+	m_pParticleStorage->KillOldest(killsNum);
+
+	return killsNum;
+}
+
+void Effect::CountUpActiveLimit()
+{
+	//! m_COUNT_TO_ACTIVE_MAXが0の場合全てのパーティクルが初めから存在している
+	if (m_COUNT_TO_ACTIVE_MAX == 0) return;
+
+	Algorithm::CountUp(&m_countToActive, m_COUNT_TO_ACTIVE_MAX - 1);
+}
+
+void Effect::InitActivatedParticle()
+{
+	if (m_COUNT_TO_ACTIVE_MAX == 0 || m_countToActive != 0) return;
+
+	UINT index = 0;
+
+	if (!Emit(&index)) return;
+
+	Init(GetParticle(index));
+}
+
+bool Effect::Emit(UINT* pIndex)
+{
+	UINT aliveNum = m_pParticleStorage->GetAliveNum();
+
+	if (aliveNum >= m_PARTICLES_MAX || aliveNum >= m_particlesBudget) return false;
+
+	return m_pParticleStorage->Emit(pIndex);
+}
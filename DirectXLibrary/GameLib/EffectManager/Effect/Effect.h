@@ -10,41 +10,32 @@
 
 #include <Windows.h>
 
-#include <d3dx9.h>
-
 #include <vector>
+#include <climits>
+
+#include <d3dx9.h>
 
 #include "Particle/Particle.h"
+#include "ParticleStorage/ParticleStorage.h"
+#include "EffectManager\ParticleStoragePool\ParticleStoragePool.h"
+#include "EffectManager\ParticleCollisionWorld\ParticleCollisionWorld.h"
 #include "Algorithm\Algorithm.h"
 #include "IGameLibRenderer\IGameLibRenderer.h"
 
 /// <summary>
 /// エフェクト基底クラス
 /// </summary>
+/// <remarks>
+/// パーティクルの状態は要素ごとの配列で持ち,その配列はEffectManagerが使いまわす
+/// 乱数はエフェクトごとに一つで,全てのパーティクルで共有する
+/// </remarks>
 class Effect
 {
 public:
 	//! activeCountを2にすると2フレームに一つずつパーティクルが増えていく
-	Effect(size_t particlesNum, const TCHAR* pTexPath, int activeCount) :m_COUNT_TO_ACTIVE_MAX(activeCount)
-	{
-		m_particles.resize(particlesNum);
+	Effect(size_t particlesNum, const TCHAR* pTexPath, int activeCount);
 
-		for (auto& i : m_particles)
-		{
-			i = new Particle(pTexPath);
-		}
-	}
-
-	virtual ~Effect() 
-	{
-		for (auto i : m_particles)
-		{
-			delete i;
-		}
-
-		m_particles.clear();
-		m_particles.shrink_to_fit();
-	}
+	virtual ~Effect();
 
 	/// <summary>
 	/// EffectManagerで入れる
@@ -54,16 +45,84 @@ public:
 	static inline void SetGameLibRenderer(IGameLibRenderer* pIGameLibRenderer)
 	{
 		m_pIGameLibRenderer = pIGameLibRenderer;
+	}
 
-		Particle::SetGameLibRenderer(pIGameLibRenderer);
+	/// <summary>
+	/// EffectManagerで入れる
+	/// パーティクルの配列の取得と返却に用いる nullptrの場合はエフェクトごとに作成し開放する
+	/// </summary>
+	static inline void SetParticleStoragePool(ParticleStoragePool* pParticleStoragePool)
+	{
+		m_pParticleStoragePool = pParticleStoragePool;
+	}
+
+	/// <summary>
+	/// EffectManagerで入れる
+	/// SetCollidesでtrueにしたエフェクトのパーティクルと判定する nullptrの場合は判定しない
+	/// </summary>
+	static inline void SetParticleCollisionWorld(const ParticleCollisionWorld* pParticleCollisionWorld)
+	{
+		m_pParticleCollisionWorld = pParticleCollisionWorld;
 	}
 
+	/// <summary>
+	/// EffectManager::SetUpdatesInParallelでtrueにした場合は他のエフェクトと並列に呼ばれる
+	/// </summary>
+	/// <remarks>
+	/// 並列に更新させるエフェクトは,エフェクトの外の状態を書き換えたり描画やデバイスに触れたりしてはいけない
+	/// 乱数はrand()ではなくGetRandEngineを使う rand()の状態はスレッドごとなので結果が再現しなくなる
+	/// </remarks>
 	virtual inline void Update() = 0;
 
 	/// <summary>
-	/// パーティクルの描画
+	/// 固定の間隔で一回分シミュレーションを進める EffectManager::SetUpdatesInParallelでtrueにした場合は並列に呼ばれる
+	/// 描画の補間に用いる状態を保持してからUpdateを呼び,パーティクルを増やすカウントをとる
+	/// </summary>
+	/// <remarks>
+	/// Updateやパーティクルの生存時間のフレームはこの一回を指すので,描画の頻度によらず同じ結果になる
+	/// </remarks>
+	void Step();
+
+	/// <summary>
+	/// 描画せずにシミュレーションを進める 出現させた直後から画面を満たした状態にするのに用いる
+	/// </summary>
+	/// <param name="stepsNum">Stepを呼ぶ回数 途中でエフェクトが終了した場合はそこで止める</param>
+	/// <remarks>
+	/// 描画命令を積まず補間のための状態も保持しないので,同じ回数フレームを回すよりはるかに軽い
+	/// </remarks>
+	void FastForward(UINT stepsNum);
+
+	/// <summary>
+	/// パーティクルの状態をバイト列に書き出す LoadSnapshotで同じ種類のエフェクトに読み込める
+	/// </summary>
+	/// <param name="pBytes">[out]書き出したバイト列 元の中身は消す</param>
+	/// <remarks>
+	/// 派生クラスのメンバと乱数の状態は含まない
+	/// </remarks>
+	void SaveSnapshot(std::vector<BYTE>* pBytes) const;
+
+	/// <summary>
+	/// SaveSnapshotで書き出した状態にする 十分進めた状態を保存しておけば,FastForwardより更に軽く画面を満たせる
 	/// </summary>
-	void Render();
+	/// <param name="pBytes">[in]SaveSnapshotで書き出したバイト列の先頭</param>
+	/// <param name="bytesSize">バイト列の大きさ</param>
+	/// <returns>書式が誤っているかパーティクルの最大数が異なる場合false その場合は何も変えない</returns>
+	bool LoadSnapshot(const BYTE* pBytes, size_t bytesSize);
+
+	/// <summary>
+	/// パーティクルを加算合成で描画命令として積む
+	/// </summary>
+	/// <param name="interpolation">直前のStepの前後の状態の間の位置 0~1 1なら現在の状態をそのまま描画する</param>
+	void Render(float interpolation = 1.0f);
+
+	/// <summary>
+	/// 描画する層を変更する 大きいほど後に描画される
+	/// </summary>
+	/// <param name="layer">描画する層</param>
+	inline void SetLayer(BYTE layer)
+	{
+		m_layer = layer;
+	}
 
 	/// <summary>
 	/// エフェクトが終了しているかどうか
@@ -74,28 +133,262 @@ public:
 		return m_ends;
 	}
 
+	/// <summary>
+	/// エフェクトを終了させる
+	/// </summary>
+	inline void End()
+	{
+		m_ends = true;
+	}
+
+	/// <summary>
+	/// trueにするとUpdateParticlesで中心を動かした後に,EffectManagerに登録した動かない物体と衝突させる
+	/// </summary>
+	inline void SetCollides(bool collides)
+	{
+		m_collides = collides;
+	}
+
+	inline bool Collides() const
+	{
+		return m_collides;
+	}
+
+	/// <summary>
+	/// パーティクルの総数が上限を超えた際に,優先度の高いエフェクトから数を割り当てる
+	/// Restartでは戻さないので,プールで使いまわされても設定したままになる
+	/// </summary>
+	/// <param name="priority">優先度 大きいほど優先される 同じ優先度では先に追加したものが優先される</param>
+	inline void SetPriority(BYTE priority)
+	{
+		m_priority = priority;
+	}
+
+	inline BYTE GetPriority() const
+	{
+		return m_priority;
+	}
+
+	/// <summary>
+	/// パーティクルの総数が上限を超えていても,優先度の順に上限に収まる限り割り当てる数
+	/// Restartでは戻さないので,プールで使いまわされても設定したままになる
+	/// </summary>
+	inline void SetMinParticlesNum(UINT minParticlesNum)
+	{
+		m_minParticlesNum = minParticlesNum;
+	}
+
+	inline UINT GetMinParticlesNum() const
+	{
+		return m_minParticlesNum;
+	}
+
+	inline UINT GetAliveParticlesNum() const
+	{
+		return m_pParticleStorage->GetAliveNum();
+	}
+
+	/// <summary>
+	/// このフレームに存在させたいパーティクルの数
+	/// 割り当てが足りずパーティクルを増やせずにいる場合は,一つ増やした数になる
+	/// </summary>
+	UINT GetRequestedParticlesNum() const;
+
+	/// <summary>
+	/// EffectManagerが更新の前に毎フレーム呼ぶ
+	/// 割り当てを超えている分は古いパーティクルから消し,
+	/// 割り当てが足りない間は更新とパーティクルを増やす間隔を1フレームおきにする
+	/// </summary>
+	/// <param name="particlesBudget">このフレームに存在してよいパーティクルの数 GetRequestedParticlesNum以上なら足りている</param>
+	/// <returns>消したパーティクルの数</returns>
+	UINT ApplyParticlesBudget(UINT particlesBudget);
+
+	/// <summary>
+	/// 割り当てが足りず,このフレームの更新を飛ばすか
+	/// </summary>
+	inline bool SkipsUpdate() const
+	{
+		return m_skipsUpdate;
+	}
+
 protected:
+	/// <summary>
+	/// パーティクルを全て消し,作成直後の状態に戻す
+	/// EffectPoolで使いまわす際に派生クラスのResetから呼ぶ
+	/// 優先度と最低限の数は戻さない
+	/// </summary>
+	void Restart();
+
 	/// <summary>
 	/// カウントをとりパーティクルをアクティブ状態にする
 	/// </summary>
 	void CountUpActiveLimit();
 
 	/// <summary>
-	/// アクティブになっているパーティクルを初期化する
+	/// アクティブにする番であればパーティクルを一つ増やして初期化する
 	/// </summary>
 	void InitActivatedParticle();
 
-	virtual void Init(Particle* pParticle) = 0;
+	virtual void Init(Particle particle) = 0;
+
+	/// <summary>
+	/// パーティクルを一つ増やす
+	/// </summary>
+	/// <param name="pIndex">[out]増やしたパーティクルの添え字</param>
+	/// <returns>最大数に達していて増やせない場合false</returns>
+	bool Emit(UINT* pIndex);
+
+	/// <summary>
+	/// パーティクルを消す 末尾のパーティクルが引数の添え字に移るので,
+	/// 走査中に消す場合は同じ添え字をもう一度処理する
+	/// </summary>
+	inline void Kill(UINT index)
+	{
+		m_pParticleStorage->Kill(index);
+	}
+
+	inline Particle GetParticle(UINT index)
+	{
+		return Particle(m_pParticleStorage, index);
+	}
+
+	/// <summary>
+	/// 現在存在しているパーティクルの数
+	/// </summary>
+	inline UINT GetParticlesNum() const
+	{
+		return m_pParticleStorage->GetAliveNum();
+	}
+
+	/*
+	* 全てのパーティクルをまとめて処理する関数群 Particleの同名の関数をパーティクルごとに呼ぶより速い
+	*/
+
+	inline void AccelerateParticles(const D3DXVECTOR2& velocity)
+	{
+		m_pParticleStorage->AccelerateAll(velocity);
+	}
+
+	/// <summary>
+	/// パーティクルごとに範囲内の乱数の速度を足す 上限は成分ごとに下限以上にする
+	/// </summary>
+	inline void AccelerateParticlesRandomly(const D3DXVECTOR2& velocityMin, const D3DXVECTOR2& velocityMax)
+	{
+		m_pParticleStorage->AccelerateAllRandomly(velocityMin, velocityMax);
+	}
+
+	/// <summary>
+	/// 生存時間を増やし,速度で中心を動かす SetCollidesでtrueにしていれば続けて物体と衝突させる
+	/// </summary>
+	inline void UpdateParticles()
+	{
+		m_pParticleStorage->UpdateAll();
+
+		CollideParticles();
+	}
+
+	/// <summary>
+	/// SetCollidesでtrueにしていれば,速度で中心を動かした後のパーティクルを物体と衝突させる
+	/// UpdateParticlesを使わずにパーティクルごとに動かすエフェクトは,動かした後に自分で呼ぶ
+	/// </summary>
+	inline void CollideParticles()
+	{
+		if (!m_collides || !m_pParticleCollisionWorld || m_pParticleCollisionWorld->IsEmpty()) return;
+
+		m_pParticleStorage->CollideAll(*m_pParticleCollisionWorld);
+	}
+
+	inline void RotateParticles(const RotateValueXYZ& deg)
+	{
+		m_pParticleStorage->RotateAll(deg);
+	}
+
+	/// <summary>
+	/// パーティクルごとに範囲内の乱数の角度だけ回転させる 上限は成分ごとに下限以上にする
+	/// </summary>
+	inline void RotateParticlesRandomly(const RotateValueXYZ& degMin, const RotateValueXYZ& degMax)
+	{
+		m_pParticleStorage->RotateAllRandomly(degMin, degMax);
+	}
+
+	inline void FadeInParticles(int startFrame, int takesFrame)
+	{
+		m_pParticleStorage->FadeInAll(startFrame, takesFrame);
+	}
+
+	inline void FadeOutParticles(int startFrame, int takesFrame)
+	{
+		m_pParticleStorage->FadeOutAll(startFrame, takesFrame);
+	}
+
+	/// <summary>
+	/// 一番長く生きているパーティクルの生存時間
+	/// </summary>
+	inline int GetMaxLifeFrame() const
+	{
+		return m_pParticleStorage->GetMaxLifeFrame();
+	}
+
+	/// <summary>
+	/// このエフェクトの全てのパーティクルで共有している乱数を取得する
+	/// </summary>
+	inline std::minstd_rand& GetRandEngine()
+	{
+		return m_pParticleStorage->GetRandEngine();
+	}
 
 	static IGameLibRenderer* m_pIGameLibRenderer;
 
-	std::vector<Particle*> m_particles;
+	static ParticleStoragePool* m_pParticleStoragePool;
+
+	static const ParticleCollisionWorld* m_pParticleCollisionWorld;
+
+	/// <summary>
+	/// SaveSnapshotで書き出すバイト列の先頭に置く
+	/// </summary>
+	struct SnapshotHeader
+	{
+	public:
+		char m_magic[4];
+
+		UINT m_version;
+
+		UINT m_particlesMax;
+
+		int m_countToActive;
+	};
+
+	static const char m_SNAPSHOT_MAGIC[4];
+
+	static const UINT m_SNAPSHOT_VERSION = 1;
+
+	//! 使いまわされた配列は要求より大きいことがあるので,最大数はこちらで持つ
+	const UINT m_PARTICLES_MAX = 0;
+
+	ParticleStorage* m_pParticleStorage = nullptr;
+
+	const TCHAR* m_pTexName = nullptr;
+
+	//! 描画のたびにキーで探さないよう,Restartで取得しておく
+	TexHandle m_texHandle;
 
 	const int m_COUNT_TO_ACTIVE_MAX = 0;
 	int m_countToActive = 0;
-	int m_activeLimit = 0;
 
 	bool m_ends = false;
+
+	BYTE m_layer = 0;
+
+	BYTE m_priority = 0;
+
+	UINT m_minParticlesNum = 0;
+
+	//! 割り当てが足りていない場合のみUINT_MAX以外になる
+	UINT m_particlesBudget = UINT_MAX;
+
+	bool m_skipsUpdate = false;
+
+	bool m_collides = false;
 };
 
 #endif //! EFFECT_H
@@ -8,13 +8,216 @@
 #include "Particle.h"
 
 #include <Windows.h>
+#include <math.h>
+
+#include <random>
 
 #include <d3dx9.h>
 
-#include "IGameLibRenderer\IGameLibRenderer.h"
+#include "EffectManager\Effect\ParticleStorage\ParticleStorage.h"
+#include "Algorithm\Algorithm.h"
 #include "VerticesParam.h"
-#include "CustomVertex.h"
-#include "Behavior/Behavior.h"
-#include "Shape/Shape.h"
 
-IGameLibRenderer* Particle::m_pIGameLibRenderer = nullptr;
+using Algorithm::D3DXVec3RotationZ;
+using Algorithm::D3DXVec2RotationZ;
+
+void Particle::FormatShape(float baseScale, float scaleDifferenceMulti)
+{
+	std::uniform_real_distribution<float> scaleMultiRand(min(1.0f, scaleDifferenceMulti), max(1.0f, scaleDifferenceMulti));
+
+	float scaleMulti = scaleMultiRand(m_pParticleStorage->m_randEngine);
+
+	m_pParticleStorage->m_halfScales[m_index] = { baseScale * scaleMulti, baseScale * scaleMulti, 0.0f };
+}
+
+void Particle::FormatShape(float baseScale, const D3DXVECTOR2& scaleDifferenceMulti)
+{
+	std::uniform_real_distribution<float> scaleXMultiRand(min(1.0f, scaleDifferenceMulti.x), max(1.0f, scaleDifferenceMulti.x));
+	std::uniform_real_distribution<float> scaleYMultiRand(min(1.0f, scaleDifferenceMulti.y), max(1.0f, scaleDifferenceMulti.y));
+
+	std::minstd_rand& rRandEngine = m_pParticleStorage->m_randEngine;
+
+	m_pParticleStorage->m_halfScales[m_index] =
+	{
+		baseScale * scaleXMultiRand(rRandEngine),
+		baseScale * scaleYMultiRand(rRandEngine),
+		0.0f
+	};
+}
+
+void Particle::FormatShape(const D3DXVECTOR2& baseScale, float scaleDifferenceMulti)
+{
+	std::uniform_real_distribution<float> scaleMultiRand(min(1.0f, scaleDifferenceMulti), max(1.0f, scaleDifferenceMulti));
+
+	float scaleMulti = baseScale.x * scaleMultiRand(m_pParticleStorage->m_randEngine);
+
+	m_pParticleStorage->m_halfScales[m_index] = { baseScale.x * scaleMulti, baseScale.y * scaleMulti, 0.0f };
+}
+
+void Particle::FormatShape(const D3DXVECTOR2& baseScale, const D3DXVECTOR2& scaleDifferenceMulti)
+{
+	std::uniform_real_distribution<float> scaleXMultiRand(min(1.0f, scaleDifferenceMulti.x), max(1.0f, scaleDifferenceMulti.x));
+	std::uniform_real_distribution<float> scaleYMultiRand(min(1.0f, scaleDifferenceMulti.y), max(1.0f, scaleDifferenceMulti.y));
+
+	std::minstd_rand& rRandEngine = m_pParticleStorage->m_randEngine;
+
+	m_pParticleStorage->m_halfScales[m_index] =
+	{
+		baseScale.x * scaleXMultiRand(rRandEngine),
+		baseScale.y * scaleYMultiRand(rRandEngine),
+		0.0f
+	};
+}
+
+void Particle::FormatCenter(const D3DXVECTOR3& center, const D3DXVECTOR2& centerDifference)
+{
+	std::uniform_real_distribution<float> centerXRand(-centerDifference.x, centerDifference.x);
+	std::uniform_real_distribution<float> centerYRand(-centerDifference.y, centerDifference.y);
+
+	std::minstd_rand& rRandEngine = m_pParticleStorage->m_randEngine;
+
+	D3DXVECTOR3 formattedCenter = m_pParticleStorage->m_originCenters[m_index] = center;
+	formattedCenter.x += centerXRand(rRandEngine);
+	formattedCenter.y += centerYRand(rRandEngine);
+
+	SetCenter(formattedCenter);
+
+	m_pParticleStorage->MarkEmitted(m_index);
+}
+
+void Particle::FormatCenter(const D3DXVECTOR3& center, float centerDifference)
+{
+	FormatCenter(center, 0.0f, centerDifference);
+}
+
+void Particle::FormatCenter(const D3DXVECTOR3& center, float minLengthToCenter, float centerDifference)
+{
+	std::uniform_real_distribution<float> centerRand(minLengthToCenter, minLengthToCenter + centerDifference);
+	std::uniform_real_distribution<float> radRand(0.0f, 2.0f * D3DX_PI);
+
+	std::minstd_rand& rRandEngine = m_pParticleStorage->m_randEngine;
+
+	//! 作成するベクトルをランダムに回転させてそれを位置にする
+	D3DXVECTOR3 centerDifferenceVec = { centerRand(rRandEngine), 0.0f, m_pParticleStorage->m_centerZs[m_index] };
+	D3DXVec3RotationZ(&centerDifferenceVec, radRand(rRandEngine));
+
+	//! 上で作ったベクトル分中心からずらす
+	D3DXVECTOR3 formattedCenter = m_pParticleStorage->m_originCenters[m_index] = center;
+	formattedCenter += centerDifferenceVec;
+
+	SetCenter(formattedCenter);
+
+	m_pParticleStorage->MarkEmitted(m_index);
+}
+
+void Particle::FormatInitialVelocity(float initialSpeed, float direction_deg, float directionDifference_deg)
+{
+	std::uniform_real_distribution<float> degRand(-directionDifference_deg, directionDifference_deg);
+
+	D3DXVECTOR2 initialSpeedForRotate = { initialSpeed, 0.0f };
+	D3DXVec2RotationZ(&initialSpeedForRotate, D3DXToRadian(direction_deg + degRand(m_pParticleStorage->m_randEngine)));
+	m_pParticleStorage->m_velocityXs[m_index] = initialSpeedForRotate.x;
+	m_pParticleStorage->m_velocityYs[m_index] = initialSpeedForRotate.y;
+}
+
+void Particle::FormatRadiationInitialVelocity(float initialSpeed, float directionDifference_deg)
+{
+	D3DXVECTOR3 originToCurrentPosVec;
+	Algorithm::D3DXVec3Unit(&originToCurrentPosVec, m_pParticleStorage->m_originCenters[m_index], GetCenter());
+
+	FormatInitialVelocity(initialSpeed, Algorithm::CalcDegreeAgainstRightVector(originToCurrentPosVec), directionDifference_deg);
+}
+
+void Particle::FormatAbsorptionInitialVelocity(float initialSpeed, float directionDifference_deg)
+{
+	D3DXVECTOR3 originToCurrentPosVec;
+	Algorithm::D3DXVec3Unit(&originToCurrentPosVec, GetCenter(), m_pParticleStorage->m_originCenters[m_index]);
+
+	FormatInitialVelocity(initialSpeed, Algorithm::CalcDegreeAgainstRightVector(originToCurrentPosVec), directionDifference_deg);
+}
+
+void Particle::Accelarate(float speed, D3DXVECTOR2 directionVector)
+{
+	D3DXVECTOR2 unitDirectionVector;
+	D3DXVec2Normalize(&unitDirectionVector, &directionVector);
+
+	D3DXVECTOR2 velocity = speed * unitDirectionVector;
+	Accelarate(velocity);
+}
+
+void Particle::CirculationZ(const D3DXVECTOR3& rotationBasePos, float rotationDegMin, float differenceAdditionalRotationDeg)
+{
+	std::uniform_real_distribution<float> degRand(rotationDegMin, rotationDegMin + differenceAdditionalRotationDeg);
+
+	D3DXVECTOR3 center = GetCenter();
+
+	Algorithm::D3DXVec3CirculationZ(&center, rotationBasePos, D3DXToRadian(degRand(m_pParticleStorage->m_randEngine)));
+
+	SetCenter(center);
+}
+
+bool Particle::IsOutSide(const D3DXVECTOR3& additionalRangeMin, float differenceRangeMulti)
+{
+	std::uniform_real_distribution<float> additionalRangMultiRand(min(1.0f, differenceRangeMulti), max(1.0f, differenceRangeMulti));
+
+	D3DXVECTOR3 center = GetCenter();
+
+	float additionalRangeMulti = additionalRangMultiRand(m_pParticleStorage->m_randEngine);
+	D3DXVECTOR3 additonalRange =
+	{
+		additionalRangeMulti * additionalRangeMin.x,
+		additionalRangeMulti * additionalRangeMin.y,
+		center.z
+	};
+
+	D3DXVECTOR3 radiusVec = center - m_pParticleStorage->m_originCenters[m_index];
+	float radius = D3DXVec3Length(&radiusVec);
+
+	if (radius > D3DXVec3Length(&additonalRange)) return true;
+
+	return false;
+}
+
+void Particle::FadeIn(int startFrame, int takesFrame)
+{
+	int lifeTime = GetLifeFrame();
+
+	if (lifeTime < startFrame || lifeTime > startFrame + takesFrame) return;
+
+	SetAlpha(static_cast<BYTE>(255.0f * (lifeTime - startFrame) / takesFrame));
+}
+
+void Particle::FadeOut(int startFrame, int takesFrame)
+{
+	int lifeTime = GetLifeFrame();
+
+	if (lifeTime < startFrame || lifeTime > startFrame + takesFrame) return;
+
+	SetAlpha(static_cast<BYTE>(255.0f * (1.0f - (lifeTime - startFrame) / static_cast<float>(takesFrame))));
+}
+
+void Particle::GetVerticesParam(VerticesParam* pVerticesParam) const
+{
+	pVerticesParam->m_center	= GetCenter();
+	pVerticesParam->m_halfScale = m_pParticleStorage->m_halfScales[m_index];
+	pVerticesParam->m_deg		= { m_pParticleStorage->m_degXs[m_index], m_pParticleStorage->m_degYs[m_index], m_pParticleStorage->m_degZs[m_index] };
+	pVerticesParam->m_aRGB		= m_pParticleStorage->m_aRGBs[m_index];
+}
+
+void Particle::GetVerticesParam(VerticesParam* pVerticesParam, float interpolation) const
+{
+	GetVerticesParam(pVerticesParam);
+
+	if (m_pParticleStorage->m_emittedFlags[m_index]) return;
+
+	D3DXVECTOR3 prevCenter(m_pParticleStorage->m_prevCenterXs[m_index], m_pParticleStorage->m_prevCenterYs[m_index], m_pParticleStorage->m_prevCenterZs[m_index]);
+
+	D3DXVec3Lerp(&pVerticesParam->m_center, &prevCenter, &pVerticesParam->m_center, interpolation);
+
+	float prevAlpha	= static_cast<float>(m_pParticleStorage->m_prevAlphas[m_index]);
+	float alpha		= static_cast<float>(pVerticesParam->m_aRGB >> 24);
+
+	DWORD interpolatedAlpha = static_cast<DWORD>(prevAlpha + (alpha - prevAlpha) * interpolation + 0.5f);
+
+	pVerticesParam->m_aRGB = (pVerticesParam->m_aRGB & 0x00FFFFFF) | (interpolatedAlpha << 24);
+}
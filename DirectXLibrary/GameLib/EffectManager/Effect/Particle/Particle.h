@@ -12,97 +12,57 @@
 
 #include <d3dx9.h>
 
-#include "Shape/Shape.h"
-#include "Behavior/Behavior.h"
-#include "IGameLibRenderer\IGameLibRenderer.h"
+#include "EffectManager\Effect\ParticleStorage\ParticleStorage.h"
 #include "VerticesParam.h"
-#include "CustomVertex.h"
 
 /// <summary>
 /// パーティクルクラス
+/// ParticleStorageの中の一つのパーティクルを指し,その状態を操作する
 /// </summary>
+/// <remarks>
+/// 状態はParticleStorageが持つので値渡しで扱ってよい
+/// ParticleStorage::Killの後は指しているパーティクルが変わることがある
+/// </remarks>
 class Particle
 {
 public:
-	Particle(const TCHAR* pTexPath) :m_pTexName(pTexPath)
-	{
-		m_pIGameLibRenderer->CreateTex(m_pTexName, m_pTexName);
-	}
-
-	virtual ~Particle() {};
-
-	/// <summary>
-	/// Effectで入れる
-	/// GameLibの描画関係を集めたもの
-	/// </summary>
-	/// <param name="pIGameLibRenderer">GameLibの描画関連のインターフェイス</param>
-	static inline void SetGameLibRenderer(IGameLibRenderer* pIGameLibRenderer)
-	{
-		m_pIGameLibRenderer = pIGameLibRenderer;
+	Particle(ParticleStorage* pParticleStorage, UINT index) :m_pParticleStorage(pParticleStorage), m_index(index) {};
 
-		Behavior::SetGameLibRenderer(pIGameLibRenderer);
-	}
+	~Particle() {};
 
 	/// <summary>
 	/// 形状を誤差ありで作成する
 	/// </summary>
-	/// <param name="pVerticesParam">[out]矩形作成するためのデータ</param>
 	/// <param name="baseScale">基本となる幅</param>
 	/// <param name="scaleDifferenceMulti">
 	/// 幅に掛け合わされる倍率
 	/// ランダムで1.0f~からこの値が掛け合わされる
 	/// </param>
-	inline void FormatShape(float baseScale, float scaleDifferenceMulti = 1.0f)
-	{
-		m_shape.Format(&m_verticesParam, baseScale, scaleDifferenceMulti);
-	}
-
-	inline void FormatShape(float baseScale, const D3DXVECTOR2& scaleDifferenceMulti)
-	{
-		m_shape.Format(&m_verticesParam, baseScale, scaleDifferenceMulti);
-	}
-
-	inline void FormatShape(const D3DXVECTOR2& baseScale, float scaleDifferenceMulti = 1.0f)
-	{
-		m_shape.Format(&m_verticesParam, baseScale, scaleDifferenceMulti);
-	}
-
-	inline void FormatShape(const D3DXVECTOR2& baseScale, const D3DXVECTOR2& scaleDifferenceMulti)
-	{
-		m_shape.Format(&m_verticesParam, baseScale, scaleDifferenceMulti);
-	}
+	void FormatShape(float baseScale, float scaleDifferenceMulti = 1.0f);
+	void FormatShape(float baseScale, const D3DXVECTOR2& scaleDifferenceMulti);
+	void FormatShape(const D3DXVECTOR2& baseScale, float scaleDifferenceMulti = 1.0f);
+	void FormatShape(const D3DXVECTOR2& baseScale, const D3DXVECTOR2& scaleDifferenceMulti);
 
 	/*
 	* 初期化関数群 初めに1度しか呼んではいけない
+	* 中心を初期化したパーティクルは,元の位置から補間して描画しないよう生まれなおしたものとして扱う
 	*/
 
 	/// <summary>
 	/// 中心の初期化
 	/// </summary>
-	/// <param name="pVerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="center">基底となる中心</param>
 	/// <param name="centerDifference">中心の誤差</param>
-	inline void FormatCenter(const D3DXVECTOR3& center, const D3DXVECTOR2& centerDifference)
-	{
-		m_behavior.FormatCenter(&m_verticesParam, center, centerDifference);
-	}
-
-	inline void FormatCenter(const D3DXVECTOR3& center, float centerDifference)
-	{
-		m_behavior.FormatCenter(&m_verticesParam, center, centerDifference);
-	}
+	void FormatCenter(const D3DXVECTOR3& center, const D3DXVECTOR2& centerDifference);
+	void FormatCenter(const D3DXVECTOR3& center, float centerDifference);
 
 	/// <summary>
 	/// 中心の初期化
 	/// </summary>
-	/// <param name="pVerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="center">基底となる中心</param>
 	/// <param name="minLengthToCenter">最低どれだけ中心から離れているか</param>
 	/// <param name="centerDifference">離れている値の誤差</param>
-	inline void FormatCenter(const D3DXVECTOR3& center, float minLengthToCenter, float centerDifference)
-	{
-		m_behavior.FormatCenter(&m_verticesParam, center, minLengthToCenter, centerDifference);
-	}
+	void FormatCenter(const D3DXVECTOR3& center, float minLengthToCenter, float centerDifference);
 
 	/// <summary>
 	/// 初速度の初期化
@@ -113,32 +73,21 @@ public:
 	/// ベースはx軸に正の方向
 	/// </param>
 	/// <param name="directionDifference_deg">方向の角度の誤差</param>
-	inline void FormatInitialVelocity(float initialSpeed, float direction_deg, float directionDifference_deg = 0.0f)
-	{
-		m_behavior.FormatInitialVelocity(initialSpeed, direction_deg, directionDifference_deg);
-	}
+	void FormatInitialVelocity(float initialSpeed, float direction_deg, float directionDifference_deg = 0.0f);
 
 	/// <summary>
 	/// 起点に対して放射する初速度の初期化
 	/// </summary>
-	/// <param name="VerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="initialSpeed">初速度の大きさ</param>
 	/// <param name="directionDifference_deg">方向の角度の誤差</param>
-	inline void FormatRadiationInitialVelocity(float initialSpeed, float directionDifference_deg = 0.0f)
-	{
-		m_behavior.FormatRadiationInitialVelocity(m_verticesParam, initialSpeed, directionDifference_deg);
-	}
+	void FormatRadiationInitialVelocity(float initialSpeed, float directionDifference_deg = 0.0f);
 
 	/// <summary>
 	/// 起点に対して収束する初速度の初期化
 	/// </summary>
-	/// <param name="VerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="initialSpeed">初速度の大きさ</param>
 	/// <param name="directionDifference_deg">方向の角度の誤差</param>
-	inline void FormatAbsorptionInitialVelocity(float initialSpeed, float directionDifference_deg = 0.0f)
-	{
-		m_behavior.FormatAbsorptionInitialVelocity(m_verticesParam, initialSpeed, directionDifference_deg);
-	}
+	void FormatAbsorptionInitialVelocity(float initialSpeed, float directionDifference_deg = 0.0f);
 
 	/*
 	* 動作制御関数群 毎フレーム呼ぶ必要がある物もある
@@ -149,14 +98,12 @@ public:
 	/// </summary>
 	/// <param name="speed">速さ</param>
 	/// <param name="directionVector">加速させる向き</param>
-	inline void Accelarate(float speed, D3DXVECTOR2 directionVector)
-	{
-		m_behavior.Accelarate(speed, directionVector);
-	}
+	void Accelarate(float speed, D3DXVECTOR2 directionVector);
 
 	inline void Accelarate(D3DXVECTOR2 velocity)
 	{
-		m_behavior.Accelarate(velocity);
+		m_pParticleStorage->m_velocityXs[m_index] += velocity.x;
+		m_pParticleStorage->m_velocityYs[m_index] += velocity.y;
 	}
 
 	/// <summary>
@@ -164,77 +111,61 @@ public:
 	/// </summary>
 	inline void ZeroVelocity()
 	{
-		m_behavior.ZeroVelocity();
+		m_pParticleStorage->m_velocityXs[m_index] = 0.0f;
+		m_pParticleStorage->m_velocityYs[m_index] = 0.0f;
 	}
 
 	/// <summary>
 	/// 速度による中心の再計算
 	/// </summary>
-	/// <param name="pVerticesParam">頂点情報を作成するためのデータ</param>
 	inline void CalcCenter()
 	{
-		m_behavior.CalcCenter(&m_verticesParam);
+		m_pParticleStorage->m_centerXs[m_index] += m_pParticleStorage->m_velocityXs[m_index];
+		m_pParticleStorage->m_centerYs[m_index] += m_pParticleStorage->m_velocityYs[m_index];
 	}
 
 	/// <summary>
 	/// Z軸で円運動させる
 	/// </summary>
-	/// <param name="pVerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="rotationBasePos">回転の中心</param>
 	/// <param name="rotationDegMin">回転の最小角度(度数法)</param>
 	/// <param name="differenceAdditionalRotationDeg">追加の回転角度の誤差</param>
-	inline void CirculationZ(const D3DXVECTOR3& rotationBasePos, float rotationDegMin, float differenceAdditionalRotationDeg = 0.0f)
-	{
-		m_behavior.CirculationZ(&m_verticesParam, rotationBasePos, rotationDegMin, differenceAdditionalRotationDeg);
-	}
+	void CirculationZ(const D3DXVECTOR3& rotationBasePos, float rotationDegMin, float differenceAdditionalRotationDeg = 0.0f);
 
 	/// <summary>
 	/// 生成時の基底となる中心でZ軸円運動させる
 	/// </summary>
-	/// <param name="pVerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="rotationDegMin">回転の最小角度(度数法)</param>
 	/// <param name="differenceAdditionalRotationDeg">追加の回転角度の誤差</param>
 	inline void CirculationZ(float rotationDegMin, float differenceAdditionalRotationDeg = 0.0f)
 	{
-		m_behavior.CirculationZ(&m_verticesParam, rotationDegMin, differenceAdditionalRotationDeg);
+		CirculationZ(m_pParticleStorage->m_originCenters[m_index], rotationDegMin, differenceAdditionalRotationDeg);
 	}
 
 	/// <summary>
 	/// 基底の中心から引数に渡した範囲の外に存在しているか判別し結果を返す
 	/// </summary>
-	/// <param name="verticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="additionalRangeMin">基底の中心からの最小の範囲</param>
 	/// <param name="differenceRangeMulti">
 	/// 範囲の誤差の倍率
 	/// 2.0fだと最小の範囲から二倍の間で範囲内たと判別される
 	/// </param>
 	/// <returns>範囲外だとtrue</returns>
-	inline bool IsOutSide(const D3DXVECTOR3& additionalRangeMin, float differenceRangeMulti = 1.0f)
-	{
-		m_behavior.IsOutSide(m_verticesParam, additionalRangeMin, differenceRangeMulti);
-	}
+	bool IsOutSide(const D3DXVECTOR3& additionalRangeMin, float differenceRangeMulti = 1.0f);
 
 	/// <summary>
 	/// フェードインさせる
 	/// </summary>
-	/// <param name="pVerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="startFrame">開始するフレーム</param>
 	/// <param name="takesFrame">フェードインにかかるフレーム</param>
-	inline void FadeIn(int startFrame, int takesFrame)
-	{
-		m_behavior.FadeIn(&m_verticesParam, startFrame, takesFrame, m_lifeFrame);
-	}
+	void FadeIn(int startFrame, int takesFrame);
 
 	/// <summary>
 	/// フェードアウトさせる
 	/// </summary>
-	/// <param name="pVerticesParam">頂点情報を作成するためのデータ</param>
 	/// <param name="startFrame">開始するフレーム</param>
 	/// <param name="takesFrame">フェードアウトにかかるフレーム</param>
-	inline void FadeOut(int startFrame, int takesFrame)
-	{
-		m_behavior.FadeOut(&m_verticesParam, startFrame, takesFrame, m_lifeFrame);
-	}
+	void FadeOut(int startFrame, int takesFrame);
 
 	/// <summary>
 	/// 色を変える
@@ -242,7 +173,7 @@ public:
 	/// <param name="aRGB">変えたいカラーコード</param>
 	inline void SetColor(DWORD aRGB)
 	{
-		m_verticesParam.m_aRGB = aRGB;
+		m_pParticleStorage->m_aRGBs[m_index] = aRGB;
 	}
 
 	/// <summary>
@@ -251,25 +182,27 @@ public:
 	/// <param name="deg">回転角度(度数法)</param>
 	inline void RotateX(float deg)
 	{
-		m_verticesParam.m_deg.x += deg;
+		m_pParticleStorage->m_degXs[m_index] += deg;
 	}
 
 	inline void RotateY(float deg)
 	{
-		m_verticesParam.m_deg.y += deg;
+		m_pParticleStorage->m_degYs[m_index] += deg;
 	}
 
 	inline void RotateZ(float deg)
 	{
-		m_verticesParam.m_deg.z += deg;
+		m_pParticleStorage->m_degZs[m_index] += deg;
 	}
 
 	/// <summary>
-	/// 生存時間の初期化
+	/// 生存時間の初期化 生まれなおしたものとして次の描画では補間しない
 	/// </summary>
 	inline void ZeroLifeFrame()
 	{
-		m_lifeFrame = 0;
+		m_pParticleStorage->m_lifeFrames[m_index] = 0;
+
+		m_pParticleStorage->MarkEmitted(m_index);
 	}
 
 	/// <summary>
@@ -278,39 +211,64 @@ public:
 	/// <returns>生存時間</returns>
 	inline int GetLifeFrame() const
 	{
-		return m_lifeFrame;
+		return m_pParticleStorage->m_lifeFrames[m_index];
 	}
 
 	/// <summary>
 	/// 生存時間を増やし,位置の再計算を行う
 	/// </summary>
-	virtual inline void Update()
+	inline void Update()
 	{
-		++m_lifeFrame;
+		++m_pParticleStorage->m_lifeFrames[m_index];
 
-		m_behavior.CalcCenter(&m_verticesParam);
+		CalcCenter();
 	}
 
 	/// <summary>
-	/// 描画を行う
+	/// 現在の状態から矩形を作成するためのデータを作成する
+	/// </summary>
+	/// <param name="pVerticesParam">[out]矩形を作成するためのデータ</param>
+	void GetVerticesParam(VerticesParam* pVerticesParam) const;
+
+	/// <summary>
+	/// 一つ前の状態と現在の状態の間で,中心とアルファ値を補間して矩形を作成するためのデータを作成する
 	/// </summary>
-	virtual inline void Render()
+	/// <param name="pVerticesParam">[out]矩形を作成するためのデータ</param>
+	/// <param name="interpolation">0なら一つ前の状態,1なら現在の状態 一つ前の状態がない場合は常に現在の状態</param>
+	void GetVerticesParam(VerticesParam* pVerticesParam, float interpolation) const;
+
+	inline UINT GetIndex() const
+	{
+		return m_index;
+	}
+
+	inline D3DXVECTOR3 GetCenter() const
 	{
-		m_pIGameLibRenderer->Render(m_verticesParam, m_pIGameLibRenderer->GetTex(m_pTexName));
+		return D3DXVECTOR3(m_pParticleStorage->m_centerXs[m_index], m_pParticleStorage->m_centerYs[m_index], m_pParticleStorage->m_centerZs[m_index]);
 	}
 
-protected:
-	static IGameLibRenderer* m_pIGameLibRenderer;
+private:
+	inline void SetCenter(const D3DXVECTOR3& center)
+	{
+		m_pParticleStorage->m_centerXs[m_index] = center.x;
+		m_pParticleStorage->m_centerYs[m_index] = center.y;
+		m_pParticleStorage->m_centerZs[m_index] = center.z;
+	}
 
-	VerticesParam m_verticesParam;
+	/// <summary>
+	/// 色のアルファ値だけを書き換える
+	/// </summary>
+	inline void SetAlpha(BYTE alpha)
+	{
+		DWORD& rARGB = m_pParticleStorage->m_aRGBs[m_index];
 
-	Behavior m_behavior;
-	Shape m_shape;
+		rARGB &= 0x00FFFFFF;
+		rARGB += (alpha << 24);
+	}
 
-	//! 生存時間(frame)これを用いて動作のタイミングなどを決める
-	int m_lifeFrame = 0;
+	ParticleStorage* m_pParticleStorage = nullptr;
 
-	const TCHAR* m_pTexName = nullptr;
+	UINT m_index = 0;
 };
 
 #endif //! PARTICLE_H
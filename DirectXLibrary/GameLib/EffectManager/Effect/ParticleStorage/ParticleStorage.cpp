@@ -0,0 +1,389 @@
+﻿/// <filename>
+/// ParticleStorage.cpp
+/// </filename>
+/// <summary>
+/// パーティクルの状態を要素ごとの配列で保持するクラスのソース
+/// </summary>
+
+#include "ParticleStorage.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+#include <d3dx9.h>
+
+#include "VerticesParam.h"
+#include "SimdMath\SimdMath.h"
+#include "EffectManager\ParticleCollisionWorld\ParticleCollisionWorld.h"
+
+namespace
+{
+	template<typename T>
+	void WriteArray(const T* pArray, UINT num, std::vector<BYTE>* pBytes)
+	{
+		size_t writeSize = sizeof(T) * num;
+		size_t prevSize = pBytes->size();
+
+		pBytes->resize(prevSize + writeSize);
+
+		if (writeSize > 0) memcpy(pBytes->data() + prevSize, pArray, writeSize);
+	}
+
+	template<typename T>
+	void ReadArray(const BYTE** ppRead, UINT num, std::vector<T>* pArray)
+	{
+		size_t readSize = sizeof(T) * num;
+
+		if (readSize > 0) memcpy(pArray->data(), *ppRead, readSize);
+
+		*ppRead += readSize;
+	}
+
+	//! 書き出す配列の要素の大きさの合計 ReadStateで大きさを確かめる際に用いる
+	const size_t PARTICLE_STATE_SIZE =
+		sizeof(float) * 3 + sizeof(D3DXVECTOR3) + sizeof(float) * 2 + sizeof(D3DXVECTOR3) +
+		sizeof(float) * 3 + sizeof(DWORD) + sizeof(int);
+}
+
+ParticleStorage::ParticleStorage(UINT capacity) :m_capacity(capacity)
+{
+	m_centerXs.resize(m_capacity);
+	m_centerYs.resize(m_capacity);
+	m_centerZs.resize(m_capacity);
+	m_originCenters.resize(m_capacity);
+	m_velocityXs.resize(m_capacity);
+	m_velocityYs.resize(m_capacity);
+	m_halfScales.resize(m_capacity);
+	m_degXs.resize(m_capacity);
+	m_degYs.resize(m_capacity);
+	m_degZs.resize(m_capacity);
+	m_aRGBs.resize(m_capacity);
+	m_lifeFrames.resize(m_capacity);
+	m_prevCenterXs.resize(m_capacity);
+	m_prevCenterYs.resize(m_capacity);
+	m_prevCenterZs.resize(m_capacity);
+	m_prevAlphas.resize(m_capacity);
+	m_emittedFlags.resize(m_capacity);
+	m_workValues.resize(m_capacity);
+}
+
+bool ParticleStorage::Emit(UINT* pIndex)
+{
+	if (m_aliveNum >= m_capacity) return false;
+
+	UINT index = m_aliveNum++;
+
+	//! VerticesParamの初期値に合わせる
+	m_centerXs[index]		= m_centerYs[index] = m_centerZs[index] = 0.0f;
+	m_originCenters[index]	= { 0.0f, 0.0f, 0.0f };
+	m_velocityXs[index]		= m_velocityYs[index] = 0.0f;
+	m_halfScales[index]		= { 0.0f, 0.0f, 0.0f };
+	m_degXs[index]			= m_degYs[index] = m_degZs[index] = 0.0f;
+	m_aRGBs[index]			= 0xFFFFFFFF;
+	m_lifeFrames[index]		= 0;
+
+	MarkEmitted(index);
+
+	*pIndex = index;
+
+	return true;
+}
+
+void ParticleStorage::Kill(UINT index)
+{
+	if (index >= m_aliveNum) return;
+
+	UINT lastIndex = --m_aliveNum;
+
+	if (index == lastIndex) return;
+
+	m_centerXs[index]		= m_centerXs[lastIndex];
+	m_centerYs[index]		= m_centerYs[lastIndex];
+	m_centerZs[index]		= m_centerZs[lastIndex];
+	m_originCenters[index]	= m_originCenters[lastIndex];
+	m_velocityXs[index]		= m_velocityXs[lastIndex];
+	m_velocityYs[index]		= m_velocityYs[lastIndex];
+	m_halfScales[index]		= m_halfScales[lastIndex];
+	m_degXs[index]			= m_degXs[lastIndex];
+	m_degYs[index]			= m_degYs[lastIndex];
+	m_degZs[index]			= m_degZs[lastIndex];
+	m_aRGBs[index]			= m_aRGBs[lastIndex];
+	m_lifeFrames[index]		= m_lifeFrames[lastIndex];
+	m_prevCenterXs[index]	= m_prevCenterXs[lastIndex];
+	m_prevCenterYs[index]	= m_prevCenterYs[lastIndex];
+	m_prevCenterZs[index]	= m_prevCenterZs[lastIndex];
+	m_prevAlphas[index]		= m_prevAlphas[lastIndex];
+	m_emittedFlags[index]	= m_emittedFlags[lastIndex];
+}
+
+void ParticleStorage::KillOldest(UINT killsNum)
+{
+	if (killsNum == 0) return;
+
+	if (killsNum >= m_aliveNum)
+	{
+		Clear();
+
+		return;
+	}
+
+	m_workIndices.resize(m_aliveNum);
+
+	for (UINT i = 0; i < m_aliveNum; ++i)
+	{
+		m_workIndices[i] = i;
+	}
+
+	auto IsOlder = [this](UINT left, UINT right)
+	{
+		return m_lifeFrames[left] > m_lifeFrames[right];
+	};
+
+	std::nth_element(m_workIndices.begin(), m_workIndices.begin() + killsNum, m_workIndices.end(), IsOlder);
+
+	//! 末尾との入れ替えで消していない添え字が動かないよう,大きい添え字から消す
+	std::sort(m_workIndices.begin(), m_workIndices.begin() + killsNum, std::greater<UINT>());
+
+	for (UINT i = 0; i < killsNum; ++i)
+	{
+		Kill(m_workIndices[i]);
+	}
+}
+
+void ParticleStorage::SaveRenderState()
+{
+	std::copy(m_centerXs.begin(), m_centerXs.begin() + m_aliveNum, m_prevCenterXs.begin());
+	std::copy(m_centerYs.begin(), m_centerYs.begin() + m_aliveNum, m_prevCenterYs.begin());
+	std::copy(m_centerZs.begin(), m_centerZs.begin() + m_aliveNum, m_prevCenterZs.begin());
+
+	for (UINT i = 0; i < m_aliveNum; ++i)
+	{
+		m_prevAlphas[i] = static_cast<BYTE>(m_aRGBs[i] >> 24);
+	}
+
+	std::fill(m_emittedFlags.begin(), m_emittedFlags.begin() + m_aliveNum, static_cast<BYTE>(0));
+}
+
+void ParticleStorage::WriteState(std::vector<BYTE>* pBytes) const
+{
+	WriteArray(&m_aliveNum, 1, pBytes);
+
+	WriteArray(m_centerXs.data(), m_aliveNum, pBytes);
+	WriteArray(m_centerYs.data(), m_aliveNum, pBytes);
+	WriteArray(m_centerZs.data(), m_aliveNum, pBytes);
+	WriteArray(m_originCenters.data(), m_aliveNum, pBytes);
+	WriteArray(m_velocityXs.data(), m_aliveNum, pBytes);
+	WriteArray(m_velocityYs.data(), m_aliveNum, pBytes);
+	WriteArray(m_halfScales.data(), m_aliveNum, pBytes);
+	WriteArray(m_degXs.data(), m_aliveNum, pBytes);
+	WriteArray(m_degYs.data(), m_aliveNum, pBytes);
+	WriteArray(m_degZs.data(), m_aliveNum, pBytes);
+	WriteArray(m_aRGBs.data(), m_aliveNum, pBytes);
+	WriteArray(m_lifeFrames.data(), m_aliveNum, pBytes);
+}
+
+bool ParticleStorage::ReadState(const BYTE* pBytes, size_t bytesSize, UINT particlesMax)
+{
+	UINT aliveNum = 0;
+
+	if (bytesSize < sizeof(aliveNum)) return false;
+
+	memcpy(&aliveNum, pBytes, sizeof(aliveNum));
+
+	if (aliveNum > (std::min)(particlesMax, m_capacity) || bytesSize != sizeof(aliveNum) + PARTICLE_STATE_SIZE * aliveNum) return false;
+
+	m_aliveNum = aliveNum;
+
+	const BYTE* pRead = pBytes + sizeof(aliveNum);
+
+	ReadArray(&pRead, m_aliveNum, &m_centerXs);
+	ReadArray(&pRead, m_aliveNum, &m_centerYs);
+	ReadArray(&pRead, m_aliveNum, &m_centerZs);
+	ReadArray(&pRead, m_aliveNum, &m_originCenters);
+	ReadArray(&pRead, m_aliveNum, &m_velocityXs);
+	ReadArray(&pRead, m_aliveNum, &m_velocityYs);
+	ReadArray(&pRead, m_aliveNum, &m_halfScales);
+	ReadArray(&pRead, m_aliveNum, &m_degXs);
+	ReadArray(&pRead, m_aliveNum, &m_degYs);
+	ReadArray(&pRead, m_aliveNum, &m_degZs);
+	ReadArray(&pRead, m_aliveNum, &m_aRGBs);
+	ReadArray(&pRead, m_aliveNum, &m_lifeFrames);
+
+	//! 読み込んだ状態から補間せずに描画する
+	SaveRenderState();
+
+	return true;
+}
+
+void ParticleStorage::AccelerateAll(const D3DXVECTOR2& velocity)
+{
+	SimdMath::AddScalarArray(m_velocityXs.data(), velocity.x, m_aliveNum);
+	SimdMath::AddScalarArray(m_velocityYs.data(), velocity.y, m_aliveNum);
+}
+
+void ParticleStorage::AccelerateAllRandomly(const D3DXVECTOR2& velocityMin, const D3DXVECTOR2& velocityMax)
+{
+	AddRandomArray(&m_velocityXs, velocityMin.x, velocityMax.x);
+	AddRandomArray(&m_velocityYs, velocityMin.y, velocityMax.y);
+}
+
+void ParticleStorage::UpdateAll()
+{
+	SimdMath::AddScalarArray(m_lifeFrames.data(), 1, m_aliveNum);
+
+	SimdMath::AddArray(m_centerXs.data(), m_velocityXs.data(), m_aliveNum);
+	SimdMath::AddArray(m_centerYs.data(), m_velocityYs.data(), m_aliveNum);
+}
+
+void ParticleStorage::RotateAll(const RotateValueXYZ& deg)
+{
+	if (deg.x != 0.0f) SimdMath::AddScalarArray(m_degXs.data(), deg.x, m_aliveNum);
+	if (deg.y != 0.0f) SimdMath::AddScalarArray(m_degYs.data(), deg.y, m_aliveNum);
+	if (deg.z != 0.0f) SimdMath::AddScalarArray(m_degZs.data(), deg.z, m_aliveNum);
+}
+
+void ParticleStorage::RotateAllRandomly(const RotateValueXYZ& degMin, const RotateValueXYZ& degMax)
+{
+	AddRandomArray(&m_degXs, degMin.x, degMax.x);
+	AddRandomArray(&m_degYs, degMin.y, degMax.y);
+	AddRandomArray(&m_degZs, degMin.z, degMax.z);
+}
+
+void ParticleStorage::FadeInAll(int startFrame, int takesFrame)
+{
+	Fade(startFrame, takesFrame, true);
+}
+
+void ParticleStorage::FadeOutAll(int startFrame, int takesFrame)
+{
+	Fade(startFrame, takesFrame, false);
+}
+
+void ParticleStorage::CollideAll(const ParticleCollisionWorld& rParticleCollisionWorld)
+{
+	ParticleCollider::RESPONSE response = ParticleCollider::RESPONSE::BOUNCE;
+
+	for (UINT i = 0; i < m_aliveNum;)
+	{
+		D3DXVECTOR2 center(m_centerXs[i], m_centerYs[i]);
+		D3DXVECTOR2 velocity(m_velocityXs[i], m_velocityYs[i]);
+
+		//! 増えたか初期化しなおしたパーティクルの一つ前の状態は別のパーティクルのものなので,速度から求める
+		D3DXVECTOR2 prevCenter = m_emittedFlags[i] ? center - velocity : D3DXVECTOR2(m_prevCenterXs[i], m_prevCenterYs[i]);
+
+		if (!rParticleCollisionWorld.Collide(prevCenter, &center, &velocity, &response))
+		{
+			++i;
+
+			continue;
+		}
+
+		//! 末尾のパーティクルが移ってくるので同じ添え字をもう一度処理する
+		if (response == ParticleCollider::RESPONSE::KILL)
+		{
+			Kill(i);
+
+			continue;
+		}
+
+		m_centerXs[i]	= center.x;
+		m_centerYs[i]	= center.y;
+		m_velocityXs[i] = velocity.x;
+		m_velocityYs[i] = velocity.y;
+
+		++i;
+	}
+}
+
+int ParticleStorage::GetMaxLifeFrame() const
+{
+	int maxLifeFrame = 0;
+
+	for (UINT i = 0; i < m_aliveNum; ++i)
+	{
+		maxLifeFrame = (std::max)(maxLifeFrame, m_lifeFrames[i]);
+	}
+
+	return maxLifeFrame;
+}
+
+void ParticleStorage::Fade(int startFrame, int takesFrame, bool isFadeIn)
+{
+	static_assert(sizeof(DWORD) == sizeof(int), "カラーコードを32bit整数として4つずつ読み込むため");
+
+	UINT i = 0;
+
+	//! 1パーティクルずつ処理するParticle::FadeIn,FadeOutと結果が一致するよう,同じ順番で掛けて割る
+#if defined(SIMD_MATH_SSE2)
+	const __m128i START_FRAMES	= _mm_set1_epi32(startFrame);
+	const __m128i END_FRAMES	= _mm_set1_epi32(startFrame + takesFrame);
+	const __m128i RGB_MASK		= _mm_set1_epi32(0x00FFFFFF);
+	const __m128 TAKES_FRAMES	= _mm_set1_ps(static_cast<float>(takesFrame));
+	const __m128 ALPHA_MAX		= _mm_set1_ps(255.0f);
+	const __m128 ONES			= _mm_set1_ps(1.0f);
+
+	for (; i + 4 <= m_aliveNum; i += 4)
+	{
+		__m128i lifeFrames = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_lifeFrames[i]));
+
+		__m128i isOutOfRange = _mm_or_si128(_mm_cmplt_epi32(lifeFrames, START_FRAMES), _mm_cmpgt_epi32(lifeFrames, END_FRAMES));
+
+		__m128 elapsedFrames = _mm_cvtepi32_ps(_mm_sub_epi32(lifeFrames, START_FRAMES));
+
+		__m128 alphas = (isFadeIn) ?
+			_mm_div_ps(_mm_mul_ps(ALPHA_MAX, elapsedFrames), TAKES_FRAMES) :
+			_mm_mul_ps(ALPHA_MAX, _mm_sub_ps(ONES, _mm_div_ps(elapsedFrames, TAKES_FRAMES)));
+
+		__m128i* pARGBs = reinterpret_cast<__m128i*>(&m_aRGBs[i]);
+		__m128i aRGBs = _mm_loadu_si128(pARGBs);
+
+		__m128i fadedARGBs = _mm_or_si128(_mm_and_si128(aRGBs, RGB_MASK), _mm_slli_epi32(_mm_cvttps_epi32(alphas), 24));
+
+		//! 範囲外のパーティクルは元の色のまま
+		aRGBs = _mm_or_si128(_mm_and_si128(isOutOfRange, aRGBs), _mm_andnot_si128(isOutOfRange, fadedARGBs));
+
+		_mm_storeu_si128(pARGBs, aRGBs);
+	}
+#endif
+
+	//! ARMv7のNEONには割り算がなく結果が一致しないので,SSE2以外は1パーティクルずつ処理する
+	for (; i < m_aliveNum; ++i)
+	{
+		int lifeTime = m_lifeFrames[i];
+
+		if (lifeTime < startFrame || lifeTime > startFrame + takesFrame) continue;
+
+		BYTE alpha = (isFadeIn) ?
+			static_cast<BYTE>(255.0f * (lifeTime - startFrame) / takesFrame) :
+			static_cast<BYTE>(255.0f * (1.0f - (lifeTime - startFrame) / static_cast<float>(takesFrame)));
+
+		m_aRGBs[i] &= 0x00FFFFFF;
+		m_aRGBs[i] += (alpha << 24);
+	}
+}
+
+void ParticleStorage::AddRandomArray(std::vector<float>* pArray, float min, float max)
+{
+	//! 範囲がなければ乱数を引かずに同じ値を足す
+	if (min == max)
+	{
+		if (min != 0.0f) SimdMath::AddScalarArray(pArray->data(), min, m_aliveNum);
+
+		return;
+	}
+
+	std::uniform_real_distribution<float> valueRand(min, max);
+
+	//! 乱数を引くのは1つずつだが,足すのはSIMD命令で4つずつ行う
+	for (UINT i = 0; i < m_aliveNum; ++i)
+	{
+		m_workValues[i] = valueRand(m_randEngine);
+	}
+
+	SimdMath::AddArray(pArray->data(), m_workValues.data(), m_aliveNum);
+}
@@ -0,0 +1,242 @@
+﻿/// <filename>
+/// ParticleStorage.h
+/// </filename>
+/// <summary>
+/// パーティクルの状態を要素ごとの配列で保持するクラスのヘッダ
+/// </summary>
+
+#ifndef PARTICLE_STORAGE_H
+#define PARTICLE_STORAGE_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <random>
+
+#include <d3dx9.h>
+
+#include "VerticesParam.h"
+#include "EffectManager\ParticleCollisionWorld\ParticleCollisionWorld.h"
+
+/// <summary>
+/// パーティクルの状態を要素ごとの連続した配列で保持するクラス
+/// </summary>
+/// <remarks>
+/// 配列は作成時に最大数分確保し,以降は確保しなおさない
+/// 生きているパーティクルは常に配列の先頭に詰めて置き,消す際は末尾のものと入れ替える
+/// そのため消した後は添え字が指すパーティクルが変わる
+/// </remarks>
+class ParticleStorage
+{
+public:
+	/// <param name="capacity">保持できるパーティクルの最大数</param>
+	explicit ParticleStorage(UINT capacity);
+
+	~ParticleStorage() {};
+
+	/// <summary>
+	/// 乱数のシードを設定しなおす
+	/// </summary>
+	inline void Seed(UINT seed)
+	{
+		m_randEngine.seed(seed);
+	}
+
+	/// <summary>
+	/// 生きているパーティクルを一つ増やし,初期状態にする
+	/// </summary>
+	/// <param name="pIndex">[out]増やしたパーティクルの添え字</param>
+	/// <returns>最大数に達していて増やせない場合false</returns>
+	bool Emit(UINT* pIndex);
+
+	/// <summary>
+	/// パーティクルを消す 末尾の生きているパーティクルが引数の添え字に移る
+	/// </summary>
+	/// <param name="index">消すパーティクルの添え字</param>
+	void Kill(UINT index);
+
+	/// <summary>
+	/// 生存時間の長いパーティクルから消す
+	/// </summary>
+	/// <param name="killsNum">消すパーティクルの数 生きている数以上なら全て消す</param>
+	void KillOldest(UINT killsNum);
+
+	/// <summary>
+	/// 全てのパーティクルを消す
+	/// </summary>
+	inline void Clear()
+	{
+		m_aliveNum = 0;
+	}
+
+	inline UINT GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	inline UINT GetAliveNum() const
+	{
+		return m_aliveNum;
+	}
+
+	/// <summary>
+	/// パーティクルを生まれたばかりとして扱い,次のSaveRenderStateまで一つ前の状態から補間せずに描画させる
+	/// Emitで増やした場合の他,生きているパーティクルをその場で初期化しなおした場合にも呼ぶ
+	/// </summary>
+	inline void MarkEmitted(UINT index)
+	{
+		m_emittedFlags[index] = 1;
+	}
+
+	/// <summary>
+	/// 描画の際に補間するため,現在の中心とアルファ値を一つ前の状態として保持する
+	/// 固定の間隔で更新する前に毎回呼ぶ
+	/// </summary>
+	void SaveRenderState();
+
+	/// <summary>
+	/// 生きているパーティクルの状態をバイト列の末尾に書き足す 乱数の状態は含まない
+	/// </summary>
+	/// <param name="pBytes">[out]書き足すバイト列</param>
+	void WriteState(std::vector<BYTE>* pBytes) const;
+
+	/// <summary>
+	/// WriteStateで書いた状態を読み込み,パーティクルをその状態にする
+	/// </summary>
+	/// <param name="pBytes">[in]WriteStateで書いた部分の先頭</param>
+	/// <param name="bytesSize">pBytesから読み込めるバイト数 WriteStateで書いた大きさと同じでなければならない</param>
+	/// <param name="particlesMax">読み込めるパーティクルの最大数 保持できる最大数以下</param>
+	/// <returns>大きさが合わないか最大数を超える場合false その場合は何も変えない</returns>
+	bool ReadState(const BYTE* pBytes, size_t bytesSize, UINT particlesMax);
+
+	/// <summary>
+	/// このパーティクル群で共有する乱数を取得する
+	/// </summary>
+	inline std::minstd_rand& GetRandEngine()
+	{
+		return m_randEngine;
+	}
+
+	/*
+	* 生きている全てのパーティクルをまとめて処理する関数群 SIMD命令で4つずつ処理する
+	*/
+
+	/// <summary>
+	/// 全てのパーティクルの速度に足す 重力などに用いる
+	/// </summary>
+	/// <param name="velocity">足す速度</param>
+	void AccelerateAll(const D3DXVECTOR2& velocity);
+
+	/// <summary>
+	/// 全てのパーティクルの速度に,パーティクルごとに範囲内の乱数を足す 風による揺れなどに用いる
+	/// </summary>
+	/// <param name="velocityMin">足す速度の下限</param>
+	/// <param name="velocityMax">足す速度の上限 成分ごとに下限以上でなければならない</param>
+	/// <remarks>乱数はこのパーティクル群の乱数から引くので,シードが同じなら結果も同じになる</remarks>
+	void AccelerateAllRandomly(const D3DXVECTOR2& velocityMin, const D3DXVECTOR2& velocityMax);
+
+	/// <summary>
+	/// 全てのパーティクルの生存時間を増やし,速度で中心を動かす Particle::Updateと同じ
+	/// </summary>
+	void UpdateAll();
+
+	/// <summary>
+	/// 全てのパーティクルを回転させる
+	/// </summary>
+	/// <param name="deg">足す回転角度(度数法)</param>
+	void RotateAll(const RotateValueXYZ& deg);
+
+	/// <summary>
+	/// 全てのパーティクルを,パーティクルごとに範囲内の乱数の角度だけ回転させる
+	/// </summary>
+	/// <param name="degMin">足す回転角度の下限(度数法)</param>
+	/// <param name="degMax">足す回転角度の上限(度数法) 成分ごとに下限以上でなければならない</param>
+	/// <remarks>乱数はこのパーティクル群の乱数から引くので,シードが同じなら結果も同じになる</remarks>
+	void RotateAllRandomly(const RotateValueXYZ& degMin, const RotateValueXYZ& degMax);
+
+	/// <summary>
+	/// 全てのパーティクルをフェードインさせる Particle::FadeInと同じ
+	/// </summary>
+	/// <param name="startFrame">開始するフレーム</param>
+	/// <param name="takesFrame">フェードインにかかるフレーム</param>
+	void FadeInAll(int startFrame, int takesFrame);
+
+	/// <summary>
+	/// 全てのパーティクルをフェードアウトさせる Particle::FadeOutと同じ
+	/// </summary>
+	/// <param name="startFrame">開始するフレーム</param>
+	/// <param name="takesFrame">フェードアウトにかかるフレーム</param>
+	void FadeOutAll(int startFrame, int takesFrame);
+
+	/// <summary>
+	/// 全てのパーティクルを動かない物体と判定し,衝突したものを物体の指定通りに跳ね返すか止めるか消す
+	/// </summary>
+	/// <param name="rParticleCollisionWorld">[in]判定する物体 Buildを呼んでおかなければならない</param>
+	void CollideAll(const ParticleCollisionWorld& rParticleCollisionWorld);
+
+	/// <summary>
+	/// 一番長く生きているパーティクルの生存時間
+	/// </summary>
+	/// <returns>パーティクルがなければ0</returns>
+	int GetMaxLifeFrame() const;
+
+private:
+	friend class Particle;
+
+	/// <summary>
+	/// 生存時間が範囲内のパーティクルのアルファ値を書き換える
+	/// </summary>
+	/// <param name="isFadeIn">trueならフェードイン,falseならフェードアウトの値にする</param>
+	void Fade(int startFrame, int takesFrame, bool isFadeIn);
+
+	/// <summary>
+	/// 生きているパーティクルの要素に,パーティクルごとに範囲内の乱数を足す
+	/// </summary>
+	/// <param name="pArray">[in,out]足される成分の配列</param>
+	void AddRandomArray(std::vector<float>* pArray, float min, float max);
+
+	const UINT m_capacity = 0;
+
+	UINT m_aliveNum = 0;
+
+	//! 配列の要素ごとにまとめて計算できるよう,位置,速度,回転は成分ごとの配列で持つ
+	std::vector<float> m_centerXs;
+	std::vector<float> m_centerYs;
+	std::vector<float> m_centerZs;
+
+	//! 生成時の基底となる中心
+	std::vector<D3DXVECTOR3> m_originCenters;
+
+	std::vector<float> m_velocityXs;
+	std::vector<float> m_velocityYs;
+
+	std::vector<D3DXVECTOR3> m_halfScales;
+
+	std::vector<float> m_degXs;
+	std::vector<float> m_degYs;
+	std::vector<float> m_degZs;
+
+	std::vector<DWORD> m_aRGBs;
+
+	//! 生存時間(frame)
+	std::vector<int> m_lifeFrames;
+
+	//! SaveRenderStateで保持した一つ前の状態 描画の際に現在の状態との間を補間する
+	std::vector<float> m_prevCenterXs;
+	std::vector<float> m_prevCenterYs;
+	std::vector<float> m_prevCenterZs;
+	std::vector<BYTE> m_prevAlphas;
+
+	//! SaveRenderStateの後に増えたか初期化しなおしたパーティクルは1 一つ前の状態が別のパーティクルのものなので補間しない
+	std::vector<BYTE> m_emittedFlags;
+
+	//! KillOldestで消すパーティクルを選ぶ際の作業用
+	std::vector<UINT> m_workIndices;
+
+	//! AddRandomArrayで引いた乱数をまとめて足すための作業用
+	std::vector<float> m_workValues;
+
+	std::minstd_rand m_randEngine;
+};
+
+#endif //! PARTICLE_STORAGE_H
@@ -0,0 +1,120 @@
+﻿/// <filename>
+/// EffectDesc.h
+/// </filename>
+/// <summary>
+/// ファイルから読み込むエフェクトの設定のヘッダ
+/// </summary>
+
+#ifndef EFFECT_DESC_H
+#define EFFECT_DESC_H
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <vector>
+#include <string>
+
+/// <summary>
+/// パーティクルに行う処理一つ分 種類ごとに決まった数の引数を持つ
+/// </summary>
+/// <remarks>
+/// バイナリのファイルにそのまま書き出すので,ポインタなどを持たせてはいけない
+/// </remarks>
+struct EffectModule
+{
+public:
+	enum TYPE : UINT
+	{
+		/*
+		* パーティクルが増えたときに一度だけ行う処理
+		*/
+
+		//! 幅の半分 高さの半分 大きさのばらつきの倍率
+		SHAPE,
+
+		//! a r g b それぞれ0~255
+		COLOR,
+
+		//! 出現させた位置からのずれの最大
+		CENTER,
+
+		//! 出現させた位置からの最短距離 そこからのずれの最大
+		RING_CENTER,
+
+		//! 速さ 向き(度) 向きのばらつき(度)
+		VELOCITY,
+
+		//! 速さ 向きのばらつき(度) 出現させた位置から外へ向かう
+		RADIATION_VELOCITY,
+
+		//! 速さ 向きのばらつき(度) 出現させた位置へ向かう
+		ABSORPTION_VELOCITY,
+
+		/*
+		* 毎フレーム全てのパーティクルに行う処理
+		*/
+
+		//! フレーム数 一番長く生きているパーティクルがこれを超えたらエフェクトを終了する
+		END_AFTER,
+
+		//! 開始フレーム かけるフレーム数
+		FADE_IN,
+
+		//! 開始フレーム かけるフレーム数
+		FADE_OUT,
+
+		//! x y zそれぞれの回転量(度)
+		ROTATE,
+
+		//! 最小の回転量(度) 回転量のばらつき(度) 出現させた位置を中心に回る
+		CIRCULATION_Z,
+
+		/*
+		* どちらでも行える処理
+		*/
+
+		//! x y 増やしたときに行うと初速になる
+		ACCELERATE,
+
+		TYPE_MAX
+	};
+
+	static const UINT m_PARAMS_MAX = 4;
+
+	TYPE m_type = TYPE_MAX;
+
+	//! 使わない引数は0
+	float m_params[m_PARAMS_MAX] = { 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
+/// <summary>
+/// エフェクト一つ分の設定 EffectDescStorageがテキストかバイナリのファイルから作成する
+/// </summary>
+/// <remarks>
+/// 処理は書かれた順に並んでおり,DataDrivenEffectが先頭から順に全てのパーティクルに対して行う
+/// </remarks>
+struct EffectDesc
+{
+public:
+	inline const TCHAR* GetTexPath() const
+	{
+		return (m_texPath.empty()) ? nullptr : m_texPath.c_str();
+	}
+
+	UINT m_particlesNum = 0;
+
+	//! Effectのコンストラクタのもの 0の場合全てのパーティクルを初めから存在させる
+	int m_activeCount = 0;
+
+	//! 空の場合テクスチャを用いない
+	std::basic_string<TCHAR> m_texPath;
+
+	//! バイナリに書き出す際に用いる
+	std::string m_texPathUTF8;
+
+	std::vector<EffectModule> m_emitModules;
+
+	std::vector<EffectModule> m_updateModules;
+};
+
+#endif //! EFFECT_DESC_H
@@ -0,0 +1,416 @@
+﻿/// <filename>
+/// EffectDescStorage.cpp
+/// </filename>
+/// <summary>
+/// エフェクトの設定をファイルから読み込み保持するクラスのソース
+/// </summary>
+
+#include "EffectDescStorage.h"
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+
+#include "EffectManager\EffectDesc\EffectDesc.h"
+
+const char EffectDescStorage::m_BINARY_MAGIC[4] = { 'E', 'F', 'X', 'B' };
+
+bool EffectDescStorage::Load(const TCHAR* pKey, const TCHAR* pFilePath)
+{
+	if (Exists(pKey)) return true;
+
+	std::vector<char> bytes;
+
+	if (!ReadBytes(pFilePath, &bytes)) return false;
+
+	EffectDesc effectDesc;
+
+	bool isBinary = (bytes.size() >= sizeof(m_BINARY_MAGIC) && memcmp(bytes.data(), m_BINARY_MAGIC, sizeof(m_BINARY_MAGIC)) == 0);
+
+	bool isCompiled = (isBinary) ? ReadBinary(bytes, &effectDesc) : CompileText(bytes, &effectDesc);
+
+	if (!isCompiled || !Validate(effectDesc)) return false;
+
+	m_effectDescs[pKey] = effectDesc;
+
+	return true;
+}
+
+bool EffectDescStorage::SaveBinary(const TCHAR* pKey, const TCHAR* pFilePath) const
+{
+	const EffectDesc* pEffectDesc = Get(pKey);
+
+	if (!pEffectDesc) return false;
+
+	BinaryHeader header;
+	memcpy(header.m_magic, m_BINARY_MAGIC, sizeof(m_BINARY_MAGIC));
+	header.m_version			= m_BINARY_VERSION;
+	header.m_particlesNum		= pEffectDesc->m_particlesNum;
+	header.m_activeCount		= pEffectDesc->m_activeCount;
+	header.m_texPathLength		= static_cast<UINT>(pEffectDesc->m_texPathUTF8.size());
+	header.m_emitModulesNum		= static_cast<UINT>(pEffectDesc->m_emitModules.size());
+	header.m_updateModulesNum	= static_cast<UINT>(pEffectDesc->m_updateModules.size());
+
+	FILE* pFile = nullptr;
+
+	if (_tfopen_s(&pFile, pFilePath, _T("wb")) != 0) return false;
+
+	//! 処理は読み込む側でそのままの並びで使えるよう,構造体のまま書き出す
+	bool isWritten =
+		fwrite(&header, sizeof(header), 1, pFile) == 1 &&
+		fwrite(pEffectDesc->m_texPathUTF8.data(), 1, header.m_texPathLength, pFile) == header.m_texPathLength &&
+		fwrite(pEffectDesc->m_emitModules.data(), sizeof(EffectModule), header.m_emitModulesNum, pFile) == header.m_emitModulesNum &&
+		fwrite(pEffectDesc->m_updateModules.data(), sizeof(EffectModule), header.m_updateModulesNum, pFile) == header.m_updateModulesNum;
+
+	fclose(pFile);
+
+	return isWritten;
+}
+
+const EffectDesc* EffectDescStorage::Get(const TCHAR* pKey) const
+{
+	auto effectDesc = m_effectDescs.find(pKey);
+
+	if (effectDesc == m_effectDescs.end()) return nullptr;
+
+	return &effectDesc->second;
+}
+
+bool EffectDescStorage::ReadBytes(const TCHAR* pFilePath, std::vector<char>* pBytes)
+{
+	FILE* pFile = nullptr;
+
+	if (_tfopen_s(&pFile, pFilePath, _T("rb")) != 0) return false;
+
+	const size_t READ_SIZE = 4096;
+
+	size_t readSize = 0;
+
+	do
+	{
+		size_t oldSize = pBytes->size();
+		pBytes->resize(oldSize + READ_SIZE);
+
+		readSize = fread(pBytes->data() + oldSize, 1, READ_SIZE, pFile);
+
+		pBytes->resize(oldSize + readSize);
+	} while (readSize == READ_SIZE);
+
+	fclose(pFile);
+
+	return true;
+}
+
+bool EffectDescStorage::CompileText(const std::vector<char>& rBytes, EffectDesc* pEffectDesc)
+{
+	std::string text(rBytes.begin(), rBytes.end());
+
+	//! UTF-8のBOMを飛ばす
+	size_t lineBegin = (text.compare(0, 3, "\xEF\xBB\xBF") == 0) ? 3 : 0;
+
+	const char* pSPACES = " \t\r";
+
+	std::vector<std::string> words;
+
+	while (lineBegin < text.size())
+	{
+		size_t lineEnd = text.find('\n', lineBegin);
+
+		if (lineEnd == std::string::npos) lineEnd = text.size();
+
+		std::string line = text.substr(lineBegin, lineEnd - lineBegin);
+
+		lineBegin = lineEnd + 1;
+
+		line = line.substr(0, line.find('#'));
+
+		words.clear();
+
+		for (size_t wordBegin = line.find_first_not_of(pSPACES); wordBegin != std::string::npos;)
+		{
+			size_t wordEnd = line.find_first_of(pSPACES, wordBegin);
+
+			words.push_back(line.substr(wordBegin, wordEnd - wordBegin));
+
+			wordBegin = (wordEnd == std::string::npos) ? wordEnd : line.find_first_not_of(pSPACES, wordEnd);
+		}
+
+		if (words.empty()) continue;
+
+		//! 先頭の単語より後ろを前後の空白を除いて取り出す
+		size_t restBegin = line.find_first_not_of(pSPACES, line.find(words[0]) + words[0].size());
+		std::string restOfLine = (restBegin == std::string::npos) ? std::string() :
+			line.substr(restBegin, line.find_last_not_of(pSPACES) + 1 - restBegin);
+
+		if (!CompileLine(words, restOfLine, pEffectDesc)) return false;
+	}
+
+	return true;
+}
+
+bool EffectDescStorage::CompileLine(const std::vector<std::string>& rWords, const std::string& rRestOfLine, EffectDesc* pEffectDesc)
+{
+	const std::string& rKeyword = rWords[0];
+
+	if (rKeyword == "particles")
+	{
+		int particlesNum = 0;
+
+		if (rWords.size() != 2 || !ParseInt(rWords[1], &particlesNum) || particlesNum <= 0) return false;
+
+		pEffectDesc->m_particlesNum = static_cast<UINT>(particlesNum);
+
+		return true;
+	}
+
+	if (rKeyword == "activeCount")
+	{
+		return rWords.size() == 2 && ParseInt(rWords[1], &pEffectDesc->m_activeCount) && pEffectDesc->m_activeCount >= 0;
+	}
+
+	if (rKeyword == "texture")
+	{
+		return !rRestOfLine.empty() && SetTexPath(rRestOfLine, pEffectDesc);
+	}
+
+	if (rKeyword == "emit" || rKeyword == "update")
+	{
+		bool isEmitModule = (rKeyword == "emit");
+
+		EffectModule effectModule;
+
+		if (!CompileModule(rWords, isEmitModule, &effectModule)) return false;
+
+		std::vector<EffectModule>& rEffectModules = (isEmitModule) ? pEffectDesc->m_emitModules : pEffectDesc->m_updateModules;
+		rEffectModules.push_back(effectModule);
+
+		return true;
+	}
+
+	return false;
+}
+
+bool EffectDescStorage::CompileModule(const std::vector<std::string>& rWords, bool isEmitModule, EffectModule* pEffectModule)
+{
+	struct ModuleSyntax
+	{
+	public:
+		const char* m_pName;
+
+		EffectModule::TYPE m_type;
+
+		UINT m_paramsNum;
+	};
+
+	static const ModuleSyntax MODULE_SYNTAXES[] =
+	{
+		{ "shape",			EffectModule::SHAPE,				3 },
+		{ "color",			EffectModule::COLOR,				1 },
+		{ "center",			EffectModule::CENTER,				1 },
+		{ "ringCenter",		EffectModule::RING_CENTER,			2 },
+		{ "velocity",		EffectModule::VELOCITY,				3 },
+		{ "radiation",		EffectModule::RADIATION_VELOCITY,	2 },
+		{ "absorption",		EffectModule::ABSORPTION_VELOCITY,	2 },
+		{ "endAfter",		EffectModule::END_AFTER,			1 },
+		{ "fadeIn",			EffectModule::FADE_IN,				2 },
+		{ "fadeOut",		EffectModule::FADE_OUT,				2 },
+		{ "rotate",			EffectModule::ROTATE,				3 },
+		{ "circulationZ",	EffectModule::CIRCULATION_Z,		2 },
+		{ "accelerate",		EffectModule::ACCELERATE,			2 },
+	};
+
+	if (rWords.size() < 2) return false;
+
+	const ModuleSyntax* pModuleSyntax = nullptr;
+
+	for (const auto& rModuleSyntax : MODULE_SYNTAXES)
+	{
+		if (rWords[1] != rModuleSyntax.m_pName) continue;
+
+		pModuleSyntax = &rModuleSyntax;
+
+		break;
+	}
+
+	if (!pModuleSyntax || rWords.size() != 2 + pModuleSyntax->m_paramsNum) return false;
+
+	EffectModule::TYPE type = pModuleSyntax->m_type;
+
+	bool isEmitOnly		= (type < EffectModule::END_AFTER);
+	bool isUpdateOnly	= (type >= EffectModule::END_AFTER && type < EffectModule::ACCELERATE);
+
+	if ((isEmitModule && isUpdateOnly) || (!isEmitModule && isEmitOnly)) return false;
+
+	pEffectModule->m_type = type;
+
+	//! 色は0xAARRGGBBで書き,floatで正確に持てるよう成分ごとに分ける
+	if (type == EffectModule::COLOR)
+	{
+		char* pEnd = nullptr;
+		DWORD aRGB = static_cast<DWORD>(strtoul(rWords[2].c_str(), &pEnd, 0));
+
+		if (*pEnd != '\0') return false;
+
+		for (UINT i = 0; i < 4; ++i)
+		{
+			pEffectModule->m_params[i] = static_cast<float>((aRGB >> (24 - 8 * i)) & 0xFF);
+		}
+
+		return true;
+	}
+
+	for (UINT i = 0; i < pModuleSyntax->m_paramsNum; ++i)
+	{
+		if (!ParseFloat(rWords[2 + i], &pEffectModule->m_params[i])) return false;
+	}
+
+	return true;
+}
+
+bool EffectDescStorage::ReadBinary(const std::vector<char>& rBytes, EffectDesc* pEffectDesc)
+{
+	BinaryHeader header;
+
+	if (rBytes.size() < sizeof(header)) return false;
+
+	memcpy(&header, rBytes.data(), sizeof(header));
+
+	if (header.m_version != m_BINARY_VERSION) return false;
+
+	//! 32bitのsize_tでは数の大きいヘッダで掛け算があふれ,ファイルの大きさと一致してしまうので64bitで求める
+	UINT64 modulesNum	= static_cast<UINT64>(header.m_emitModulesNum) + header.m_updateModulesNum;
+	UINT64 fileSize		= sizeof(header) + static_cast<UINT64>(header.m_texPathLength) + modulesNum * sizeof(EffectModule);
+
+	if (static_cast<UINT64>(rBytes.size()) != fileSize) return false;
+
+	pEffectDesc->m_particlesNum = header.m_particlesNum;
+	pEffectDesc->m_activeCount	= header.m_activeCount;
+
+	const char* pRead = rBytes.data() + sizeof(header);
+
+	if (header.m_texPathLength > 0 && !SetTexPath(std::string(pRead, header.m_texPathLength), pEffectDesc)) return false;
+
+	pRead += header.m_texPathLength;
+
+	pEffectDesc->m_emitModules.resize(header.m_emitModulesNum);
+	memcpy(pEffectDesc->m_emitModules.data(), pRead, header.m_emitModulesNum * sizeof(EffectModule));
+
+	pRead += header.m_emitModulesNum * sizeof(EffectModule);
+
+	pEffectDesc->m_updateModules.resize(header.m_updateModulesNum);
+	memcpy(pEffectDesc->m_updateModules.data(), pRead, header.m_updateModulesNum * sizeof(EffectModule));
+
+	return true;
+}
+
+bool EffectDescStorage::Validate(const EffectDesc& rEffectDesc)
+{
+	if (rEffectDesc.m_particlesNum == 0 || rEffectDesc.m_particlesNum > m_PARTICLES_MAX) return false;
+
+	if (rEffectDesc.m_activeCount < 0 || rEffectDesc.m_activeCount > m_FRAMES_MAX) return false;
+
+	if (rEffectDesc.m_emitModules.size() + rEffectDesc.m_updateModules.size() > m_MODULES_MAX) return false;
+
+	for (const auto& rEffectModule : rEffectDesc.m_emitModules)
+	{
+		if (!ValidateModule(rEffectModule)) return false;
+	}
+
+	for (const auto& rEffectModule : rEffectDesc.m_updateModules)
+	{
+		if (!ValidateModule(rEffectModule)) return false;
+	}
+
+	return true;
+}
+
+bool EffectDescStorage::ValidateModule(const EffectModule& rEffectModule)
+{
+	//! 壊れたバイナリで未知の処理を行わないよう種類も確かめる
+	if (rEffectModule.m_type >= EffectModule::TYPE_MAX) return false;
+
+	for (float param : rEffectModule.m_params)
+	{
+		if (!std::isfinite(param)) return false;
+	}
+
+	auto IsFrame = [](float param)
+	{
+		return param >= 0.0f && param <= static_cast<float>(m_FRAMES_MAX) && param == std::floor(param);
+	};
+
+	const float* pParams = rEffectModule.m_params;
+
+	switch (rEffectModule.m_type)
+	{
+	case EffectModule::END_AFTER:
+		return IsFrame(pParams[0]);
+
+	//! かけるフレーム数で割るので0を受け付けない
+	case EffectModule::FADE_IN:
+	case EffectModule::FADE_OUT:
+		return IsFrame(pParams[0]) && IsFrame(pParams[1]) && pParams[1] >= 1.0f;
+
+	case EffectModule::COLOR:
+		for (float param : rEffectModule.m_params)
+		{
+			if (param < 0.0f || param > 255.0f) return false;
+		}
+
+		return true;
+
+	default:
+		return true;
+	}
+}
+
+bool EffectDescStorage::SetTexPath(const std::string& rTexPathUTF8, EffectDesc* pEffectDesc)
+{
+	pEffectDesc->m_texPathUTF8 = rTexPathUTF8;
+
+	int length = MultiByteToWideChar(CP_UTF8, 0, rTexPathUTF8.c_str(), -1, NULL, 0);
+
+	if (length <= 0) return false;
+
+	std::vector<WCHAR> texPath(length);
+	MultiByteToWideChar(CP_UTF8, 0, rTexPathUTF8.c_str(), -1, texPath.data(), length);
+
+#ifdef UNICODE
+	pEffectDesc->m_texPath = texPath.data();
+#else
+	//! マルチバイト文字セットではシステムの既定のコードページに変換する
+	int multiByteLength = WideCharToMultiByte(CP_ACP, 0, texPath.data(), -1, NULL, 0, NULL, NULL);
+
+	if (multiByteLength <= 0) return false;
+
+	std::vector<CHAR> multiByteTexPath(multiByteLength);
+	WideCharToMultiByte(CP_ACP, 0, texPath.data(), -1, multiByteTexPath.data(), multiByteLength, NULL, NULL);
+
+	pEffectDesc->m_texPath = multiByteTexPath.data();
+#endif
+
+	return true;
+}
+
+bool EffectDescStorage::ParseFloat(const std::string& rWord, float* pValue)
+{
+	char* pEnd = nullptr;
+	*pValue = strtof(rWord.c_str(), &pEnd);
+
+	return *pEnd == '\0';
+}
+
+bool EffectDescStorage::ParseInt(const std::string& rWord, int* pValue)
+{
+	char* pEnd = nullptr;
+	*pValue = static_cast<int>(strtol(rWord.c_str(), &pEnd, 10));
+
+	return *pEnd == '\0';
+}
@@ -0,0 +1,155 @@
+﻿/// <filename>
+/// EffectDescStorage.h
+/// </filename>
+/// <summary>
+/// エフェクトの設定をファイルから読み込み保持するクラスのヘッダ
+/// </summary>
+
+#ifndef EFFECT_DESC_STORAGE_H
+#define EFFECT_DESC_STORAGE_H
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <vector>
+#include <map>
+#include <string>
+
+#include "EffectManager\EffectDesc\EffectDesc.h"
+
+/// <summary>
+/// エフェクトの設定をファイルから読み込み,キーごとに保持するクラス
+/// </summary>
+/// <remarks>
+/// 作成時はテキスト,配布時はSaveBinaryで書き出したバイナリを読み込む 形式はファイルの先頭で判別する
+/// テキストは一行に一つの設定を空白区切りで書き,#以降は無視する
+///
+/// particles 13
+/// texture 2DTextures/EffectTexture/Star.png
+/// activeCount 0
+/// emit shape 1.5 1.5 2.0
+/// emit color 0x0087CEFA
+/// emit center 20
+/// emit radiation 2 0
+/// update endAfter 40
+/// update fadeIn 0 10
+/// update fadeOut 15 20
+/// update rotate 0 0 3
+///
+/// emitの処理はパーティクルが増えたときに,updateの処理は毎フレーム書いた順に行う
+/// updateの処理の後には必ず速度で中心を動かし,生存時間を増やす
+///
+/// パーティクルの数はm_PARTICLES_MAXまで,処理の数はm_MODULES_MAXまで
+/// フレーム数の引数は0~m_FRAMES_MAXの整数で,fadeIn,fadeOutのかけるフレーム数は1以上でなければならない
+/// </remarks>
+class EffectDescStorage
+{
+public:
+	EffectDescStorage() {};
+
+	~EffectDescStorage() {};
+
+	/// <summary>
+	/// ファイルから設定を読み込む 既にキーが使われている場合は何もしない
+	/// </summary>
+	/// <param name="pKey">設定につけるキー</param>
+	/// <param name="pFilePath">テキストかバイナリのファイルのパス</param>
+	/// <returns>ファイルが開けないか書式が誤っている場合false</returns>
+	bool Load(const TCHAR* pKey, const TCHAR* pFilePath);
+
+	/// <summary>
+	/// 読み込んだ設定を配布用のバイナリとして書き出す
+	/// </summary>
+	/// <returns>キーが存在しないか書き出せない場合false</returns>
+	bool SaveBinary(const TCHAR* pKey, const TCHAR* pFilePath) const;
+
+	/// <summary>
+	/// 設定を取得する 取得したものは破棄されるまで同じアドレスを指す
+	/// </summary>
+	/// <returns>キーが存在しない場合nullptr</returns>
+	const EffectDesc* Get(const TCHAR* pKey) const;
+
+	inline bool Exists(const TCHAR* pKey) const
+	{
+		return m_effectDescs.find(pKey) != m_effectDescs.end();
+	}
+
+private:
+	/// <summary>
+	/// バイナリのファイルの先頭に置く
+	/// </summary>
+	struct BinaryHeader
+	{
+	public:
+		char m_magic[4];
+
+		UINT m_version;
+
+		UINT m_particlesNum;
+
+		int m_activeCount;
+
+		UINT m_texPathLength;
+
+		UINT m_emitModulesNum;
+
+		UINT m_updateModulesNum;
+	};
+
+	/// <summary>
+	/// ファイルの中身を全て読み込む
+	/// </summary>
+	static bool ReadBytes(const TCHAR* pFilePath, std::vector<char>* pBytes);
+
+	static bool CompileText(const std::vector<char>& rBytes, EffectDesc* pEffectDesc);
+
+	/// <summary>
+	/// テキストの一行分を設定に加える
+	/// </summary>
+	/// <param name="rWords">[in]空白で区切った一行分の単語 空ではない</param>
+	/// <param name="rRestOfLine">[in]先頭の単語より後ろの部分 空白を含むパスに用いる</param>
+	static bool CompileLine(const std::vector<std::string>& rWords, const std::string& rRestOfLine, EffectDesc* pEffectDesc);
+
+	/// <summary>
+	/// emitかupdateに続く単語から処理を作成する
+	/// </summary>
+	/// <param name="isEmitModule">emitの処理の場合true 毎フレーム行う処理を受け付けない</param>
+	static bool CompileModule(const std::vector<std::string>& rWords, bool isEmitModule, EffectModule* pEffectModule);
+
+	static bool ReadBinary(const std::vector<char>& rBytes, EffectDesc* pEffectDesc);
+
+	/// <summary>
+	/// テキストとバイナリのどちらから作成した設定も,実行して問題がない値かを確かめる
+	/// </summary>
+	static bool Validate(const EffectDesc& rEffectDesc);
+
+	/// <summary>
+	/// 引数が有限で,フレーム数の引数が範囲内の整数か
+	/// </summary>
+	static bool ValidateModule(const EffectModule& rEffectModule);
+
+	/// <summary>
+	/// UTF-8のパスからテクスチャのパスを作成する
+	/// </summary>
+	static bool SetTexPath(const std::string& rTexPathUTF8, EffectDesc* pEffectDesc);
+
+	static bool ParseFloat(const std::string& rWord, float* pValue);
+
+	static bool ParseInt(const std::string& rWord, int* pValue);
+
+	static const char m_BINARY_MAGIC[4];
+
+	static const UINT m_BINARY_VERSION = 1;
+
+	//! パーティクルの配列は最大数分まとめて確保するので,誤った値で巨大な確保をしないよう上限を設ける
+	static const UINT m_PARTICLES_MAX = 100000;
+
+	static const UINT m_MODULES_MAX = 256;
+
+	//! 60fpsで1時間
+	static const int m_FRAMES_MAX = 60 * 60 * 60;
+
+	std::map<std::basic_string<TCHAR>, EffectDesc> m_effectDescs;
+};
+
+#endif //! EFFECT_DESC_STORAGE_H
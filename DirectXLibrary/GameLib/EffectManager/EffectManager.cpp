@@ -10,64 +10,225 @@
 #include <Windows.h>
 
 #include <vector>
+#include <map>
+#include <typeindex>
+#include <algorithm>
 
 #include <d3dx9.h>
 
 #include "Effect\Effect.h"
+#include "EffectPool\EffectPool.h"
+#include "EffectDesc\EffectDesc.h"
+#include "EffectDescStorage\EffectDescStorage.h"
+#include "DataDrivenEffect\DataDrivenEffect.h"
+#include "ParticleStoragePool\ParticleStoragePool.h"
+#include "ParticleBudget\ParticleBudget.h"
+#include "ParticleCollisionWorld\ParticleCollisionWorld.h"
+#include "JobSystem\JobSystem.h"
+
+const float EffectManager::m_STEP_TIME_S = 1.0f / 60.0f;
+
+EffectHandle EffectManager::AddEffect(Effect* pEffect)
+{
+	return Register(pEffect, nullptr);
+}
 
-void EffectManager::AddEffect(Effect* pEffect)
+EffectHandle EffectManager::SpawnEffect(const TCHAR* pEffectDescKey, const D3DXVECTOR3& center)
 {
-	m_pEffects.push_back(pEffect);
+	const EffectDesc* pEffectDesc = m_effectDescStorage.Get(pEffectDescKey);
+
+	if (!pEffectDesc) return EffectHandle();
+
+	EffectPool<DataDrivenEffect>*& rpEffectPool = m_pDataDrivenEffectPools[pEffectDesc];
+
+	if (!rpEffectPool) rpEffectPool = new EffectPool<DataDrivenEffect>();
+
+	return Register(rpEffectPool->Acquire(pEffectDesc, center), rpEffectPool);
 }
 
-void EffectManager::Update()
+Effect* EffectManager::GetEffect(EffectHandle effectHandle) const
 {
-	if (m_pEffects.size() <= 0) return;
+	if (effectHandle.m_index >= m_effectSlots.size()) return nullptr;
 
-	ReleaseEndEffects();
+	const EffectSlot& rEffectSlot = m_effectSlots[effectHandle.m_index];
+
+	if (rEffectSlot.m_generation != effectHandle.m_generation) return nullptr;
+
+	return rEffectSlot.m_pEffect;
+}
+
+void EffectManager::FastForwardEffect(EffectHandle effectHandle, float time_s)
+{
+	Effect* pEffect = GetEffect(effectHandle);
+
+	if (!pEffect || time_s <= 0.0f) return;
+
+	m_particleCollisionWorld.Build();
+
+	//! 2秒を60分の1秒で割ると119.99...になるなど,切り捨てると一回足りなくなるので四捨五入する
+	pEffect->FastForward(static_cast<UINT>(time_s / m_STEP_TIME_S + 0.5f));
+}
+
+void EffectManager::KillEffect(EffectHandle effectHandle)
+{
+	Effect* pEffect = GetEffect(effectHandle);
+
+	if (!pEffect) return;
+
+	pEffect->End();
+}
+
+void EffectManager::Update(float deltaTime_s)
+{
+	if (m_activeSlotIndices.size() <= 0)
+	{
+		m_accumulatedTime_s = 0.0f;
+
+		return;
+	}
+
+	//! 止まっていた場合などに大きな経過時間が渡されても,進める回数に上限を設け残りは捨てる
+	m_accumulatedTime_s = (std::min)(m_accumulatedTime_s + (std::max)(deltaTime_s, 0.0f), m_STEP_TIME_S * m_STEPS_PER_UPDATE_MAX);
 
-	for (auto i : m_pEffects)
+	while (m_accumulatedTime_s >= m_STEP_TIME_S)
 	{
-		i->Update();
+		Step();
+
+		m_accumulatedTime_s -= m_STEP_TIME_S;
 	}
 }
 
 void EffectManager::Render()
 {
-	if (m_pEffects.size() <= 0) return;
+	if (m_activeSlotIndices.size() <= 0) return;
+
+	float interpolation = m_accumulatedTime_s / m_STEP_TIME_S;
+
+	for (auto i : m_activeSlotIndices)
+	{
+		m_effectSlots[i].m_pEffect->Render(interpolation);
+	}
+}
+
+void EffectManager::Step()
+{
+	ReleaseEndEffects();
+
+	m_pActiveEffects.clear();
 
-	for (auto i : m_pEffects)
+	for (auto i : m_activeSlotIndices)
 	{
-		i->Render();
+		m_pActiveEffects.push_back(m_effectSlots[i].m_pEffect);
 	}
+
+	//! 並列に更新する前にメインスレッドでパーティクルの数を割り当てておく
+	m_particleBudget.Apply(m_pActiveEffects);
+
+	//! 物体を変えていれば,並列に判定する前にメインスレッドで空間ハッシュを作りなおす
+	m_particleCollisionWorld.Build();
+
+	//! エフェクト同士は状態を共有しないので,一つずつ別の処理として分ける
+	auto UpdateEffects = [this](UINT begin, UINT end)
+	{
+		for (UINT i = begin; i < end; ++i)
+		{
+			m_effectSlots[m_activeSlotIndices[i]].m_pEffect->Step();
+		}
+	};
+
+	m_jobSystem.ParallelFor(static_cast<UINT>(m_activeSlotIndices.size()), 1, UpdateEffects);
 }
 
 void EffectManager::AllRelease()
 {
-	for (auto i : m_pEffects)
+	for (auto i : m_activeSlotIndices)
+	{
+		Unregister(i);
+	}
+
+	m_activeSlotIndices.clear();
+
+	for (auto& i : m_pEffectPools)
+	{
+		delete i.second;
+	}
+
+	m_pEffectPools.clear();
+
+	for (auto& i : m_pDataDrivenEffectPools)
+	{
+		delete i.second;
+	}
+
+	m_pDataDrivenEffectPools.clear();
+}
+
+EffectHandle EffectManager::Register(Effect* pEffect, IEffectPool* pEffectPool)
+{
+	UINT slotIndex = 0;
+
+	if (m_freeSlotIndices.empty())
+	{
+		slotIndex = static_cast<UINT>(m_effectSlots.size());
+
+		m_effectSlots.emplace_back();
+	}
+	else
+	{
+		slotIndex = m_freeSlotIndices.back();
+
+		m_freeSlotIndices.pop_back();
+	}
+
+	EffectSlot& rEffectSlot = m_effectSlots[slotIndex];
+	rEffectSlot.m_pEffect		= pEffect;
+	rEffectSlot.m_pEffectPool	= pEffectPool;
+
+	m_activeSlotIndices.push_back(slotIndex);
+
+	EffectHandle effectHandle;
+	effectHandle.m_index		= slotIndex;
+	effectHandle.m_generation	= rEffectSlot.m_generation;
+
+	return effectHandle;
+}
+
+void EffectManager::Unregister(UINT slotIndex)
+{
+	EffectSlot& rEffectSlot = m_effectSlots[slotIndex];
+
+	if (rEffectSlot.m_pEffectPool)
+	{
+		rEffectSlot.m_pEffectPool->Release(rEffectSlot.m_pEffect);
+	}
+	else
 	{
-		delete i;
+		delete rEffectSlot.m_pEffect;
 	}
 
-	m_pEffects.clear();
-	m_pEffects.shrink_to_fit();
+	rEffectSlot.m_pEffect		= nullptr;
+	rEffectSlot.m_pEffectPool	= nullptr;
+	++rEffectSlot.m_generation;
+
+	m_freeSlotIndices.push_back(slotIndex);
 }
 
 void EffectManager::ReleaseEndEffects()
 {
-	if (m_pEffects.size() <= 0) return;
+	//! 残すものを前に詰めながら一度だけ走査する 追加した順は保たれる
+	size_t keptNum = 0;
 
-	for (int i = static_cast<int>(m_pEffects.size() - 1); i >= 0; --i)
+	for (auto i : m_activeSlotIndices)
 	{
-		if (!m_pEffects[i]->GetEnds())
+		if (m_effectSlots[i].m_pEffect->GetEnds())
 		{
+			Unregister(i);
+
 			continue;
 		}
 
-		delete m_pEffects[i];
-
-		std::vector<Effect*>::iterator thisIndexItr = m_pEffects.begin() + i;
-
-		m_pEffects.erase(thisIndexItr);
+		m_activeSlotIndices[keptNum++] = i;
 	}
+
+	m_activeSlotIndices.resize(keptNum);
 }
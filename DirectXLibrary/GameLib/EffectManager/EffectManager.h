@@ -11,56 +11,265 @@
 #include <Windows.h>
 
 #include <vector>
+#include <map>
+#include <typeindex>
+#include <utility>
+#include <climits>
 
 #include <d3dx9.h>
 	
 #include "Effect\Effect.h"
+#include "EffectPool\EffectPool.h"
+#include "EffectDesc\EffectDesc.h"
+#include "EffectDescStorage\EffectDescStorage.h"
+#include "DataDrivenEffect\DataDrivenEffect.h"
+#include "ParticleStoragePool\ParticleStoragePool.h"
+#include "ParticleBudget\ParticleBudget.h"
+#include "ParticleCollisionWorld\ParticleCollisionWorld.h"
+#include "JobSystem\JobSystem.h"
 #include "IGameLibRenderer\IGameLibRenderer.h"
 
+/// <summary>
+/// EffectManagerに登録したエフェクトを指すハンドル
+/// エフェクトが終了して使いまわされた後は何も指さなくなる
+/// </summary>
+struct EffectHandle
+{
+public:
+	UINT m_index = UINT_MAX;
+
+	UINT m_generation = 0;
+};
+
 /// <summary>
 /// エフェクトを管理するクラス
 /// </summary>
 class EffectManager
 {
 public:
-	explicit EffectManager(IGameLibRenderer* m_pIGameLibRenderer)
+	//! 並列に更新してよいかはエフェクトの作りによるので,SetUpdatesInParallelで許可されるまで順番に行い,スレッドも作らない
+	explicit EffectManager(IGameLibRenderer* m_pIGameLibRenderer) :m_jobSystem(JobSystem::DefaultWorkersNum(), true)
 	{
 		Effect::SetGameLibRenderer(m_pIGameLibRenderer);
+		Effect::SetParticleStoragePool(&m_particleStoragePool);
+		Effect::SetParticleCollisionWorld(&m_particleCollisionWorld);
 	}
 
 	~EffectManager() 
 	{
 		AllRelease();
+
+		//! これ以降に開放されるエフェクトは配列を自分で開放する
+		Effect::SetParticleStoragePool(nullptr);
+		Effect::SetParticleCollisionWorld(nullptr);
+	}
+
+	/// <summary>
+	/// エフェクトの追加 終了したら開放する
+	/// </summary>
+	/// <param name="pEffect">追加したいエフェクトのポインタ newで作成したもの</param>
+	/// <returns>追加したエフェクトのハンドル</returns>
+	EffectHandle AddEffect(Effect* pEffect);
+
+	/// <summary>
+	/// 型ごとのプールからエフェクトを取り出して追加する 終了したらプールに返す
+	/// </summary>
+	/// <param name="args">Tのコンストラクタ,T::Resetに渡す引数</param>
+	/// <returns>追加したエフェクトのハンドル</returns>
+	template<typename T, typename... Args>
+	EffectHandle SpawnEffect(Args&&... args)
+	{
+		EffectPool<T>* pEffectPool = GetEffectPool<T>();
+
+		return Register(pEffectPool->Acquire(std::forward<Args>(args)...), pEffectPool);
+	}
+
+	/// <summary>
+	/// エフェクトの設定をファイルから読み込む 既にキーが使われている場合は何もしない
+	/// </summary>
+	/// <param name="pKey">設定につけるキー SpawnEffectで用いる</param>
+	/// <param name="pFilePath">テキストかバイナリのファイルのパス</param>
+	/// <returns>ファイルが開けないか書式が誤っている場合false</returns>
+	inline bool LoadEffectDesc(const TCHAR* pKey, const TCHAR* pFilePath)
+	{
+		return m_effectDescStorage.Load(pKey, pFilePath);
 	}
 
 	/// <summary>
-	/// エフェクトの追加
+	/// 読み込んだエフェクトの設定を配布用のバイナリとして書き出す
 	/// </summary>
-	/// <param name="pEffect">追加したいエフェクトのポインタ</param>
-	void AddEffect(Effect* pEffect);
+	inline bool SaveEffectDescBinary(const TCHAR* pKey, const TCHAR* pFilePath) const
+	{
+		return m_effectDescStorage.SaveBinary(pKey, pFilePath);
+	}
+
+	/// <summary>
+	/// 読み込んだ設定で動くエフェクトを設定ごとのプールから取り出して追加する
+	/// </summary>
+	/// <param name="pEffectDescKey">LoadEffectDescでつけたキー</param>
+	/// <param name="center">パーティクルを出現させる位置</param>
+	/// <returns>追加したエフェクトのハンドル 設定が読み込まれていない場合何も指さない</returns>
+	EffectHandle SpawnEffect(const TCHAR* pEffectDescKey, const D3DXVECTOR3& center);
+
+	/// <summary>
+	/// ハンドルが指すエフェクトを取得する
+	/// </summary>
+	/// <returns>既に終了している場合nullptr</returns>
+	Effect* GetEffect(EffectHandle effectHandle) const;
+
+	/// <summary>
+	/// ハンドルが指すエフェクトを描画せずに指定した時間分進める
+	/// 追加した直後に呼ぶと,パーティクルが揃うまで時間のかかるエフェクトを揃った状態から始められる
+	/// </summary>
+	/// <param name="time_s">進める時間(秒) シミュレーションを一回進める間隔で割った回数だけ進める</param>
+	void FastForwardEffect(EffectHandle effectHandle, float time_s);
 
 	/// <summary>
-	/// エフェクトの更新
+	/// ハンドルが指すエフェクトを終了させる 次の更新で取り除かれる
 	/// </summary>
-	void Update();
+	void KillEffect(EffectHandle effectHandle);
 
 	/// <summary>
-	/// エフェクトの描画
+	/// 経過時間を貯め,固定の間隔の分だけエフェクトのシミュレーションを進める
+	/// SetUpdatesInParallelでtrueにした場合は一回ごとにエフェクトごとに複数のスレッドで並列に行う
+	/// </summary>
+	/// <param name="deltaTime_s">前回の更新からの経過時間(秒)</param>
+	/// <remarks>
+	/// 描画の頻度によらず同じ間隔で進めるので,30fpsでも144fpsでも同じ結果になる
+	/// 間隔はm_STEP_TIME_Sの60分の1秒で固定 エフェクトの速度や生存時間のフレームはこの一回を指すので変えられない
+	/// 処理落ちした場合に追いつこうとして更に重くならないよう,一回の更新で進めるのはm_STEPS_PER_UPDATE_MAX回まで
+	/// </remarks>
+	void Update(float deltaTime_s);
+
+	/// <summary>
+	/// trueにするとエフェクトごとの更新を複数のスレッドで並列に行う 設定していなかった場合はメインスレッドで順番に行う
+	/// 初めてtrueにした際に更新を行うスレッドを作る
+	/// </summary>
+	/// <remarks>
+	/// 登録する全てのエフェクトのUpdateがEffect::Updateの制約を守っている場合のみtrueにする
+	/// 乱数をGetRandEngineから取るエフェクトだけであれば,並列でも順番でも同じ結果になる
+	/// </remarks>
+	inline void SetUpdatesInParallel(bool updatesInParallel)
+	{
+		m_jobSystem.SetSingleThreaded(!updatesInParallel);
+	}
+
+	/// <summary>
+	/// 全てのエフェクトのパーティクルの総数の上限を設定する
+	/// 超えた場合はEffect::SetPriorityの優先度が低いエフェクトから数を減らし,更新を1フレームおきにする
+	/// </summary>
+	/// <param name="particlesMax">上限 0の場合上限を設けない</param>
+	inline void SetParticlesMax(UINT particlesMax)
+	{
+		m_particleBudget.SetParticlesMax(particlesMax);
+	}
+
+	/// <summary>
+	/// 直前の更新で求められたパーティクルの数と実際に動かした数などの統計
+	/// </summary>
+	inline const ParticleBudgetStats& GetParticleBudgetStats() const
+	{
+		return m_particleBudget.GetStats();
+	}
+
+	/// <summary>
+	/// Effect::SetCollidesでtrueにしたエフェクトのパーティクルと衝突する動かない物体
+	/// 物体を変えた場合は次の更新から判定に反映される
+	/// </summary>
+	inline ParticleCollisionWorld& GetParticleCollisionWorld()
+	{
+		return m_particleCollisionWorld;
+	}
+
+	/// <summary>
+	/// エフェクトの描画 描画命令の順番を保つためメインスレッドで追加した順に行う
+	/// 貯めた経過時間の端数から,最後の二回のシミュレーションの状態の間を補間して描画する
 	/// </summary>
 	void Render();
 
 	/// <summary>
-	/// 全てのエフェクトの開放
+	/// 全てのエフェクトとプールの開放
 	/// </summary>
 	void AllRelease();
 
 private:
+	struct EffectSlot
+	{
+	public:
+		Effect* m_pEffect = nullptr;
+
+		//! AddEffectで追加されたものはnullptr
+		IEffectPool* m_pEffectPool = nullptr;
+
+		//! エフェクトを取り除くたびに増やし,古いハンドルを無効にする
+		UINT m_generation = 0;
+	};
+
+	template<typename T>
+	EffectPool<T>* GetEffectPool()
+	{
+		IEffectPool*& rpEffectPool = m_pEffectPools[std::type_index(typeid(T))];
+
+		if (!rpEffectPool) rpEffectPool = new EffectPool<T>();
+
+		return static_cast<EffectPool<T>*>(rpEffectPool);
+	}
+
+	/// <summary>
+	/// 空いている枠にエフェクトを入れる
+	/// </summary>
+	EffectHandle Register(Effect* pEffect, IEffectPool* pEffectPool);
+
+	/// <summary>
+	/// 枠のエフェクトをプールに返すか開放し,枠を空ける
+	/// </summary>
+	void Unregister(UINT slotIndex);
+
 	/// <summary>
 	/// 終了したエフェクトの開放
 	/// </summary>
 	void ReleaseEndEffects();
 
-	std::vector<Effect*> m_pEffects;
+	/// <summary>
+	/// 全てのエフェクトのシミュレーションを一回進める
+	/// </summary>
+	void Step();
+
+	static const UINT m_STEPS_PER_UPDATE_MAX = 5;
+
+	//! シミュレーションを一回進める間隔(秒) エフェクトの速度や生存時間はこの一回あたりの値で作られている
+	static const float m_STEP_TIME_S;
+
+	//! 貯めた経過時間のうちまだシミュレーションを進めていない分
+	float m_accumulatedTime_s = 0.0f;
+
+	std::vector<EffectSlot> m_effectSlots;
+
+	std::vector<UINT> m_freeSlotIndices;
+
+	//! 追加した順に並んだ使用中の枠
+	std::vector<UINT> m_activeSlotIndices;
+
+	//! ParticleBudgetに渡すため毎フレーム使いまわす
+	std::vector<Effect*> m_pActiveEffects;
+
+	std::map<std::type_index, IEffectPool*> m_pEffectPools;
+
+	//! 設定の保持するパーティクルの数などが異なるので,型ではなく設定ごとに分ける
+	std::map<const EffectDesc*, EffectPool<DataDrivenEffect>*> m_pDataDrivenEffectPools;
+
+	//! 読み込んだ設定はAllReleaseの後も保持し続ける
+	EffectDescStorage m_effectDescStorage;
+
+	//! 終了したエフェクトのパーティクルの配列を次のエフェクトで使いまわす
+	ParticleStoragePool m_particleStoragePool;
+
+	ParticleBudget m_particleBudget;
+
+	ParticleCollisionWorld m_particleCollisionWorld;
+
+	//! エフェクトを開放するより後に破棄されるよう最後に置く
+	JobSystem m_jobSystem;
 };
 
 #endif //! EFFECT_MANAGER_H
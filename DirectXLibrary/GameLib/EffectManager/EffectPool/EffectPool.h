@@ -0,0 +1,92 @@
+﻿/// <filename>
+/// EffectPool.h
+/// </filename>
+/// <summary>
+/// 終了したエフェクトを型ごとに保持して使いまわすクラスのヘッダ
+/// </summary>
+
+#ifndef EFFECT_POOL_H
+#define EFFECT_POOL_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <utility>
+
+#include "EffectManager\Effect\Effect.h"
+
+/// <summary>
+/// 型を問わずエフェクトを返すためのインターフェイス
+/// </summary>
+class IEffectPool
+{
+public:
+	virtual ~IEffectPool() {};
+
+	/// <summary>
+	/// 終了したエフェクトを返す 保持しきれない場合は開放する
+	/// </summary>
+	virtual void Release(Effect* pEffect) = 0;
+};
+
+/// <summary>
+/// 終了したエフェクトを型ごとに保持して使いまわすクラス
+/// </summary>
+/// <remarks>
+/// 使いまわす際はコンストラクタと同じ引数でT::Resetを呼ぶので,
+/// TはResetを持ち,その中でEffect::Restartを呼んでからパーティクルを初期化しなければならない
+/// パーティクルの配列とテクスチャはそのまま使うのでヒープの確保は起きない
+/// </remarks>
+template<typename T>
+class EffectPool :public IEffectPool
+{
+public:
+	EffectPool() {};
+
+	~EffectPool()
+	{
+		for (auto i : m_pFreeEffects)
+		{
+			delete i;
+		}
+
+		m_pFreeEffects.clear();
+	}
+
+	/// <summary>
+	/// 保持しているエフェクトがあれば初期化して返し,なければ作成する
+	/// </summary>
+	/// <param name="args">Tのコンストラクタ,T::Resetに渡す引数</param>
+	template<typename... Args>
+	T* Acquire(Args&&... args)
+	{
+		if (m_pFreeEffects.empty()) return new T(std::forward<Args>(args)...);
+
+		T* pEffect = m_pFreeEffects.back();
+		m_pFreeEffects.pop_back();
+
+		pEffect->Reset(std::forward<Args>(args)...);
+
+		return pEffect;
+	}
+
+	void Release(Effect* pEffect) override
+	{
+		if (m_pFreeEffects.size() >= m_FREE_EFFECTS_MAX)
+		{
+			delete pEffect;
+
+			return;
+		}
+
+		m_pFreeEffects.push_back(static_cast<T*>(pEffect));
+	}
+
+private:
+	//! これを超えて返されたエフェクトは保持せず開放する
+	static const size_t m_FREE_EFFECTS_MAX = 64;
+
+	std::vector<T*> m_pFreeEffects;
+};
+
+#endif //! EFFECT_POOL_H
@@ -0,0 +1,99 @@
+﻿/// <filename>
+/// ParticleBudget.cpp
+/// </filename>
+/// <summary>
+/// パーティクルの総数を上限に収めるクラスのソース
+/// </summary>
+
+#include "ParticleBudget.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <algorithm>
+
+#include "EffectManager\Effect\Effect.h"
+
+void ParticleBudget::Apply(const std::vector<Effect*>& rPEffects)
+{
+	m_stats = ParticleBudgetStats();
+
+	m_pSortedEffects.assign(rPEffects.begin(), rPEffects.end());
+
+	//! 同じ優先度では先に追加したものを優先するため順番を保って並べる
+	auto HasHigherPriority = [](const Effect* pLeft, const Effect* pRight)
+	{
+		return pLeft->GetPriority() > pRight->GetPriority();
+	};
+
+	std::stable_sort(m_pSortedEffects.begin(), m_pSortedEffects.end(), HasHigherPriority);
+
+	size_t effectsNum = m_pSortedEffects.size();
+
+	m_requestedNums.resize(effectsNum);
+	m_budgets.assign(effectsNum, 0);
+	m_limits.resize(effectsNum);
+
+	UINT requestedNumsSum = 0;
+
+	for (size_t i = 0; i < effectsNum; ++i)
+	{
+		m_requestedNums[i] = m_pSortedEffects[i]->GetRequestedParticlesNum();
+
+		requestedNumsSum += m_requestedNums[i];
+	}
+
+	m_stats.m_requestedParticlesNum = requestedNumsSum;
+
+	//! 上限がないか収まっている場合は全て求められた数を割り当てる
+	if (m_particlesMax == 0 || requestedNumsSum <= m_particlesMax)
+	{
+		m_budgets = m_requestedNums;
+	}
+	else
+	{
+		UINT remainingNum = m_particlesMax;
+
+		for (size_t i = 0; i < effectsNum; ++i)
+		{
+			m_limits[i] = (std::min)(m_requestedNums[i], m_pSortedEffects[i]->GetMinParticlesNum());
+		}
+
+		Allocate(m_limits, &remainingNum);
+
+		Allocate(m_requestedNums, &remainingNum);
+	}
+
+	for (size_t i = 0; i < effectsNum; ++i)
+	{
+		Effect* pEffect = m_pSortedEffects[i];
+
+		m_stats.m_culledParticlesNum += pEffect->ApplyParticlesBudget(m_budgets[i]);
+
+		if (m_budgets[i] < m_requestedNums[i]) ++m_stats.m_throttledEffectsNum;
+
+		if (pEffect->SkipsUpdate())
+		{
+			++m_stats.m_skippedUpdatesNum;
+
+			continue;
+		}
+
+		m_stats.m_simulatedParticlesNum += pEffect->GetAliveParticlesNum();
+	}
+}
+
+void ParticleBudget::Allocate(const std::vector<UINT>& rLimits, UINT* pRemainingNum)
+{
+	for (size_t i = 0; i < m_budgets.size(); ++i)
+	{
+		if (*pRemainingNum == 0) return;
+
+		if (m_budgets[i] >= rLimits[i]) continue;
+
+		UINT allocatedNum = (std::min)(rLimits[i] - m_budgets[i], *pRemainingNum);
+
+		m_budgets[i]	+= allocatedNum;
+		*pRemainingNum	-= allocatedNum;
+	}
+}
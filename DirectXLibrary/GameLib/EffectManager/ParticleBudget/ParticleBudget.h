@@ -0,0 +1,101 @@
+﻿/// <filename>
+/// ParticleBudget.h
+/// </filename>
+/// <summary>
+/// パーティクルの総数を上限に収めるクラスのヘッダ
+/// </summary>
+
+#ifndef PARTICLE_BUDGET_H
+#define PARTICLE_BUDGET_H
+
+#include <Windows.h>
+
+#include <vector>
+
+#include "EffectManager\Effect\Effect.h"
+
+/// <summary>
+/// 直前のフレームで求められたパーティクルの数と実際に動かした数などの統計
+/// </summary>
+struct ParticleBudgetStats
+{
+public:
+	//! 全てのエフェクトが存在させたいパーティクルの数の合計
+	UINT m_requestedParticlesNum = 0;
+
+	//! 更新を飛ばさなかったエフェクトのパーティクルの数の合計
+	UINT m_simulatedParticlesNum = 0;
+
+	//! 上限を超えたため古いものから消したパーティクルの数
+	UINT m_culledParticlesNum = 0;
+
+	//! 割り当てが足りなかったエフェクトの数
+	UINT m_throttledEffectsNum = 0;
+
+	//! 更新を飛ばしたエフェクトの数
+	UINT m_skippedUpdatesNum = 0;
+};
+
+/// <summary>
+/// パーティクルの総数が上限を超えた際に,優先度の高いエフェクトから数を割り当てるクラス
+/// </summary>
+/// <remarks>
+/// 優先度の順にまず最低限の数を,次に残りの数を割り当てる
+/// 割り当てが足りないエフェクトは古いパーティクルから消され,更新とパーティクルを増やす間隔が1フレームおきになる
+/// 割り当てはフレームの初めに行うので,そのフレームに増えた分だけ上限を超えることがあり,次のフレームで消される
+/// </remarks>
+class ParticleBudget
+{
+public:
+	ParticleBudget() {};
+
+	~ParticleBudget() {};
+
+	/// <summary>
+	/// パーティクルの総数の上限を設定する
+	/// </summary>
+	/// <param name="particlesMax">上限 0の場合上限を設けない</param>
+	inline void SetParticlesMax(UINT particlesMax)
+	{
+		m_particlesMax = particlesMax;
+	}
+
+	inline UINT GetParticlesMax() const
+	{
+		return m_particlesMax;
+	}
+
+	/// <summary>
+	/// エフェクトにパーティクルの数を割り当て,統計を更新する 更新の前に毎フレーム呼ぶ
+	/// </summary>
+	/// <param name="rPEffects">[in]追加した順に並んだ終了していないエフェクト</param>
+	void Apply(const std::vector<Effect*>& rPEffects);
+
+	inline const ParticleBudgetStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+private:
+	/// <summary>
+	/// 優先度の順に並べたエフェクトに,割り当て済みの数がrLimitsに達するまで割り当てる
+	/// </summary>
+	/// <param name="rLimits">[in]エフェクトごとの割り当ての最大</param>
+	/// <param name="pRemainingNum">[in,out]割り当てられる残りの数</param>
+	void Allocate(const std::vector<UINT>& rLimits, UINT* pRemainingNum);
+
+	UINT m_particlesMax = 0;
+
+	ParticleBudgetStats m_stats;
+
+	//! 以下は毎フレーム使いまわす作業用 m_pSortedEffectsと同じ順に並ぶ
+	std::vector<Effect*> m_pSortedEffects;
+
+	std::vector<UINT> m_requestedNums;
+
+	std::vector<UINT> m_budgets;
+
+	std::vector<UINT> m_limits;
+};
+
+#endif //! PARTICLE_BUDGET_H
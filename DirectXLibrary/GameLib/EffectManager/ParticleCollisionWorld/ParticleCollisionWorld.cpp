@@ -0,0 +1,404 @@
+﻿/// <filename>
+/// ParticleCollisionWorld.cpp
+/// </filename>
+/// <summary>
+/// パーティクルと衝突する動かない物体をまとめたクラスのソース
+/// </summary>
+
+#include "ParticleCollisionWorld.h"
+
+#include <Windows.h>
+#include <math.h>
+
+#include <vector>
+#include <algorithm>
+
+#include <d3dx9.h>
+
+#include "Algorithm\Algorithm.h"
+
+using Algorithm::D3DXVec2Cross;
+
+const float ParticleCollisionWorld::m_PARALLEL_EPSILON = 1.0e-6f;
+
+const float ParticleCollisionWorld::m_SEGMENT_SKIN = 0.01f;
+
+void ParticleCollisionWorld::AddRect(const D3DXVECTOR2& topLeft, const D3DXVECTOR2& bottomRight, ParticleCollider::RESPONSE response, float restitution)
+{
+	ParticleCollider collider;
+	collider.m_shape		= ParticleCollider::SHAPE::RECT;
+	collider.m_response		= response;
+	collider.m_a			= topLeft;
+	collider.m_b			= bottomRight;
+	collider.m_restitution	= restitution;
+
+	Add(collider);
+}
+
+void ParticleCollisionWorld::AddCircle(const D3DXVECTOR2& center, float radius, ParticleCollider::RESPONSE response, float restitution)
+{
+	ParticleCollider collider;
+	collider.m_shape		= ParticleCollider::SHAPE::CIRCLE;
+	collider.m_response		= response;
+	collider.m_a			= center;
+	collider.m_radius		= radius;
+	collider.m_restitution	= restitution;
+
+	Add(collider);
+}
+
+void ParticleCollisionWorld::AddSegment(const D3DXVECTOR2& begin, const D3DXVECTOR2& end, ParticleCollider::RESPONSE response, float restitution)
+{
+	ParticleCollider collider;
+	collider.m_shape		= ParticleCollider::SHAPE::SEGMENT;
+	collider.m_response		= response;
+	collider.m_a			= begin;
+	collider.m_b			= end;
+	collider.m_restitution	= restitution;
+
+	Add(collider);
+}
+
+void ParticleCollisionWorld::SetViewportBounds(const D3DXVECTOR2& size, ParticleCollider::RESPONSE response, float restitution)
+{
+	m_viewportBounds.m_shape		= ParticleCollider::SHAPE::BOUNDS;
+	m_viewportBounds.m_response		= response;
+	m_viewportBounds.m_a			= { 0.0f, 0.0f };
+	m_viewportBounds.m_b			= size;
+	m_viewportBounds.m_restitution	= restitution;
+
+	m_hasViewportBounds = true;
+}
+
+void ParticleCollisionWorld::Clear()
+{
+	m_colliders.clear();
+
+	m_isDirty = true;
+}
+
+void ParticleCollisionWorld::Build()
+{
+	if (!m_isDirty) return;
+
+	m_isDirty = false;
+
+	m_largeColliderIndices.clear();
+
+	//! 物体ごとに重複なくバケットを求め,m_workBucketsに入れる 格子に入れない物体はfalse
+	auto CollectBuckets = [this](const ParticleCollider& rCollider)
+	{
+		int minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+		GetCellRange(rCollider, &minX, &minY, &maxX, &maxY);
+
+		m_workBuckets.clear();
+
+		if (static_cast<LONGLONG>(maxX - minX + 1) * (maxY - minY + 1) > m_CELLS_PER_COLLIDER_MAX) return false;
+
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				m_workBuckets.push_back(ToBucket(x, y));
+			}
+		}
+
+		std::sort(m_workBuckets.begin(), m_workBuckets.end());
+		m_workBuckets.erase(std::unique(m_workBuckets.begin(), m_workBuckets.end()), m_workBuckets.end());
+
+		return true;
+	};
+
+	//! バケットの数は格子に入る数を元に決めるので,先に格子の数だけ数える
+	size_t cellsNum = 0;
+
+	for (const auto& rCollider : m_colliders)
+	{
+		int minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+		GetCellRange(rCollider, &minX, &minY, &maxX, &maxY);
+
+		LONGLONG colliderCellsNum = static_cast<LONGLONG>(maxX - minX + 1) * (maxY - minY + 1);
+
+		if (colliderCellsNum <= m_CELLS_PER_COLLIDER_MAX) cellsNum += static_cast<size_t>(colliderCellsNum);
+	}
+
+	m_bucketsNum = 16;
+
+	while (m_bucketsNum < cellsNum * 2) m_bucketsNum <<= 1;
+
+	m_bucketBegins.assign(m_bucketsNum + 1, 0);
+
+	for (UINT i = 0; i < m_colliders.size(); ++i)
+	{
+		if (!CollectBuckets(m_colliders[i]))
+		{
+			m_largeColliderIndices.push_back(i);
+
+			continue;
+		}
+
+		for (auto bucket : m_workBuckets)
+		{
+			++m_bucketBegins[bucket + 1];
+		}
+	}
+
+	for (UINT i = 0; i < m_bucketsNum; ++i)
+	{
+		m_bucketBegins[i + 1] += m_bucketBegins[i];
+	}
+
+	m_bucketColliderIndices.resize(m_bucketBegins[m_bucketsNum]);
+
+	//! 詰める位置を進めるため,各バケットの先頭を写しておく
+	std::vector<UINT> bucketEnds(m_bucketBegins.begin(), m_bucketBegins.end() - 1);
+
+	for (UINT i = 0; i < m_colliders.size(); ++i)
+	{
+		if (!CollectBuckets(m_colliders[i])) continue;
+
+		for (auto bucket : m_workBuckets)
+		{
+			m_bucketColliderIndices[bucketEnds[bucket]++] = i;
+		}
+	}
+}
+
+bool ParticleCollisionWorld::Collide(const D3DXVECTOR2& prevCenter, D3DXVECTOR2* pCenter, D3DXVECTOR2* pVelocity, ParticleCollider::RESPONSE* pResponse) const
+{
+	if (!m_bucketBegins.empty())
+	{
+		UINT bucket = ToBucket(ToCell(pCenter->x), ToCell(pCenter->y));
+
+		for (UINT i = m_bucketBegins[bucket]; i < m_bucketBegins[bucket + 1]; ++i)
+		{
+			const ParticleCollider& rCollider = m_colliders[m_bucketColliderIndices[i]];
+
+			if (!CollideWith(rCollider, prevCenter, pCenter, pVelocity)) continue;
+
+			*pResponse = rCollider.m_response;
+
+			return true;
+		}
+	}
+
+	for (auto i : m_largeColliderIndices)
+	{
+		const ParticleCollider& rCollider = m_colliders[i];
+
+		if (!CollideWith(rCollider, prevCenter, pCenter, pVelocity)) continue;
+
+		*pResponse = rCollider.m_response;
+
+		return true;
+	}
+
+	if (m_hasViewportBounds && CollideWith(m_viewportBounds, prevCenter, pCenter, pVelocity))
+	{
+		*pResponse = m_viewportBounds.m_response;
+
+		return true;
+	}
+
+	return false;
+}
+
+bool ParticleCollisionWorld::CollideWith(const ParticleCollider& rCollider, const D3DXVECTOR2& prevCenter, D3DXVECTOR2* pCenter, D3DXVECTOR2* pVelocity)
+{
+	D3DXVECTOR2& rCenter = *pCenter;
+	const D3DXVECTOR2& rA = rCollider.m_a;
+	const D3DXVECTOR2& rB = rCollider.m_b;
+
+	D3DXVECTOR2 normal(0.0f, 0.0f);
+
+	switch (rCollider.m_shape)
+	{
+	case ParticleCollider::SHAPE::RECT:
+	{
+		if (rCenter.x <= rA.x || rCenter.x >= rB.x || rCenter.y <= rA.y || rCenter.y >= rB.y) return false;
+
+		float toLeft	= rCenter.x - rA.x;
+		float toRight	= rB.x - rCenter.x;
+		float toTop		= rCenter.y - rA.y;
+		float toBottom	= rB.y - rCenter.y;
+
+		float nearest = (std::min)((std::min)(toLeft, toRight), (std::min)(toTop, toBottom));
+
+		if (nearest == toLeft)
+		{
+			rCenter.x = rA.x;
+			normal.x = -1.0f;
+		}
+		else if (nearest == toRight)
+		{
+			rCenter.x = rB.x;
+			normal.x = 1.0f;
+		}
+		else if (nearest == toTop)
+		{
+			rCenter.y = rA.y;
+			normal.y = -1.0f;
+		}
+		else
+		{
+			rCenter.y = rB.y;
+			normal.y = 1.0f;
+		}
+
+		break;
+	}
+
+	case ParticleCollider::SHAPE::CIRCLE:
+	{
+		D3DXVECTOR2 fromCenter = rCenter - rA;
+
+		float distanceSq = D3DXVec2LengthSq(&fromCenter);
+
+		if (distanceSq >= rCollider.m_radius * rCollider.m_radius) return false;
+
+		//! 中心に重なった場合は上へ押し出す
+		normal = (distanceSq > 0.0f) ? fromCenter / sqrtf(distanceSq) : D3DXVECTOR2(0.0f, -1.0f);
+
+		rCenter = rA + normal * rCollider.m_radius;
+
+		break;
+	}
+
+	case ParticleCollider::SHAPE::SEGMENT:
+	{
+		//! 前回の位置から今回の位置までの移動が線分と交わるか
+		D3DXVECTOR2 move	= rCenter - prevCenter;
+		D3DXVECTOR2 segment	= rB - rA;
+
+		float denominator = D3DXVec2Cross(move, segment);
+
+		if (fabsf(denominator) < m_PARALLEL_EPSILON) return false;
+
+		D3DXVECTOR2 toBegin = rA - prevCenter;
+
+		float moveRatio		= D3DXVec2Cross(toBegin, segment) / denominator;
+		float segmentRatio	= D3DXVec2Cross(toBegin, move) / denominator;
+
+		if (moveRatio < 0.0f || moveRatio > 1.0f || segmentRatio < 0.0f || segmentRatio > 1.0f) return false;
+
+		D3DXVECTOR2 segmentNormal(-segment.y, segment.x);
+		D3DXVec2Normalize(&normal, &segmentNormal);
+
+		//! 前回の位置の側を向かせる
+		if (D3DXVec2Dot(&normal, &move) > 0.0f) normal = -normal;
+
+		//! 交点にぴったり置くと次の判定で反対側にいるとみなされかねないので,少しだけ離す
+		rCenter = prevCenter + move * moveRatio + normal * m_SEGMENT_SKIN;
+
+		break;
+	}
+
+	case ParticleCollider::SHAPE::BOUNDS:
+	{
+		if (rCenter.x < rA.x)
+		{
+			rCenter.x = rA.x;
+			normal.x = 1.0f;
+		}
+		else if (rCenter.x > rB.x)
+		{
+			rCenter.x = rB.x;
+			normal.x = -1.0f;
+		}
+
+		if (rCenter.y < rA.y)
+		{
+			rCenter.y = rA.y;
+			normal.y = 1.0f;
+		}
+		else if (rCenter.y > rB.y)
+		{
+			rCenter.y = rB.y;
+			normal.y = -1.0f;
+		}
+
+		if (normal.x == 0.0f && normal.y == 0.0f) return false;
+
+		//! 角から出た場合は斜めに押し戻す
+		D3DXVec2Normalize(&normal, &normal);
+
+		break;
+	}
+
+	default:
+		return false;
+	}
+
+	Respond(rCollider, normal, pVelocity);
+
+	return true;
+}
+
+void ParticleCollisionWorld::Respond(const ParticleCollider& rCollider, const D3DXVECTOR2& normal, D3DXVECTOR2* pVelocity)
+{
+	switch (rCollider.m_response)
+	{
+	case ParticleCollider::RESPONSE::BOUNCE:
+	{
+		float speedToSurface = D3DXVec2Dot(pVelocity, &normal);
+
+		//! 既に離れる向きに動いている場合はそのままにする
+		if (speedToSurface >= 0.0f) break;
+
+		*pVelocity -= normal * ((1.0f + rCollider.m_restitution) * speedToSurface);
+
+		break;
+	}
+
+	case ParticleCollider::RESPONSE::STICK:
+		*pVelocity = { 0.0f, 0.0f };
+
+		break;
+
+	default:
+		break;
+	}
+}
+
+void ParticleCollisionWorld::Add(const ParticleCollider& rCollider)
+{
+	m_colliders.push_back(rCollider);
+
+	m_isDirty = true;
+}
+
+void ParticleCollisionWorld::GetCellRange(const ParticleCollider& rCollider, int* pMinX, int* pMinY, int* pMaxX, int* pMaxY) const
+{
+	D3DXVECTOR2 rangeMin(0.0f, 0.0f);
+	D3DXVECTOR2 rangeMax(0.0f, 0.0f);
+
+	switch (rCollider.m_shape)
+	{
+	case ParticleCollider::SHAPE::CIRCLE:
+		rangeMin = rCollider.m_a - D3DXVECTOR2(rCollider.m_radius, rCollider.m_radius);
+		rangeMax = rCollider.m_a + D3DXVECTOR2(rCollider.m_radius, rCollider.m_radius);
+
+		break;
+
+	default:
+		rangeMin = { (std::min)(rCollider.m_a.x, rCollider.m_b.x), (std::min)(rCollider.m_a.y, rCollider.m_b.y) };
+		rangeMax = { (std::max)(rCollider.m_a.x, rCollider.m_b.x), (std::max)(rCollider.m_a.y, rCollider.m_b.y) };
+
+		break;
+	}
+
+	*pMinX = ToCell(rangeMin.x);
+	*pMinY = ToCell(rangeMin.y);
+	*pMaxX = ToCell(rangeMax.x);
+	*pMaxY = ToCell(rangeMax.y);
+
+	//! 線分は横切った後の位置で探されるので,1フレームに動く距離の分だけ広げておく
+	if (rCollider.m_shape != ParticleCollider::SHAPE::SEGMENT) return;
+
+	--(*pMinX);
+	--(*pMinY);
+	++(*pMaxX);
+	++(*pMaxY);
+}
@@ -0,0 +1,210 @@
+﻿/// <filename>
+/// ParticleCollisionWorld.h
+/// </filename>
+/// <summary>
+/// パーティクルと衝突する動かない物体をまとめたクラスのヘッダ
+/// </summary>
+
+#ifndef PARTICLE_COLLISION_WORLD_H
+#define PARTICLE_COLLISION_WORLD_H
+
+#include <Windows.h>
+
+#include <math.h>
+
+#include <vector>
+
+#include <d3dx9.h>
+
+/// <summary>
+/// パーティクルと衝突する動かない物体一つ分
+/// </summary>
+struct ParticleCollider
+{
+public:
+	enum class SHAPE : BYTE
+	{
+		//! m_aが左上 m_bが右下 中に入ったパーティクルを一番近い辺から押し出す
+		RECT,
+
+		//! m_aが中心 m_radiusが半径 中に入ったパーティクルを外へ押し出す
+		CIRCLE,
+
+		//! m_aが始点 m_bが終点 前回の位置から横切ったパーティクルを交点で止める
+		SEGMENT,
+
+		//! m_aが左上 m_bが右下 外に出たパーティクルを内側へ押し戻す
+		BOUNDS,
+	};
+
+	/// <summary>
+	/// 衝突したパーティクルをどうするか
+	/// </summary>
+	enum class RESPONSE : BYTE
+	{
+		//! 面に沿った速度は残し,面に向かう速度をm_restitution倍して反転させる
+		BOUNCE,
+
+		//! 速度を0にして面に留める
+		STICK,
+
+		//! パーティクルを消す
+		KILL,
+	};
+
+	SHAPE m_shape = SHAPE::RECT;
+
+	RESPONSE m_response = RESPONSE::BOUNCE;
+
+	D3DXVECTOR2 m_a = { 0.0f, 0.0f };
+
+	D3DXVECTOR2 m_b = { 0.0f, 0.0f };
+
+	float m_radius = 0.0f;
+
+	//! 反発係数 BOUNCEの場合のみ用いる
+	float m_restitution = 1.0f;
+};
+
+/// <summary>
+/// パーティクルと衝突する動かない物体を一様な格子の空間ハッシュに入れて保持するクラス
+/// </summary>
+/// <remarks>
+/// パーティクルは中心の点として扱い,z座標は無視する
+/// パーティクルごとに同じ格子に入っている物体とだけ判定するので,物体が増えても一つ当たりの負荷はほぼ変わらない
+/// 格子を多く覆う大きな物体と画面の範囲は格子に入れず,全てのパーティクルと判定する
+/// 物体を変えた後はBuildを呼ぶまで判定に反映されない EffectManagerが更新の前にメインスレッドで呼ぶ
+/// </remarks>
+class ParticleCollisionWorld
+{
+public:
+	ParticleCollisionWorld() {};
+
+	~ParticleCollisionWorld() {};
+
+	/// <param name="topLeft">左上の座標</param>
+	/// <param name="bottomRight">右下の座標</param>
+	/// <param name="response">衝突したパーティクルをどうするか</param>
+	/// <param name="restitution">反発係数 BOUNCEの場合のみ用いる</param>
+	void AddRect(const D3DXVECTOR2& topLeft, const D3DXVECTOR2& bottomRight, ParticleCollider::RESPONSE response, float restitution = 1.0f);
+
+	void AddCircle(const D3DXVECTOR2& center, float radius, ParticleCollider::RESPONSE response, float restitution = 1.0f);
+
+	void AddSegment(const D3DXVECTOR2& begin, const D3DXVECTOR2& end, ParticleCollider::RESPONSE response, float restitution = 1.0f);
+
+	/// <summary>
+	/// 画面の範囲から出たパーティクルを衝突させる KILLにすると画面外に出たパーティクルを消せる
+	/// </summary>
+	/// <param name="size">画面の大きさ 左上は原点</param>
+	void SetViewportBounds(const D3DXVECTOR2& size, ParticleCollider::RESPONSE response, float restitution = 1.0f);
+
+	inline void DisableViewportBounds()
+	{
+		m_hasViewportBounds = false;
+	}
+
+	/// <summary>
+	/// 画面の範囲以外の全ての物体を取り除く
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 格子一つの大きさを設定する パーティクルが1フレームに動く距離より大きく,物体と同程度がよい
+	/// </summary>
+	/// <param name="cellSize">大きさ 0以下の場合は何もしない</param>
+	/// <remarks>設定していなかった場合64</remarks>
+	inline void SetCellSize(float cellSize)
+	{
+		if (cellSize <= 0.0f) return;
+
+		m_cellSize		= cellSize;
+		m_isDirty		= true;
+	}
+
+	/// <summary>
+	/// 物体を変えていれば空間ハッシュを作りなおす 判定と並列に呼んではいけない
+	/// </summary>
+	void Build();
+
+	/// <summary>
+	/// 判定する物体が一つもないか
+	/// </summary>
+	inline bool IsEmpty() const
+	{
+		return m_colliders.empty() && !m_hasViewportBounds;
+	}
+
+	/// <summary>
+	/// パーティクル一つを物体と判定し,衝突していれば位置と速度を書き換える 複数のスレッドから同時に呼べる
+	/// </summary>
+	/// <param name="prevCenter">前回の中心 線分を横切ったかの判定に用いる</param>
+	/// <param name="pCenter">[in,out]速度で動かした後の中心</param>
+	/// <param name="pVelocity">[in,out]このフレームに動かした速度</param>
+	/// <param name="pResponse">[out]衝突した物体の衝突したパーティクルをどうするか</param>
+	/// <returns>衝突した場合true 一度に衝突させるのは最初に見つかった一つだけ</returns>
+	bool Collide(const D3DXVECTOR2& prevCenter, D3DXVECTOR2* pCenter, D3DXVECTOR2* pVelocity, ParticleCollider::RESPONSE* pResponse) const;
+
+private:
+	/// <summary>
+	/// 物体一つと判定し,衝突していれば位置と速度を書き換える
+	/// </summary>
+	static bool CollideWith(const ParticleCollider& rCollider, const D3DXVECTOR2& prevCenter, D3DXVECTOR2* pCenter, D3DXVECTOR2* pVelocity);
+
+	/// <summary>
+	/// 面に押し出した後の速度を衝突した物体に合わせて変える
+	/// </summary>
+	/// <param name="normal">面の外向きの単位ベクトル</param>
+	static void Respond(const ParticleCollider& rCollider, const D3DXVECTOR2& normal, D3DXVECTOR2* pVelocity);
+
+	void Add(const ParticleCollider& rCollider);
+
+	/// <summary>
+	/// 物体を覆う範囲を格子の添え字で求める
+	/// </summary>
+	void GetCellRange(const ParticleCollider& rCollider, int* pMinX, int* pMinY, int* pMaxX, int* pMaxY) const;
+
+	inline int ToCell(float coordinate) const
+	{
+		return static_cast<int>(floorf(coordinate / m_cellSize));
+	}
+
+	inline UINT ToBucket(int cellX, int cellY) const
+	{
+		return ((static_cast<UINT>(cellX) * 73856093u) ^ (static_cast<UINT>(cellY) * 19349663u)) & (m_bucketsNum - 1);
+	}
+
+	//! これより多くの格子を覆う物体は格子に入れない
+	static const int m_CELLS_PER_COLLIDER_MAX = 64;
+
+	//! 移動と線分の外積がこれより小さい場合は平行とみなす
+	static const float m_PARALLEL_EPSILON;
+
+	//! 線分で止めたパーティクルを線分から離す距離
+	static const float m_SEGMENT_SKIN;
+
+	std::vector<ParticleCollider> m_colliders;
+
+	ParticleCollider m_viewportBounds;
+
+	bool m_hasViewportBounds = false;
+
+	float m_cellSize = 64.0f;
+
+	bool m_isDirty = false;
+
+	//! 2の累乗
+	UINT m_bucketsNum = 1;
+
+	//! バケットごとの物体の添え字をまとめて並べ,m_bucketBegins[i]からm_bucketBegins[i + 1]までがバケットiのもの
+	std::vector<UINT> m_bucketBegins;
+
+	std::vector<UINT> m_bucketColliderIndices;
+
+	//! 格子に入れずに全てのパーティクルと判定する物体の添え字
+	std::vector<UINT> m_largeColliderIndices;
+
+	//! Buildで一つの物体が入るバケットを重複なく求める際の作業用
+	std::vector<UINT> m_workBuckets;
+};
+
+#endif //! PARTICLE_COLLISION_WORLD_H
@@ -0,0 +1,83 @@
+﻿/// <filename>
+/// ParticleStoragePool.cpp
+/// </filename>
+/// <summary>
+/// エフェクトが使い終わったパーティクルの配列を使いまわすクラスのソース
+/// </summary>
+
+#include "ParticleStoragePool.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <random>
+
+#include "EffectManager\Effect\ParticleStorage\ParticleStorage.h"
+
+ParticleStoragePool::ParticleStoragePool()
+{
+	std::random_device randDevForSeed;
+	m_seedEngine.seed(randDevForSeed());
+}
+
+ParticleStorage* ParticleStoragePool::Acquire(UINT capacity)
+{
+	//! 大きすぎる配列を渡さないよう,足りる中で一番小さいものを選ぶ
+	size_t bestIndex = m_pFreeStorages.size();
+
+	for (size_t i = 0; i < m_pFreeStorages.size(); ++i)
+	{
+		UINT freeCapacity = m_pFreeStorages[i]->GetCapacity();
+
+		if (freeCapacity < capacity) continue;
+
+		if (bestIndex != m_pFreeStorages.size() && freeCapacity >= m_pFreeStorages[bestIndex]->GetCapacity()) continue;
+
+		bestIndex = i;
+	}
+
+	ParticleStorage* pParticleStorage = nullptr;
+
+	if (bestIndex != m_pFreeStorages.size())
+	{
+		pParticleStorage = m_pFreeStorages[bestIndex];
+
+		m_pFreeStorages[bestIndex] = m_pFreeStorages.back();
+		m_pFreeStorages.pop_back();
+	}
+	else
+	{
+		pParticleStorage = new ParticleStorage(capacity);
+	}
+
+	pParticleStorage->Seed(m_seedEngine());
+
+	return pParticleStorage;
+}
+
+void ParticleStoragePool::Release(ParticleStorage* pParticleStorage)
+{
+	if (!pParticleStorage) return;
+
+	if (m_pFreeStorages.size() >= m_FREE_STORAGES_MAX)
+	{
+		delete pParticleStorage;
+
+		return;
+	}
+
+	pParticleStorage->Clear();
+
+	m_pFreeStorages.push_back(pParticleStorage);
+}
+
+void ParticleStoragePool::AllRelease()
+{
+	for (auto i : m_pFreeStorages)
+	{
+		delete i;
+	}
+
+	m_pFreeStorages.clear();
+	m_pFreeStorages.shrink_to_fit();
+}
@@ -0,0 +1,60 @@
+﻿/// <filename>
+/// ParticleStoragePool.h
+/// </filename>
+/// <summary>
+/// エフェクトが使い終わったパーティクルの配列を使いまわすクラスのヘッダ
+/// </summary>
+
+#ifndef PARTICLE_STORAGE_POOL_H
+#define PARTICLE_STORAGE_POOL_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <random>
+
+#include "EffectManager\Effect\ParticleStorage\ParticleStorage.h"
+
+/// <summary>
+/// エフェクトが使い終わったパーティクルの配列を保持し,次に作られるエフェクトに渡すクラス
+/// </summary>
+/// <remarks>
+/// 乱数のシードもここで作成するので,random_deviceはこのクラスの作成時に一度だけ使う
+/// </remarks>
+class ParticleStoragePool
+{
+public:
+	ParticleStoragePool();
+
+	~ParticleStoragePool()
+	{
+		AllRelease();
+	}
+
+	/// <summary>
+	/// 最大数が引数以上の配列を取得する なければ作成する
+	/// </summary>
+	/// <param name="capacity">必要なパーティクルの最大数</param>
+	/// <returns>パーティクルが一つもない状態の配列</returns>
+	ParticleStorage* Acquire(UINT capacity);
+
+	/// <summary>
+	/// 使い終わった配列を返す
+	/// </summary>
+	void Release(ParticleStorage* pParticleStorage);
+
+	/// <summary>
+	/// 保持している配列を全て開放する
+	/// </summary>
+	void AllRelease();
+
+private:
+	//! これを超えて返された配列は保持せず開放する
+	static const size_t m_FREE_STORAGES_MAX = 32;
+
+	std::vector<ParticleStorage*> m_pFreeStorages;
+
+	std::minstd_rand m_seedEngine;
+};
+
+#endif //! PARTICLE_STORAGE_POOL_H
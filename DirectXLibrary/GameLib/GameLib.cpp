@@ -63,7 +63,7 @@ void GameLib::RunFunc(void(*pMainFunc)())
 
 		pMainFunc();
 
-		m_pEffectManager->Update();
+		m_pEffectManager->Update(m_rTimerManager.DeltaTime_s());
 		m_pEffectManager->Render();
 
 		m_pDX->CleanUpMessageLoop();
@@ -16,6 +16,8 @@
 #include "CustomVertex.h"
 #include "VerticesParam.h"
 #include "DX\DX3D\FbxStorage\FbxStorage.h"
+#include "DX\DX3D\ColorBlender\ColorBlender.h"
+#include "DX\DX3D\TexStorage\TexStorage.h"
 #include "3DBoard\3DBoard.h"
 #include "Wnd/Data/RectSize.h"
 
@@ -101,8 +103,9 @@ public:
 	* @brief テクスチャを作成する
 	* @param pTexKey テクスチャにつける名前のポインタ キー 連想配列
 	* @param pTexPath 画像のパスのポインタ
+	* @return テクスチャのハンドル 既に作成されている場合はそのハンドル 作成できなかった場合何も指さない
 	*/
-	virtual void CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath) = 0;
+	virtual TexHandle CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath) = 0;
 
 	/**
 	* @brief 全てのテクスチャの開放
@@ -122,6 +125,19 @@ public:
 	*/
 	virtual const LPDIRECT3DTEXTURE9 GetTex(const TCHAR* pTexKey) const = 0;
 
+	/// <summary>
+	/// テクスチャのハンドルを取得する 毎フレーム描画するものは一度取得したハンドルを使い続ける
+	/// </summary>
+	/// <param name="pTexKey">[in]テクスチャを作るときに決めたキー</param>
+	/// <returns>作成されていない場合何も指さない</returns>
+	virtual TexHandle GetTexHandle(const TCHAR* pTexKey) const = 0;
+
+	/// <summary>
+	/// ハンドルの指すテクスチャを取得する キーで取得するより速い
+	/// </summary>
+	/// <returns>何も指さないか,指していたテクスチャが開放されている場合nullptr</returns>
+	virtual const LPDIRECT3DTEXTURE9 GetTex(TexHandle texHandle) const = 0;
+
 	/**
 	* @brief テクスチャが生成されているか判断する
 	* @param pTexKey テクスチャを作るときに決めたキーのポインタ
@@ -379,6 +395,19 @@ public:
 	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
 	virtual void Render(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const = 0;
 
+	/// <summary>
+	/// 矩形の描画命令を積む 描画の終了宣言の前に並べ替えられ,まとめて描画される
+	/// </summary>
+	/// <param name="verticesParam">頂点情報配列を作成するためのデータ</param>
+	/// <param name="pTexture">矩形に張り付けるテクスチャのポインタ</param>
+	/// <param name="blendMode">矩形を描画する際の色の合成</param>
+	/// <param name="layer">描画する層 大きいほど後に描画される</param>
+	virtual void Submit(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const = 0;
+
+	virtual void Submit(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const = 0;
+
 	/// <summary>
 	/// FBXオブジェクトの作成を行う
 	/// </summary>
@@ -0,0 +1,401 @@
+﻿/// <filename>
+/// RecordingRenderer.cpp
+/// </filename>
+/// <summary>
+/// 描画命令を記録するだけのIGameLibRendererの実装のソース
+/// </summary>
+
+#include "RecordingRenderer.h"
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <climits>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+
+#include <d3dx9.h>
+
+#include "SimdMath\SimdMath.h"
+#include "IGameLibRenderer\IGameLibRenderer.h"
+#include "DX\DX3D\CustomVertexEditor\CustomVertexEditor.h"
+#include "CustomVertex.h"
+#include "VerticesParam.h"
+#include "DX\DX3D\FbxStorage\FbxStorage.h"
+#include "3DBoard\3DBoard.h"
+#include "Wnd/Data/RectSize.h"
+
+RecordingRenderer::RecordingRenderer(const RectSize& wndSize)
+	:m_wndSize(wndSize), m_pCustomVertex(new CustomVertexEditor(nullptr))
+{
+}
+
+RecordingRenderer::~RecordingRenderer()
+{
+	for (auto pI : m_pFbxRelatedMap)
+	{
+		if (!pI.second) continue;
+
+		pI.second->Release();
+
+		delete pI.second;
+	}
+
+	delete m_pCustomVertex;
+}
+
+void RecordingRenderer::ClearCommands()
+{
+	m_commands.clear();
+
+	m_stats = RecordingStats();
+
+	m_prevDrawTexId = UINT_MAX;
+}
+
+void RecordingRenderer::DefaultBlendMode() const
+{
+	WriteStateChange(COMMAND::DEFAULT_BLEND_MODE);
+}
+
+void RecordingRenderer::AddtionBlendMode() const
+{
+	WriteStateChange(COMMAND::ADDTION_BLEND_MODE);
+}
+
+void RecordingRenderer::DefaultColorBlending() const
+{
+	WriteStateChange(COMMAND::DEFAULT_COLOR_BLENDING);
+}
+
+void RecordingRenderer::SetLight(const D3DLIGHT9& rLight, DWORD index) const
+{
+	WriteStateChange(COMMAND::SET_LIGHT);
+	Write(index);
+	Write(rLight);
+}
+
+void RecordingRenderer::OnLight(DWORD index) const
+{
+	WriteStateChange(COMMAND::ON_LIGHT);
+	Write(index);
+}
+
+void RecordingRenderer::OffLight(DWORD index) const
+{
+	WriteStateChange(COMMAND::OFF_LIGHT);
+	Write(index);
+}
+
+void RecordingRenderer::EnableLighting() const
+{
+	WriteStateChange(COMMAND::ENABLE_LIGHTING);
+}
+
+void RecordingRenderer::DisableLighting() const
+{
+	WriteStateChange(COMMAND::DISABLE_LIGHTING);
+}
+
+void RecordingRenderer::ChangeAmbientIntensity(DWORD aRGB) const
+{
+	WriteStateChange(COMMAND::CHANGE_AMBIENT);
+	Write(aRGB);
+}
+
+void RecordingRenderer::EnableSpecular() const
+{
+	WriteStateChange(COMMAND::ENABLE_SPECULAR);
+}
+
+void RecordingRenderer::DisaableSpecular() const
+{
+	WriteStateChange(COMMAND::DISABLE_SPECULAR);
+}
+
+void RecordingRenderer::DefaultLighting() const
+{
+	WriteStateChange(COMMAND::DEFAULT_LIGHTING);
+}
+
+TexHandle RecordingRenderer::CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath)
+{
+	//! 同じキーで作り直した場合も番号は変えない
+	UINT& rTexId = m_texIds[pTexKey];
+
+	if (rTexId == 0)
+	{
+		rTexId = m_nextTexId++;
+
+		m_aliveTexIds.insert(rTexId);
+	}
+
+	Write(COMMAND::CREATE_TEX);
+	Write(rTexId);
+	Write(pTexPath);
+
+	return TexHandle(rTexId, 1);
+}
+
+void RecordingRenderer::AllTexRelease()
+{
+	m_texIds.clear();
+	m_aliveTexIds.clear();
+
+	Write(COMMAND::ALL_TEX_RELEASE);
+}
+
+void RecordingRenderer::ReleaseTex(const TCHAR* pTexKey)
+{
+	auto texId = m_texIds.find(pTexKey);
+
+	if (texId == m_texIds.end()) return;
+
+	Write(COMMAND::RELEASE_TEX);
+	Write(texId->second);
+
+	m_aliveTexIds.erase(texId->second);
+	m_texIds.erase(texId);
+}
+
+const LPDIRECT3DTEXTURE9 RecordingRenderer::GetTex(const TCHAR* pTexKey) const
+{
+	auto texId = m_texIds.find(pTexKey);
+
+	if (texId == m_texIds.end()) return nullptr;
+
+	return ToHandle<LPDIRECT3DTEXTURE9>(texId->second);
+}
+
+TexHandle RecordingRenderer::GetTexHandle(const TCHAR* pTexKey) const
+{
+	auto texId = m_texIds.find(pTexKey);
+
+	if (texId == m_texIds.end()) return TexHandle();
+
+	return TexHandle(texId->second, 1);
+}
+
+const LPDIRECT3DTEXTURE9 RecordingRenderer::GetTex(TexHandle texHandle) const
+{
+	if (m_aliveTexIds.find(texHandle.GetIndex()) == m_aliveTexIds.end()) return nullptr;
+
+	return ToHandle<LPDIRECT3DTEXTURE9>(texHandle.GetIndex());
+}
+
+void RecordingRenderer::SetCameraTransform()
+{
+	m_view = SimdMath::LookAtLH(m_cameraPos, m_eyePoint, m_cameraOverhead);
+
+	float aspect = static_cast<float>(m_wndSize.m_x) / static_cast<float>(m_wndSize.m_y);
+
+	const float DEFAULT_EYE_DEGREE = 60.0f;
+
+	const float DEFAULT_NEAR	= 0.01f;
+	const float DEFAULT_FAR		= 10000.0f;
+
+	m_projection = SimdMath::PerspectiveFovLH(SimdMath::ToRadian(DEFAULT_EYE_DEGREE), aspect, DEFAULT_NEAR, DEFAULT_FAR);
+
+	WriteStateChange(COMMAND::SET_CAMERA_TRANSFORM);
+	Write(m_view);
+	Write(m_projection);
+}
+
+void RecordingRenderer::TransBillBoard(D3DXMATRIX* pWorld) const
+{
+	SimdMath::Mat4 viewInverse = SimdMath::Inverse(m_view);
+
+	viewInverse.m[3][0] = viewInverse.m[3][1] = viewInverse.m[3][2] = 0.0f;
+
+	*pWorld = ToD3DXMATRIX(SimdMath::Multiply(ToMat4(*pWorld), viewInverse));
+}
+
+D3DXVECTOR3 RecordingRenderer::TransScreen(const D3DXVECTOR3& worldPos)
+{
+	SimdMath::Vec3 tmp = SimdMath::TransformCoord(ToVec3(worldPos), m_view);
+	tmp = SimdMath::TransformCoord(tmp, m_projection);
+
+	tmp.x /= tmp.z;
+	tmp.y /= tmp.z;
+	tmp.z /= tmp.z;
+
+	return ToD3DXVECTOR3(SimdMath::TransformCoord(tmp, GetViewport()));
+}
+
+D3DXVECTOR3 RecordingRenderer::TransWorld(const D3DXVECTOR3& screenPos)
+{
+	SimdMath::Mat4 tmp = SimdMath::Multiply(
+		SimdMath::Multiply(SimdMath::Inverse(GetViewport()), SimdMath::Inverse(m_projection)),
+		SimdMath::Inverse(m_view));
+
+	return ToD3DXVECTOR3(SimdMath::TransformCoord(ToVec3(screenPos), tmp));
+}
+
+void RecordingRenderer::SetRectAlpha(VerticesParam* pVerticesParam, BYTE alpha) const
+{
+	m_pCustomVertex->SetAlpha(pVerticesParam, alpha);
+
+	Write(COMMAND::SET_RECT_ALPHA);
+	Write(alpha);
+}
+
+void RecordingRenderer::SetRectAlpha(CustomVertex* pVertices, BYTE alpha) const
+{
+	m_pCustomVertex->SetAlpha(pVertices, alpha);
+
+	Write(COMMAND::SET_RECT_ALPHA);
+	Write(alpha);
+}
+
+void RecordingRenderer::Render(const FbxRelated& rFBXModel, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture) const
+{
+	WriteDraw(COMMAND::RENDER_FBX, ToId(pTexture));
+	Write(ToMat4(rWorld));
+	Write(static_cast<UINT>(rFBXModel.m_pModel.size()));
+}
+
+void RecordingRenderer::Render(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture) const
+{
+	WriteDraw(COMMAND::RENDER_RECT, ToId(pTexture));
+
+	const BYTE* pBytes		= reinterpret_cast<const BYTE*>(pCustomVertices);
+	const size_t BYTES_NUM	= sizeof(CustomVertex) * CustomVertex::m_RECT_VERTICES_NUM;
+
+	m_commands.insert(m_commands.end(), pBytes, pBytes + BYTES_NUM);
+
+	m_stats.m_vertexBytes += BYTES_NUM;
+}
+
+void RecordingRenderer::Render(const Vertex3D* pVertex3D, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture)
+{
+	WriteDraw(COMMAND::RENDER_VERTEX_3D, ToId(pTexture));
+	Write(ToMat4(rWorld));
+
+	const int BOARD_VERTICES_NUM = 4;
+
+	const BYTE* pBytes		= reinterpret_cast<const BYTE*>(pVertex3D);
+	const size_t BYTES_NUM	= sizeof(Vertex3D) * BOARD_VERTICES_NUM;
+
+	m_commands.insert(m_commands.end(), pBytes, pBytes + BYTES_NUM);
+
+	m_stats.m_vertexBytes += BYTES_NUM;
+}
+
+void RecordingRenderer::Render(const D3DXVECTOR2& topLeft, const TCHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color)
+{
+	//! 文字はテクスチャを使わないのでテクスチャ番号の代わりにフォント番号を記録する
+	Write(COMMAND::RENDER_TEXT);
+	Write(ToId(pFont));
+	Write(SimdMath::Vec2(topLeft.x, topLeft.y));
+	Write(format);
+	Write(color);
+	Write(pText);
+
+	++m_stats.m_drawsNum;
+}
+
+void RecordingRenderer::Render(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture) const
+{
+	CustomVertex vertices[CustomVertex::m_RECT_VERTICES_NUM];
+
+	m_pCustomVertex->Create(vertices, verticesParam);
+
+	Render(vertices, pTexture);
+}
+
+void RecordingRenderer::Submit(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture,
+	ColorBlender::BLEND_MODE blendMode, BYTE layer) const
+{
+	CustomVertex vertices[CustomVertex::m_RECT_VERTICES_NUM];
+
+	m_pCustomVertex->Create(vertices, verticesParam);
+
+	Submit(vertices, pTexture, blendMode, layer);
+}
+
+void RecordingRenderer::Submit(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture,
+	ColorBlender::BLEND_MODE blendMode, BYTE layer) const
+{
+	WriteDraw(COMMAND::SUBMIT_RECT, ToId(pTexture));
+	Write(layer);
+	Write(static_cast<BYTE>(blendMode));
+
+	const BYTE* pBytes		= reinterpret_cast<const BYTE*>(pCustomVertices);
+	const size_t BYTES_NUM	= sizeof(CustomVertex) * CustomVertex::m_RECT_VERTICES_NUM;
+
+	m_commands.insert(m_commands.end(), pBytes, pBytes + BYTES_NUM);
+
+	m_stats.m_vertexBytes += BYTES_NUM;
+}
+
+void RecordingRenderer::CreateFbx(const TCHAR* pKey, const CHAR* pFilePath)
+{
+	FbxRelated*& rpFbxRelated = m_pFbxRelatedMap[pKey];
+
+	if (rpFbxRelated) return;
+
+	rpFbxRelated = new FbxRelated(nullptr);
+}
+
+void RecordingRenderer::CreateFont(const TCHAR* pKey, D3DXVECTOR2 scale, const TCHAR* pFontName, UINT thickness)
+{
+	UINT& rFontId = m_fontIds[pKey];
+
+	if (rFontId == 0) rFontId = m_nextFontId++;
+}
+
+const LPD3DXFONT RecordingRenderer::GetFont(const TCHAR* pKey)
+{
+	auto fontId = m_fontIds.find(pKey);
+
+	if (fontId == m_fontIds.end()) return nullptr;
+
+	return ToHandle<LPD3DXFONT>(fontId->second);
+}
+
+void RecordingRenderer::Write(const TCHAR* pText) const
+{
+	UINT textLength = static_cast<UINT>(_tcslen(pText));
+
+	Write(textLength);
+
+	const BYTE* pBytes = reinterpret_cast<const BYTE*>(pText);
+
+	m_commands.insert(m_commands.end(), pBytes, pBytes + textLength * sizeof(TCHAR));
+}
+
+void RecordingRenderer::WriteStateChange(COMMAND command) const
+{
+	Write(command);
+
+	++m_stats.m_stateChangesNum;
+}
+
+void RecordingRenderer::WriteDraw(COMMAND command, UINT texId) const
+{
+	Write(command);
+	Write(texId);
+
+	++m_stats.m_drawsNum;
+
+	if (m_prevDrawTexId != UINT_MAX && m_prevDrawTexId != texId) ++m_stats.m_stateChangesNum;
+
+	m_prevDrawTexId = texId;
+}
+
+SimdMath::Mat4 RecordingRenderer::GetViewport() const
+{
+	float halfWidth		= m_wndSize.m_x * 0.5f;
+	float halfHeight	= m_wndSize.m_y * 0.5f;
+
+	SimdMath::Mat4 viewport = SimdMath::Mat4::Identity();
+
+	viewport.m[0][0] = halfWidth;
+	viewport.m[1][1] = -halfHeight;
+	viewport.m[3][0] = halfWidth;
+	viewport.m[3][1] = halfHeight;
+
+	return viewport;
+}
@@ -0,0 +1,490 @@
+﻿/// <filename>
+/// RecordingRenderer.h
+/// </filename>
+/// <summary>
+/// 描画命令を記録するだけのIGameLibRendererの実装のヘッダ
+/// </summary>
+
+#ifndef RECORDING_RENDERER_H
+#define RECORDING_RENDERER_H
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <climits>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <cstring>
+
+#include <d3dx9.h>
+
+#include "SimdMath\SimdMath.h"
+#include "IGameLibRenderer\IGameLibRenderer.h"
+#include "DX\DX3D\CustomVertexEditor\CustomVertexEditor.h"
+#include "CustomVertex.h"
+#include "VerticesParam.h"
+#include "DX\DX3D\FbxStorage\FbxStorage.h"
+#include "3DBoard\3DBoard.h"
+#include "Wnd/Data/RectSize.h"
+
+/// <summary>
+/// 記録した命令の数などの統計
+/// </summary>
+struct RecordingStats
+{
+public:
+	//! 描画命令の数
+	UINT m_drawsNum = 0;
+
+	//! 色の合成,ライト,カメラの変更及び描画間でのテクスチャの切り替えの数
+	UINT m_stateChangesNum = 0;
+
+	//! 描画命令に含まれる頂点データのバイト数
+	size_t m_vertexBytes = 0;
+};
+
+/// <summary>
+/// Direct3Dのデバイスを作らずに描画関連の呼び出しをバイナリの命令列として記録するIGameLibRendererの実装
+/// エフェクトや頂点の処理をウィンドウやGPUのない環境で動かし,描画回数などを計測するために用いる
+/// </summary>
+/// <remarks>
+/// GetTex,GetFontが返すポインタは識別番号を詰めただけのものなので参照してはいけない
+/// 頂点の編集はデバイスを持たないCustomVertexEditorで実際に行う
+/// 命令列の行列とベクトル,カメラの計算はSimdMathの型で行い,D3DXの型とはIGameLibRendererの引数でのみ変換する
+/// ただしIGameLibRendererの引数とCustomVertexがDirect3Dの型を含むので,Windows以外でビルドすることはできない
+/// </remarks>
+class RecordingRenderer :public IGameLibRenderer
+{
+public:
+	/// <summary>
+	/// 命令列の先頭1バイトに書き込まれる命令の種類
+	/// </summary>
+	enum class COMMAND : BYTE
+	{
+		RENDER_RECT,			//! UINT テクスチャ番号, CustomVertex[4]
+		RENDER_VERTEX_3D,		//! UINT テクスチャ番号, SimdMath::Mat4, Vertex3D[4]
+		RENDER_FBX,				//! UINT テクスチャ番号, SimdMath::Mat4, UINT モデル数
+		RENDER_TEXT,			//! UINT フォント番号, SimdMath::Vec2, UINT フォーマット, DWORD 色, UINT 文字数, TCHAR[文字数]
+		DEFAULT_BLEND_MODE,
+		ADDTION_BLEND_MODE,
+		DEFAULT_COLOR_BLENDING,
+		SET_RECT_ALPHA,			//! BYTE アルファ値
+		CREATE_TEX,				//! UINT テクスチャ番号, UINT 文字数, TCHAR[文字数]
+		RELEASE_TEX,			//! UINT テクスチャ番号
+		ALL_TEX_RELEASE,
+		SET_LIGHT,				//! DWORD 識別番号, D3DLIGHT9
+		ON_LIGHT,				//! DWORD 識別番号
+		OFF_LIGHT,				//! DWORD 識別番号
+		ENABLE_LIGHTING,
+		DISABLE_LIGHTING,
+		CHANGE_AMBIENT,			//! DWORD 色
+		ENABLE_SPECULAR,
+		DISABLE_SPECULAR,
+		DEFAULT_LIGHTING,
+		SET_CAMERA_TRANSFORM,	//! SimdMath::Mat4 ビュー, SimdMath::Mat4 プロジェクション
+		SUBMIT_RECT,			//! UINT テクスチャ番号, BYTE レイヤー, BYTE 色の合成, CustomVertex[4]
+	};
+
+	explicit RecordingRenderer(const RectSize& wndSize);
+	~RecordingRenderer();
+
+	/// <summary>
+	/// 記録した命令列を取得する
+	/// </summary>
+	/// <returns>命令列の参照</returns>
+	inline const std::vector<BYTE>& GetCommands() const
+	{
+		return m_commands;
+	}
+
+	/// <summary>
+	/// 記録した命令の統計を取得する
+	/// </summary>
+	/// <returns>統計の参照</returns>
+	inline const RecordingStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+	/// <summary>
+	/// 命令列と統計を空にする フレームの区切りで呼ぶ
+	/// </summary>
+	void ClearCommands();
+
+	inline RectSize GetWndSize() const
+	{
+		return m_wndSize;
+	}
+
+	void DefaultBlendMode() const;
+
+	void AddtionBlendMode() const;
+
+	void DefaultColorBlending() const;
+
+	void SetLight(const D3DLIGHT9& rLight, DWORD index) const;
+
+	void OnLight(DWORD index) const;
+
+	void OffLight(DWORD index) const;
+
+	void EnableLighting() const;
+
+	void DisableLighting() const;
+
+	void ChangeAmbientIntensity(DWORD aRGB) const;
+
+	void EnableSpecular() const;
+
+	void DisaableSpecular() const;
+
+	void DefaultLighting() const;
+
+	/// <summary>
+	/// テクスチャの識別番号を割り振り記録する 画像は読み込まない
+	/// </summary>
+	/// <returns>識別番号を添え字にしたハンドル 番号は使いまわさないので世代は常に1</returns>
+	TexHandle CreateTex(const TCHAR* pTexKey, const TCHAR* pTexPath);
+
+	void AllTexRelease();
+
+	void ReleaseTex(const TCHAR* pTexKey);
+
+	/// <summary>
+	/// テクスチャの識別番号をポインタとして返す 存在しない場合はnullptr
+	/// </summary>
+	const LPDIRECT3DTEXTURE9 GetTex(const TCHAR* pTexKey) const;
+
+	TexHandle GetTexHandle(const TCHAR* pTexKey) const;
+
+	/// <summary>
+	/// ハンドルの識別番号をポインタとして返す 開放されている場合はnullptr
+	/// </summary>
+	const LPDIRECT3DTEXTURE9 GetTex(TexHandle texHandle) const;
+
+	inline const bool TexExists(const TCHAR* pTexKey) const
+	{
+		return m_texIds.find(pTexKey) != m_texIds.end();
+	}
+
+	inline void GetCameraPos(D3DXVECTOR3* pCameraPos) const
+	{
+		*pCameraPos = ToD3DXVECTOR3(m_cameraPos);
+	}
+
+	inline void SetCameraPos(float x, float y, float z)
+	{
+		m_cameraPos = SimdMath::Vec3(x, y, z);
+	}
+
+	inline void SetCameraPos(const D3DXVECTOR3& rCameraPos)
+	{
+		m_cameraPos = ToVec3(rCameraPos);
+	}
+
+	inline void GetCameraEyePt(D3DXVECTOR3* pEyePoint) const
+	{
+		*pEyePoint = ToD3DXVECTOR3(m_eyePoint);
+	}
+
+	inline void SetCameraEyePt(float x, float y, float z)
+	{
+		m_eyePoint = SimdMath::Vec3(x, y, z);
+	}
+
+	inline void SetCameraEyePt(const D3DXVECTOR3& rEyePt)
+	{
+		m_eyePoint = ToVec3(rEyePt);
+	}
+
+	inline void GetView(D3DXMATRIX* pView) const
+	{
+		*pView = ToD3DXMATRIX(m_view);
+	}
+
+	inline void GetProjection(D3DXMATRIX* pProjrction) const
+	{
+		*pProjrction = ToD3DXMATRIX(m_projection);
+	}
+
+	/// <summary>
+	/// Cameraと同じ値でビュー行列とプロジェクション行列を作成し記録する
+	/// </summary>
+	void SetCameraTransform();
+
+	void TransBillBoard(D3DXMATRIX* pWorld) const;
+
+	D3DXVECTOR3 TransScreen(const D3DXVECTOR3& Pos);
+
+	D3DXVECTOR3 TransWorld(const D3DXVECTOR3& Pos);
+
+	inline void RotateRectXYZ(CustomVertex* pCustomVertices, const D3DXVECTOR3& deg, const D3DXVECTOR3& relativeRotateCenter) const
+	{
+		m_pCustomVertex->RotateXYZ(pCustomVertices, deg, relativeRotateCenter);
+	}
+
+	inline void RotateRectX(CustomVertex* pCustomVertices, float deg, const D3DXVECTOR3& relativeRotateCenter) const
+	{
+		m_pCustomVertex->RotateX(pCustomVertices, deg, relativeRotateCenter);
+	}
+
+	inline void RotateRectY(CustomVertex* pCustomVertices, float deg, const D3DXVECTOR3& relativeRotateCenter) const
+	{
+		m_pCustomVertex->RotateY(pCustomVertices, deg, relativeRotateCenter);
+	}
+
+	inline void RotateRectZ(CustomVertex* pCustomVertices, float deg, const D3DXVECTOR3& relativeRotateCenter) const
+	{
+		m_pCustomVertex->RotateZ(pCustomVertices, deg, relativeRotateCenter);
+	}
+
+	inline void RescaleRect(CustomVertex* pCustomVertices, const D3DXVECTOR2& scaleRate) const
+	{
+		m_pCustomVertex->Rescale(pCustomVertices, scaleRate);
+	}
+
+	inline void MoveRect(CustomVertex* pCustomVertices, const D3DXVECTOR3& movement) const
+	{
+		m_pCustomVertex->Move(pCustomVertices, movement);
+	}
+
+	inline void LocaleRect(CustomVertex* pCustomVertices, const D3DXVECTOR3& pos) const
+	{
+		m_pCustomVertex->Locale(pCustomVertices, pos);
+	}
+
+	inline void SetRectTexUV(CustomVertex* pCustomVertices,
+		float startTU = 0.0f, float startTV = 0.0f, float endTU = 1.0f, float endTV = 1.0f) const
+	{
+		m_pCustomVertex->SetTexUV(pCustomVertices, startTU, startTV, endTU, endTV);
+	}
+
+	inline void SetRectARGB(CustomVertex *pCustomVertices, DWORD aRGB) const
+	{
+		m_pCustomVertex->SetARGB(pCustomVertices, aRGB);
+	}
+
+	inline void SetTopBottomARGB(CustomVertex *pCustomVertices, DWORD topARGB, DWORD bottomARGB) const
+	{
+		m_pCustomVertex->SetTopBottomARGB(pCustomVertices, topARGB, bottomARGB);
+	}
+
+	inline void SetLeftRightARGB(CustomVertex *pCustomVertices, DWORD leftARGB, DWORD rightARGB) const
+	{
+		m_pCustomVertex->SetLeftRightARGB(pCustomVertices, leftARGB, rightARGB);
+	}
+
+	inline void SetObliqueToBottomRightARGB(CustomVertex *pCustomVertices, DWORD topARGB, DWORD bottomARGB) const
+	{
+		m_pCustomVertex->SetObliqueToBottomRightARGB(pCustomVertices, topARGB, bottomARGB);
+	}
+
+	inline void SetObliqueToBottomLeftARGB(CustomVertex *pCustomVertices, DWORD topARGB, DWORD bottomARGB) const
+	{
+		m_pCustomVertex->SetObliqueToBottomLeftARGB(pCustomVertices, topARGB, bottomARGB);
+	}
+
+	inline void FlashRect(CustomVertex* pVertices, int* pFrameCnt, int flashFlameMax, BYTE alphaMax, BYTE alphaMin = 0) const
+	{
+		m_pCustomVertex->Flash(pVertices, pFrameCnt, flashFlameMax, alphaMax, alphaMin);
+	}
+
+	inline void FlashRect(VerticesParam* pVerticesParam, int* pFrameCnt, int flashFlameMax, BYTE alphaMax, BYTE alphaMin = 0) const
+	{
+		m_pCustomVertex->Flash(pVerticesParam, pFrameCnt, flashFlameMax, alphaMax, alphaMin);
+	}
+
+	inline void FlashRect(CustomVertex* pVertices, float* pSecondsCnt, float flashSecondsMax, BYTE alphaMax, BYTE alphaMin = 0) const
+	{
+		m_pCustomVertex->Flash(pVertices, pSecondsCnt, flashSecondsMax, alphaMax, alphaMin);
+	}
+
+	inline void FlashRect(VerticesParam* pVerticesParam, float* pSecondsCnt, float flashSecondsMax, BYTE alphaMax, BYTE alphaMin = 0) const
+	{
+		m_pCustomVertex->Flash(pVerticesParam, pSecondsCnt, flashSecondsMax, alphaMax, alphaMin);
+	}
+
+	/// <summary>
+	/// アルファ値を変更し,変更したことを記録する
+	/// </summary>
+	void SetRectAlpha(VerticesParam* pVerticesParam, BYTE alpha) const;
+
+	void SetRectAlpha(CustomVertex* pVertices, BYTE alpha) const;
+
+	inline void CreateRect(CustomVertex *pCustomVertices, const D3DXVECTOR3& center, const D3DXVECTOR3& halfScale,
+		DWORD aRGB = 0xFFFFFFFF, float startTU = 0.0f, float startTV = 0.0f, float endTU = 1.0f, float endTV = 1.0f) const
+	{
+		m_pCustomVertex->Create(pCustomVertices, center, halfScale, aRGB, startTU, startTV, endTU, endTV);
+	}
+
+	inline void CreateRect(CustomVertex *pCustomVertices, const VerticesParam& verticesParam) const
+	{
+		m_pCustomVertex->Create(pCustomVertices, verticesParam);
+	}
+
+	void Render(const FbxRelated& rFBXModel, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const;
+
+	void Render(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const;
+
+	void Render(const Vertex3D* pVertex3D, const D3DXMATRIX& rWorld, const LPDIRECT3DTEXTURE9 pTexture = nullptr);
+
+	void Render(const D3DXVECTOR2& topLeft, const TCHAR* pText, UINT format, LPD3DXFONT pFont, DWORD color);
+
+	void Render(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture = nullptr) const;
+
+	/// <summary>
+	/// 並べ替えは行わず積まれた順に記録する
+	/// </summary>
+	void Submit(const VerticesParam& verticesParam, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const;
+
+	void Submit(const CustomVertex* pCustomVertices, const LPDIRECT3DTEXTURE9 pTexture = nullptr,
+		ColorBlender::BLEND_MODE blendMode = ColorBlender::BLEND_MODE::DEFAULT, BYTE layer = 0) const;
+
+	/// <summary>
+	/// 空のFBXオブジェクトを作成する ファイルは読み込まない
+	/// </summary>
+	void CreateFbx(const TCHAR* pKey, const CHAR* pFilePath);
+
+	inline FbxRelated& GetFbx(const TCHAR* pKey)
+	{
+		return *m_pFbxRelatedMap[pKey];
+	}
+
+	inline void AllFontRelease()
+	{
+		m_fontIds.clear();
+	}
+
+	inline void ReleaseFont(const TCHAR* pFontKey)
+	{
+		m_fontIds.erase(pFontKey);
+	}
+
+	/// <summary>
+	/// フォントの識別番号を割り振る フォントは作成しない
+	/// </summary>
+	void CreateFont(const TCHAR* pKey, D3DXVECTOR2 scale, const TCHAR* pFontName, UINT thickness = 0);
+
+	inline bool FontExists(const TCHAR* pKey)
+	{
+		return m_fontIds.find(pKey) != m_fontIds.end();
+	}
+
+	const LPD3DXFONT GetFont(const TCHAR* pKey);
+
+private:
+	/// <summary>
+	/// 命令列の末尾に値をそのままのバイト列で追加する
+	/// </summary>
+	template<typename T>
+	void Write(const T& value) const
+	{
+		const BYTE* pBytes = reinterpret_cast<const BYTE*>(&value);
+
+		m_commands.insert(m_commands.end(), pBytes, pBytes + sizeof(T));
+	}
+
+	void Write(const TCHAR* pText) const;
+
+	/// <summary>
+	/// 描画以外の状態の変更を記録する
+	/// </summary>
+	void WriteStateChange(COMMAND command) const;
+
+	/// <summary>
+	/// 描画命令の種類とテクスチャ番号を記録し,前回の描画とテクスチャが異なれば状態の変更として数える
+	/// </summary>
+	void WriteDraw(COMMAND command, UINT texId) const;
+
+	/*
+	* IGameLibRendererの引数のD3DXの型とSimdMathの型の変換 行列はメモリ上の並びが同じなのでそのまま写す
+	*/
+
+	static inline SimdMath::Vec3 ToVec3(const D3DXVECTOR3& rVec)
+	{
+		return SimdMath::Vec3(rVec.x, rVec.y, rVec.z);
+	}
+
+	static inline D3DXVECTOR3 ToD3DXVECTOR3(const SimdMath::Vec3& rVec)
+	{
+		return D3DXVECTOR3(rVec.x, rVec.y, rVec.z);
+	}
+
+	static inline SimdMath::Mat4 ToMat4(const D3DXMATRIX& rMatrix)
+	{
+		static_assert(sizeof(SimdMath::Mat4) == sizeof(D3DXMATRIX), "D3DXMATRIXとメモリ上の並びを同じにするため");
+
+		SimdMath::Mat4 matrix;
+		memcpy(matrix.m, &rMatrix, sizeof(matrix.m));
+
+		return matrix;
+	}
+
+	static inline D3DXMATRIX ToD3DXMATRIX(const SimdMath::Mat4& rMatrix)
+	{
+		D3DXMATRIX matrix;
+		memcpy(&matrix, rMatrix.m, sizeof(rMatrix.m));
+
+		return matrix;
+	}
+
+	/// <summary>
+	/// スクリーン座標へ変換するビューポート行列
+	/// </summary>
+	SimdMath::Mat4 GetViewport() const;
+
+	/// <summary>
+	/// ポインタに詰めた識別番号を取り出す
+	/// </summary>
+	template<typename T>
+	static UINT ToId(const T pHandle)
+	{
+		return static_cast<UINT>(reinterpret_cast<UINT_PTR>(pHandle));
+	}
+
+	/// <summary>
+	/// 識別番号をポインタに詰める 0はnullptrになる
+	/// </summary>
+	template<typename T>
+	static T ToHandle(UINT id)
+	{
+		return reinterpret_cast<T>(static_cast<UINT_PTR>(id));
+	}
+
+	const RectSize m_wndSize;
+
+	CustomVertexEditor* m_pCustomVertex = nullptr;
+
+	mutable std::vector<BYTE> m_commands;
+
+	mutable RecordingStats m_stats;
+
+	//! 直前の描画で使用したテクスチャ番号 描画していなければUINT_MAX
+	mutable UINT m_prevDrawTexId = UINT_MAX;
+
+	std::map<std::basic_string<TCHAR>, UINT> m_texIds;
+
+	//! ハンドルから開放されていないかを調べるのに用いる
+	std::set<UINT> m_aliveTexIds;
+
+	std::map<std::basic_string<TCHAR>, UINT> m_fontIds;
+
+	//! 0はnullptrと区別できないので1から振る
+	UINT m_nextTexId = 1;
+
+	UINT m_nextFontId = 1;
+
+	std::map<std::basic_string<TCHAR>, FbxRelated*> m_pFbxRelatedMap;
+
+	SimdMath::Vec3 m_cameraPos		= SimdMath::Vec3(0.0f, 0.0f, 0.0f);
+	SimdMath::Vec3 m_eyePoint		= SimdMath::Vec3(0.0f, 0.0f, 1.0f);
+	SimdMath::Vec3 m_cameraOverhead	= SimdMath::Vec3(0.0f, 1.0f, 0.0f);
+
+	SimdMath::Mat4 m_view		= SimdMath::Mat4::Identity();
+	SimdMath::Mat4 m_projection	= SimdMath::Mat4::Identity();
+};
+
+#endif //! RECORDING_RENDERER_H
@@ -0,0 +1,217 @@
+﻿/// <filename>
+/// JobSystem.cpp
+/// </filename>
+/// <summary>
+/// 処理を分割して複数のスレッドで行うクラスのソース
+/// </summary>
+
+#include "JobSystem.h"
+
+#include <Windows.h>
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace
+{
+	//! 常駐させたスレッドが自分の列の番号を覚えておく
+	thread_local const JobSystem* t_pOwnerJobSystem = nullptr;
+
+	thread_local UINT t_queueIndex = 0;
+}
+
+JobSystem::JobSystem(UINT workersNum, bool isSingleThreaded) :m_queuedJobsNum(0), m_isSingleThreaded(isSingleThreaded)
+{
+	//! スレッドは後から作ることもあるので,列は先に全て作っておく
+	for (UINT i = 0; i <= workersNum; ++i)
+	{
+		m_pJobQueues.push_back(new JobQueue());
+	}
+
+	if (!m_isSingleThreaded) StartWorkers();
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+
+		m_isStopping = true;
+	}
+
+	m_wakeUp.notify_all();
+
+	for (std::thread& rWorker : m_workers)
+	{
+		rWorker.join();
+	}
+
+	for (auto i : m_pJobQueues)
+	{
+		delete i;
+	}
+}
+
+void JobSystem::SetSingleThreaded(bool isSingleThreaded)
+{
+	m_isSingleThreaded = isSingleThreaded;
+
+	if (!m_isSingleThreaded) StartWorkers();
+}
+
+void JobSystem::ParallelFor(UINT count, UINT chunkSize, const std::function<void(UINT, UINT)>& rJob)
+{
+	if (count == 0) return;
+
+	if (chunkSize == 0) chunkSize = 1;
+
+	if (m_isSingleThreaded || m_workers.empty() || count <= chunkSize)
+	{
+		rJob(0, count);
+
+		return;
+	}
+
+	UINT chunksNum = (count + chunkSize - 1) / chunkSize;
+
+	std::atomic<UINT> remainingNum(chunksNum);
+
+	UINT queueIndex = CurrentQueueIndex();
+
+	{
+		JobQueue* pJobQueue = m_pJobQueues[queueIndex];
+
+		std::lock_guard<std::mutex> lock(pJobQueue->m_mutex);
+
+		for (UINT begin = 0; begin < count; begin += chunkSize)
+		{
+			Job job;
+			job.m_pJob			= &rJob;
+			job.m_begin			= begin;
+			job.m_end			= (std::min)(begin + chunkSize, count);
+			job.m_pRemainingNum = &remainingNum;
+
+			pJobQueue->m_jobs.push_back(job);
+		}
+	}
+
+	{
+		//! 眠りにつく直前のスレッドが増えた処理を見落とさないように,眠る判定と同じロックの中で増やす
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+
+		m_queuedJobsNum += chunksNum;
+	}
+
+	m_wakeUp.notify_all();
+
+	//! 待つ間も処理を手伝う 他のParallelForの処理を行うこともある
+	while (remainingNum.load(std::memory_order_acquire) > 0)
+	{
+		Job job;
+
+		if (TryPop(queueIndex, &job) || TrySteal(queueIndex, &job))
+		{
+			Execute(job);
+
+			continue;
+		}
+
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::StartWorkers()
+{
+	if (!m_workers.empty()) return;
+
+	UINT queuesNum = static_cast<UINT>(m_pJobQueues.size());
+
+	for (UINT i = 1; i < queuesNum; ++i)
+	{
+		m_workers.emplace_back(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+void JobSystem::WorkerMain(UINT queueIndex)
+{
+	t_pOwnerJobSystem	= this;
+	t_queueIndex		= queueIndex;
+
+	while (true)
+	{
+		Job job;
+
+		if (TryPop(queueIndex, &job) || TrySteal(queueIndex, &job))
+		{
+			Execute(job);
+
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+		m_wakeUp.wait(lock, [this]() { return m_isStopping || m_queuedJobsNum.load() > 0; });
+
+		if (m_isStopping) return;
+	}
+}
+
+bool JobSystem::TryPop(UINT queueIndex, Job* pJob)
+{
+	JobQueue* pJobQueue = m_pJobQueues[queueIndex];
+
+	std::lock_guard<std::mutex> lock(pJobQueue->m_mutex);
+
+	if (pJobQueue->m_jobs.empty()) return false;
+
+	*pJob = pJobQueue->m_jobs.back();
+	pJobQueue->m_jobs.pop_back();
+
+	--m_queuedJobsNum;
+
+	return true;
+}
+
+bool JobSystem::TrySteal(UINT queueIndex, Job* pJob)
+{
+	UINT queuesNum = static_cast<UINT>(m_pJobQueues.size());
+
+	for (UINT i = 1; i < queuesNum; ++i)
+	{
+		JobQueue* pJobQueue = m_pJobQueues[(queueIndex + i) % queuesNum];
+
+		std::lock_guard<std::mutex> lock(pJobQueue->m_mutex);
+
+		if (pJobQueue->m_jobs.empty()) continue;
+
+		*pJob = pJobQueue->m_jobs.front();
+		pJobQueue->m_jobs.pop_front();
+
+		--m_queuedJobsNum;
+
+		return true;
+	}
+
+	return false;
+}
+
+void JobSystem::Execute(const Job& rJob)
+{
+	(*rJob.m_pJob)(rJob.m_begin, rJob.m_end);
+
+	//! これが呼び出し元を待ちから解放するので,以降rJobの指す先には触れない
+	rJob.m_pRemainingNum->fetch_sub(1, std::memory_order_release);
+}
+
+UINT JobSystem::CurrentQueueIndex() const
+{
+	if (t_pOwnerJobSystem != this) return 0;
+
+	return t_queueIndex;
+}
@@ -0,0 +1,136 @@
+﻿/// <filename>
+/// JobSystem.h
+/// </filename>
+/// <summary>
+/// 処理を分割して複数のスレッドで行うクラスのヘッダ
+/// </summary>
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <Windows.h>
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/// <summary>
+/// 処理を範囲ごとに分割し,常駐させたスレッドで並列に行うクラス
+/// </summary>
+/// <remarks>
+/// スレッドごとに処理の列を持ち,自分の列が空になると他のスレッドの列の先頭から処理を奪う
+/// ParallelForを呼んだスレッドも終わるまで処理を手伝うので,処理の中からParallelForを呼んでもよい
+/// </remarks>
+class JobSystem
+{
+public:
+	/// <param name="workersNum">常駐させるスレッドの数 呼び出したスレッドも処理するのでコア数-1が目安</param>
+	/// <param name="isSingleThreaded">trueにすると,SetSingleThreadedでfalseにするまでスレッドを作らない</param>
+	explicit JobSystem(UINT workersNum = DefaultWorkersNum(), bool isSingleThreaded = false);
+
+	~JobSystem();
+
+	/// <summary>
+	/// [0, count)をchunkSizeごとの範囲に分けて並列に処理し,全て終わるまで待つ
+	/// </summary>
+	/// <param name="count">処理する要素の数</param>
+	/// <param name="chunkSize">一つの処理に割り当てる要素の数</param>
+	/// <param name="rJob">[in]範囲の始まりと終わり(終わりは含まない)を受け取る処理</param>
+	void ParallelFor(UINT count, UINT chunkSize, const std::function<void(UINT, UINT)>& rJob);
+
+	/// <summary>
+	/// trueにすると全ての処理を呼び出したスレッドで順番に行う
+	/// falseにした際にスレッドをまだ作っていなければ作る ParallelForと並列に呼んではいけない
+	/// </summary>
+	void SetSingleThreaded(bool isSingleThreaded);
+
+	inline bool IsSingleThreaded() const
+	{
+		return m_isSingleThreaded;
+	}
+
+	/// <summary>
+	/// 作った常駐させたスレッドの数 作る前は0
+	/// </summary>
+	inline UINT GetWorkersNum() const
+	{
+		return static_cast<UINT>(m_workers.size());
+	}
+
+	static inline UINT DefaultWorkersNum()
+	{
+		UINT threadsNum = std::thread::hardware_concurrency();
+
+		return (threadsNum > 1) ? threadsNum - 1 : 0;
+	}
+
+private:
+	struct Job
+	{
+	public:
+		const std::function<void(UINT, UINT)>* m_pJob = nullptr;
+
+		UINT m_begin = 0;
+		UINT m_end = 0;
+
+		//! ParallelForの呼び出し元が持つ残りの処理の数
+		std::atomic<UINT>* m_pRemainingNum = nullptr;
+	};
+
+	struct JobQueue
+	{
+	public:
+		std::mutex m_mutex;
+
+		std::deque<Job> m_jobs;
+	};
+
+	/// <summary>
+	/// 列の数だけスレッドを作る 作った後は何もしない
+	/// </summary>
+	void StartWorkers();
+
+	/// <summary>
+	/// 常駐させたスレッドで回し続ける関数
+	/// </summary>
+	void WorkerMain(UINT queueIndex);
+
+	/// <summary>
+	/// 自分の列の末尾から処理を取り出す
+	/// </summary>
+	bool TryPop(UINT queueIndex, Job* pJob);
+
+	/// <summary>
+	/// 他のスレッドの列の先頭から処理を奪う
+	/// </summary>
+	bool TrySteal(UINT queueIndex, Job* pJob);
+
+	void Execute(const Job& rJob);
+
+	/// <summary>
+	/// 呼び出したスレッドが使う列の番号 このクラスのスレッド以外は0番を使う
+	/// </summary>
+	UINT CurrentQueueIndex() const;
+
+	std::vector<std::thread> m_workers;
+
+	//! 0番は呼び出し元のスレッド,1番以降は常駐させたスレッドの列
+	std::vector<JobQueue*> m_pJobQueues;
+
+	//! 列に積まれていてまだ取り出されていない処理の数
+	std::atomic<UINT> m_queuedJobsNum;
+
+	std::mutex m_sleepMutex;
+
+	std::condition_variable m_wakeUp;
+
+	bool m_isStopping = false;
+
+	bool m_isSingleThreaded = false;
+};
+
+#endif //! JOB_SYSTEM_H
@@ -0,0 +1,417 @@
+﻿/// <filename>
+/// SimdMath.h
+/// </filename>
+/// <summary>
+/// D3DXに依存しないベクトルと行列の計算をまとめた名前空間のヘッダ
+/// </summary>
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+//! 使える命令セットを選ぶ Win32ではSSE2が既定で有効
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define SIMD_MATH_NEON
+#include <arm_neon.h>
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SIMD_MATH_SSE2
+#include <emmintrin.h>
+#endif
+
+/// <summary>
+/// D3DXに依存しないベクトルと行列の計算をまとめた名前空間
+/// 型はD3DXVECTOR2,D3DXVECTOR3,D3DXVECTOR4,D3DXMATRIXとメモリ上の並びが同じで,
+/// 行列は行ベクトルに右から掛けるD3DXと同じ規約
+/// RecordingRendererのカメラの計算と命令列,ParticleStorageの配列の更新で用いる
+/// </summary>
+namespace SimdMath
+{
+	const float PI = 3.141592654f;
+
+	inline float ToRadian(float degree)
+	{
+		return degree * (PI / 180.0f);
+	}
+
+	struct Vec2
+	{
+	public:
+		Vec2() {};
+		Vec2(float initialX, float initialY) :x(initialX), y(initialY) {};
+
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	struct Vec3
+	{
+	public:
+		Vec3() {};
+		Vec3(float initialX, float initialY, float initialZ) :x(initialX), y(initialY), z(initialZ) {};
+
+		inline Vec3 operator-(const Vec3& rRight) const
+		{
+			return Vec3(x - rRight.x, y - rRight.y, z - rRight.z);
+		}
+
+		inline Vec3 operator*(float scale) const
+		{
+			return Vec3(x * scale, y * scale, z * scale);
+		}
+
+		float x = 0.0f;
+		float y = 0.0f;
+		float z = 0.0f;
+	};
+
+	struct Vec4
+	{
+	public:
+		Vec4() {};
+		Vec4(float initialX, float initialY, float initialZ, float initialW) :x(initialX), y(initialY), z(initialZ), w(initialW) {};
+
+		float x = 0.0f;
+		float y = 0.0f;
+		float z = 0.0f;
+		float w = 0.0f;
+	};
+
+	/// <summary>
+	/// 4x4の行列 m[行][列]
+	/// </summary>
+	struct Mat4
+	{
+	public:
+		float m[4][4];
+
+		static inline Mat4 Identity()
+		{
+			Mat4 identity;
+
+			for (int row = 0; row < 4; ++row)
+			{
+				for (int column = 0; column < 4; ++column)
+				{
+					identity.m[row][column] = (row == column) ? 1.0f : 0.0f;
+				}
+			}
+
+			return identity;
+		}
+	};
+
+	inline float Dot(const Vec3& rA, const Vec3& rB)
+	{
+		return rA.x * rB.x + rA.y * rB.y + rA.z * rB.z;
+	}
+
+	inline Vec3 Cross(const Vec3& rA, const Vec3& rB)
+	{
+		return Vec3(
+			rA.y * rB.z - rA.z * rB.y,
+			rA.z * rB.x - rA.x * rB.z,
+			rA.x * rB.y - rA.y * rB.x);
+	}
+
+	inline float Length(const Vec3& rVec)
+	{
+		return std::sqrt(Dot(rVec, rVec));
+	}
+
+	/// <summary>
+	/// 単位ベクトルを返す 長さが0のベクトルは0のまま返す
+	/// </summary>
+	inline Vec3 Normalize(const Vec3& rVec)
+	{
+		float length = Length(rVec);
+
+		return (length == 0.0f) ? Vec3() : rVec * (1.0f / length);
+	}
+
+	/// <summary>
+	/// rA * rBを返す 結果の各行はrBの行をrAの行の要素で重み付けした和
+	/// </summary>
+	inline Mat4 Multiply(const Mat4& rA, const Mat4& rB)
+	{
+		Mat4 result;
+
+#if defined(SIMD_MATH_SSE2)
+		__m128 bRows[4] = { _mm_loadu_ps(rB.m[0]), _mm_loadu_ps(rB.m[1]), _mm_loadu_ps(rB.m[2]), _mm_loadu_ps(rB.m[3]) };
+
+		for (int row = 0; row < 4; ++row)
+		{
+			__m128 resultRow = _mm_mul_ps(_mm_set1_ps(rA.m[row][0]), bRows[0]);
+			resultRow = _mm_add_ps(resultRow, _mm_mul_ps(_mm_set1_ps(rA.m[row][1]), bRows[1]));
+			resultRow = _mm_add_ps(resultRow, _mm_mul_ps(_mm_set1_ps(rA.m[row][2]), bRows[2]));
+			resultRow = _mm_add_ps(resultRow, _mm_mul_ps(_mm_set1_ps(rA.m[row][3]), bRows[3]));
+
+			_mm_storeu_ps(result.m[row], resultRow);
+		}
+#elif defined(SIMD_MATH_NEON)
+		float32x4_t bRows[4] = { vld1q_f32(rB.m[0]), vld1q_f32(rB.m[1]), vld1q_f32(rB.m[2]), vld1q_f32(rB.m[3]) };
+
+		for (int row = 0; row < 4; ++row)
+		{
+			float32x4_t resultRow = vmulq_n_f32(bRows[0], rA.m[row][0]);
+			resultRow = vmlaq_n_f32(resultRow, bRows[1], rA.m[row][1]);
+			resultRow = vmlaq_n_f32(resultRow, bRows[2], rA.m[row][2]);
+			resultRow = vmlaq_n_f32(resultRow, bRows[3], rA.m[row][3]);
+
+			vst1q_f32(result.m[row], resultRow);
+		}
+#else
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int column = 0; column < 4; ++column)
+			{
+				result.m[row][column] =
+					rA.m[row][0] * rB.m[0][column] + rA.m[row][1] * rB.m[1][column] +
+					rA.m[row][2] * rB.m[2][column] + rA.m[row][3] * rB.m[3][column];
+			}
+		}
+#endif
+
+		return result;
+	}
+
+	/// <summary>
+	/// 逆行列を返す 部分ピボット選択付きのガウス・ジョルダン法で求める
+	/// </summary>
+	/// <param name="pIsInvertible">[out]逆行列が存在すればtrue nullptrでもよい</param>
+	/// <returns>逆行列が存在しない場合は単位行列</returns>
+	inline Mat4 Inverse(const Mat4& rMatrix, bool* pIsInvertible = nullptr)
+	{
+		Mat4 source		= rMatrix;
+		Mat4 inverse	= Mat4::Identity();
+
+		for (int column = 0; column < 4; ++column)
+		{
+			int pivotRow = column;
+
+			for (int row = column + 1; row < 4; ++row)
+			{
+				if (std::fabs(source.m[row][column]) > std::fabs(source.m[pivotRow][column])) pivotRow = row;
+			}
+
+			if (source.m[pivotRow][column] == 0.0f)
+			{
+				if (pIsInvertible) *pIsInvertible = false;
+
+				return Mat4::Identity();
+			}
+
+			for (int i = 0; i < 4; ++i)
+			{
+				std::swap(source.m[column][i], source.m[pivotRow][i]);
+				std::swap(inverse.m[column][i], inverse.m[pivotRow][i]);
+			}
+
+			float inversePivot = 1.0f / source.m[column][column];
+
+			for (int i = 0; i < 4; ++i)
+			{
+				source.m[column][i]		*= inversePivot;
+				inverse.m[column][i]	*= inversePivot;
+			}
+
+			for (int row = 0; row < 4; ++row)
+			{
+				if (row == column) continue;
+
+				float factor = source.m[row][column];
+
+				for (int i = 0; i < 4; ++i)
+				{
+					source.m[row][i]	-= factor * source.m[column][i];
+					inverse.m[row][i]	-= factor * inverse.m[column][i];
+				}
+			}
+		}
+
+		if (pIsInvertible) *pIsInvertible = true;
+
+		return inverse;
+	}
+
+	/// <summary>
+	/// 左手座標系のビュー行列を返す D3DXMatrixLookAtLHと同じ
+	/// </summary>
+	/// <param name="rEye">視点</param>
+	/// <param name="rAt">注視点</param>
+	/// <param name="rUp">上方向</param>
+	inline Mat4 LookAtLH(const Vec3& rEye, const Vec3& rAt, const Vec3& rUp)
+	{
+		Vec3 zAxis = Normalize(rAt - rEye);
+		Vec3 xAxis = Normalize(Cross(rUp, zAxis));
+		Vec3 yAxis = Cross(zAxis, xAxis);
+
+		Mat4 view = Mat4::Identity();
+
+		view.m[0][0] = xAxis.x;	view.m[0][1] = yAxis.x;	view.m[0][2] = zAxis.x;
+		view.m[1][0] = xAxis.y;	view.m[1][1] = yAxis.y;	view.m[1][2] = zAxis.y;
+		view.m[2][0] = xAxis.z;	view.m[2][1] = yAxis.z;	view.m[2][2] = zAxis.z;
+
+		view.m[3][0] = -Dot(xAxis, rEye);
+		view.m[3][1] = -Dot(yAxis, rEye);
+		view.m[3][2] = -Dot(zAxis, rEye);
+
+		return view;
+	}
+
+	/// <summary>
+	/// 左手座標系の透視投影行列を返す D3DXMatrixPerspectiveFovLHと同じ
+	/// </summary>
+	/// <param name="fovY">縦の視野角(弧度法)</param>
+	/// <param name="aspect">横幅/縦幅</param>
+	/// <param name="nearZ">近いクリップ面までの距離</param>
+	/// <param name="farZ">遠いクリップ面までの距離</param>
+	inline Mat4 PerspectiveFovLH(float fovY, float aspect, float nearZ, float farZ)
+	{
+		float yScale = 1.0f / std::tan(fovY * 0.5f);
+		float xScale = yScale / aspect;
+
+		Mat4 projection = {};
+
+		projection.m[0][0] = xScale;
+		projection.m[1][1] = yScale;
+		projection.m[2][2] = farZ / (farZ - nearZ);
+		projection.m[2][3] = 1.0f;
+		projection.m[3][2] = -nearZ * farZ / (farZ - nearZ);
+
+		return projection;
+	}
+
+	/// <summary>
+	/// (x, y, z, w)に行列を掛けた4要素を返す
+	/// </summary>
+	inline Vec4 Transform(const Vec4& rVec, const Mat4& rMatrix)
+	{
+		Vec4 result;
+
+#if defined(SIMD_MATH_SSE2)
+		__m128 resultRow = _mm_mul_ps(_mm_set1_ps(rVec.x), _mm_loadu_ps(rMatrix.m[0]));
+		resultRow = _mm_add_ps(resultRow, _mm_mul_ps(_mm_set1_ps(rVec.y), _mm_loadu_ps(rMatrix.m[1])));
+		resultRow = _mm_add_ps(resultRow, _mm_mul_ps(_mm_set1_ps(rVec.z), _mm_loadu_ps(rMatrix.m[2])));
+		resultRow = _mm_add_ps(resultRow, _mm_mul_ps(_mm_set1_ps(rVec.w), _mm_loadu_ps(rMatrix.m[3])));
+
+		_mm_storeu_ps(&result.x, resultRow);
+#elif defined(SIMD_MATH_NEON)
+		float32x4_t resultRow = vmulq_n_f32(vld1q_f32(rMatrix.m[0]), rVec.x);
+		resultRow = vmlaq_n_f32(resultRow, vld1q_f32(rMatrix.m[1]), rVec.y);
+		resultRow = vmlaq_n_f32(resultRow, vld1q_f32(rMatrix.m[2]), rVec.z);
+		resultRow = vmlaq_n_f32(resultRow, vld1q_f32(rMatrix.m[3]), rVec.w);
+
+		vst1q_f32(&result.x, resultRow);
+#else
+		float source[4] = { rVec.x, rVec.y, rVec.z, rVec.w };
+		float* pResult = &result.x;
+
+		for (int column = 0; column < 4; ++column)
+		{
+			pResult[column] =
+				source[0] * rMatrix.m[0][column] + source[1] * rMatrix.m[1][column] +
+				source[2] * rMatrix.m[2][column] + source[3] * rMatrix.m[3][column];
+		}
+#endif
+
+		return result;
+	}
+
+	/// <summary>
+	/// 座標(w = 1)として変換しwで割る D3DXVec3TransformCoordと同じ
+	/// </summary>
+	inline Vec3 TransformCoord(const Vec3& rVec, const Mat4& rMatrix)
+	{
+		Vec4 result = Transform(Vec4(rVec.x, rVec.y, rVec.z, 1.0f), rMatrix);
+
+		float inverseW = 1.0f / result.w;
+
+		return Vec3(result.x * inverseW, result.y * inverseW, result.z * inverseW);
+	}
+
+	/// <summary>
+	/// pDst[i] += pSrc[i] を要素数分行う 要素ごとの配列で持つ位置や速度の更新に用いる
+	/// </summary>
+	inline void AddArray(float* pDst, const float* pSrc, size_t count)
+	{
+		size_t i = 0;
+
+#if defined(SIMD_MATH_SSE2)
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pDst + i), _mm_loadu_ps(pSrc + i)));
+		}
+#elif defined(SIMD_MATH_NEON)
+		for (; i + 4 <= count; i += 4)
+		{
+			vst1q_f32(pDst + i, vaddq_f32(vld1q_f32(pDst + i), vld1q_f32(pSrc + i)));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			pDst[i] += pSrc[i];
+		}
+	}
+
+	/// <summary>
+	/// pDst[i] += value を要素数分行う
+	/// </summary>
+	inline void AddScalarArray(float* pDst, float value, size_t count)
+	{
+		size_t i = 0;
+
+#if defined(SIMD_MATH_SSE2)
+		__m128 values = _mm_set1_ps(value);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pDst + i), values));
+		}
+#elif defined(SIMD_MATH_NEON)
+		float32x4_t values = vdupq_n_f32(value);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			vst1q_f32(pDst + i, vaddq_f32(vld1q_f32(pDst + i), values));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			pDst[i] += value;
+		}
+	}
+
+	inline void AddScalarArray(int* pDst, int value, size_t count)
+	{
+		size_t i = 0;
+
+#if defined(SIMD_MATH_SSE2)
+		__m128i values = _mm_set1_epi32(value);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i* pDstValues = reinterpret_cast<__m128i*>(pDst + i);
+
+			_mm_storeu_si128(pDstValues, _mm_add_epi32(_mm_loadu_si128(pDstValues), values));
+		}
+#elif defined(SIMD_MATH_NEON)
+		int32x4_t values = vdupq_n_s32(value);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			vst1q_s32(pDst + i, vaddq_s32(vld1q_s32(pDst + i), values));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			pDst[i] += value;
+		}
+	}
+}
+#endif //! SIMD_MATH_H
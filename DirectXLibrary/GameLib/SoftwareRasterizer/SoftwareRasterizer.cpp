@@ -0,0 +1,613 @@
+﻿/// <filename>
+/// SoftwareRasterizer.cpp
+/// </filename>
+/// <summary>
+/// CustomVertexの矩形をCPUで描画するクラスのソース
+/// </summary>
+
+#include "SoftwareRasterizer.h"
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <vector>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <fstream>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+#include <cstdlib>
+#include <xmmintrin.h>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\ColorBlender\ColorBlender.h"
+#include "Wnd/Data/RectSize.h"
+#include "SimdMath\SimdMath.h"
+#include "IGameLibRenderer\RecordingRenderer\RecordingRenderer.h"
+
+SoftwareRasterizer::SoftwareRasterizer(const RectSize& frameSize, UINT threadsNum)
+	:m_FRAME_SIZE(frameSize), m_THREADS_NUM(threadsNum), m_shadedPixelsNum(0), m_writtenPixelsNum(0)
+{
+	m_tilesNumX = (m_FRAME_SIZE.m_x + m_TILE_SIZE - 1) / m_TILE_SIZE;
+	m_tilesNumY = (m_FRAME_SIZE.m_y + m_TILE_SIZE - 1) / m_TILE_SIZE;
+
+	m_tileQuadIndices.resize(m_tilesNumX * m_tilesNumY);
+
+	m_colorBuffer.resize(m_FRAME_SIZE.m_x * m_FRAME_SIZE.m_y * 4);
+	m_depthBuffer.resize(m_FRAME_SIZE.m_x * m_FRAME_SIZE.m_y);
+
+	Clear();
+}
+
+void SoftwareRasterizer::Clear(DWORD aRGB)
+{
+	const BYTE RGBA[4] =
+	{
+		static_cast<BYTE>(aRGB >> 16),
+		static_cast<BYTE>(aRGB >> 8),
+		static_cast<BYTE>(aRGB),
+		static_cast<BYTE>(aRGB >> 24)
+	};
+
+	for (size_t i = 0; i < m_colorBuffer.size(); i += 4)
+	{
+		memcpy(&m_colorBuffer[i], RGBA, sizeof(RGBA));
+	}
+
+	std::fill(m_depthBuffer.begin(), m_depthBuffer.end(), 1.0f);
+
+	m_quads.clear();
+
+	for (auto& rIndices : m_tileQuadIndices)
+	{
+		rIndices.clear();
+	}
+}
+
+void SoftwareRasterizer::Render(const CustomVertex* pCustomVertices, const SoftwareTexture* pTexture)
+{
+	Quad quad;
+	std::copy(pCustomVertices, pCustomVertices + CustomVertex::m_RECT_VERTICES_NUM, quad.m_vertices);
+	quad.m_pTexture		= pTexture;
+	quad.m_blendMode	= m_blendMode;
+
+	float minX = quad.m_vertices[0].m_pos.x, maxX = minX;
+	float minY = quad.m_vertices[0].m_pos.y, maxY = minY;
+
+	for (const CustomVertex& rVertex : quad.m_vertices)
+	{
+		minX = (std::min)(minX, rVertex.m_pos.x);
+		maxX = (std::max)(maxX, rVertex.m_pos.x);
+		minY = (std::min)(minY, rVertex.m_pos.y);
+		maxY = (std::max)(maxY, rVertex.m_pos.y);
+	}
+
+	if (maxX < 0.0f || maxY < 0.0f || minX >= m_FRAME_SIZE.m_x || minY >= m_FRAME_SIZE.m_y) return;
+
+	int tileLeft	= (std::max)(0, static_cast<int>(minX) / m_TILE_SIZE);
+	int tileTop		= (std::max)(0, static_cast<int>(minY) / m_TILE_SIZE);
+	int tileRight	= (std::min)(m_tilesNumX - 1, static_cast<int>(maxX) / m_TILE_SIZE);
+	int tileBottom	= (std::min)(m_tilesNumY - 1, static_cast<int>(maxY) / m_TILE_SIZE);
+
+	UINT quadIndex = static_cast<UINT>(m_quads.size());
+	m_quads.push_back(quad);
+
+	for (int y = tileTop; y <= tileBottom; ++y)
+	{
+		for (int x = tileLeft; x <= tileRight; ++x)
+		{
+			m_tileQuadIndices[y * m_tilesNumX + x].push_back(quadIndex);
+		}
+	}
+}
+
+void SoftwareRasterizer::Flush()
+{
+	if (m_quads.empty()) return;
+
+	const int TILES_NUM = m_tilesNumX * m_tilesNumY;
+
+	std::atomic<int> nextTileIndex(0);
+
+	auto rasterizeTiles = [&]()
+	{
+		UINT64 shadedPixelsNum	= 0;
+		UINT64 writtenPixelsNum = 0;
+
+		//! 画素を共有しないのでタイル単位で取り合えば排他制御は要らない
+		for (int tileIndex = nextTileIndex++; tileIndex < TILES_NUM; tileIndex = nextTileIndex++)
+		{
+			RasterizeTile(tileIndex, &shadedPixelsNum, &writtenPixelsNum);
+		}
+
+		m_shadedPixelsNum	+= shadedPixelsNum;
+		m_writtenPixelsNum	+= writtenPixelsNum;
+	};
+
+	std::vector<std::thread> workers;
+
+	for (UINT i = 1; i < m_THREADS_NUM; ++i)
+	{
+		workers.emplace_back(rasterizeTiles);
+	}
+
+	rasterizeTiles();
+
+	for (std::thread& rWorker : workers)
+	{
+		rWorker.join();
+	}
+
+	m_quads.clear();
+
+	for (auto& rIndices : m_tileQuadIndices)
+	{
+		rIndices.clear();
+	}
+}
+
+void SoftwareRasterizer::Replay(const std::vector<BYTE>& commands, const std::map<UINT, const SoftwareTexture*>& textures)
+{
+	using COMMAND = RecordingRenderer::COMMAND;
+
+	//! RenderQueueのキーと同じくレイヤー,色の合成,テクスチャの積まれた順,奥からの順に並べる
+	struct SubmittedRect
+	{
+	public:
+		BYTE m_layer = 0;
+		BYTE m_blendMode = 0;
+		WORD m_submittedTexId = 0;
+		UINT m_texId = 0;
+		float m_depth = 0.0f;
+
+		CustomVertex m_vertices[CustomVertex::m_RECT_VERTICES_NUM];
+	};
+
+	std::vector<SubmittedRect> submittedRects;
+
+	//! RenderQueue::GetTexIdと同じく,画面内に積まれたテクスチャへ最初に現れた順で番号を振る
+	std::map<UINT, WORD> submittedTexIds;
+
+	size_t offset = 0;
+
+	auto read = [&](void* pDst, size_t size)
+	{
+		memcpy(pDst, &commands[offset], size);
+
+		offset += size;
+	};
+
+	auto skipText = [&]()
+	{
+		UINT textLength = 0;
+		read(&textLength, sizeof(textLength));
+
+		offset += textLength * sizeof(TCHAR);
+	};
+
+	while (offset < commands.size())
+	{
+		COMMAND command = static_cast<COMMAND>(commands[offset++]);
+
+		switch (command)
+		{
+		case COMMAND::RENDER_RECT:
+		{
+			UINT texId = 0;
+			read(&texId, sizeof(texId));
+
+			CustomVertex vertices[CustomVertex::m_RECT_VERTICES_NUM];
+			read(vertices, sizeof(vertices));
+
+			auto texture = textures.find(texId);
+
+			Render(vertices, (texture != textures.end()) ? texture->second : nullptr);
+		}
+			break;
+
+		case COMMAND::SUBMIT_RECT:
+		{
+			SubmittedRect submittedRect;
+			read(&submittedRect.m_texId, sizeof(submittedRect.m_texId));
+			read(&submittedRect.m_layer, sizeof(submittedRect.m_layer));
+			read(&submittedRect.m_blendMode, sizeof(submittedRect.m_blendMode));
+			read(submittedRect.m_vertices, sizeof(submittedRect.m_vertices));
+
+			float minX = submittedRect.m_vertices[0].m_pos.x, maxX = minX;
+			float minY = submittedRect.m_vertices[0].m_pos.y, maxY = minY;
+
+			for (const CustomVertex& rVertex : submittedRect.m_vertices)
+			{
+				submittedRect.m_depth += rVertex.m_pos.z;
+
+				minX = (std::min)(minX, rVertex.m_pos.x);
+				maxX = (std::max)(maxX, rVertex.m_pos.x);
+				minY = (std::min)(minY, rVertex.m_pos.y);
+				maxY = (std::max)(maxY, rVertex.m_pos.y);
+			}
+
+			submittedRect.m_depth /= CustomVertex::m_RECT_VERTICES_NUM;
+
+			//! Cullerが除外する画面外の矩形には番号を振らない
+			if (maxX < 0.0f || minX > m_FRAME_SIZE.m_x || maxY < 0.0f || minY > m_FRAME_SIZE.m_y) break;
+
+			auto submittedTexId = submittedTexIds.emplace(submittedRect.m_texId, static_cast<WORD>(submittedTexIds.size())).first;
+			submittedRect.m_submittedTexId = submittedTexId->second;
+
+			submittedRects.push_back(submittedRect);
+		}
+			break;
+
+		case COMMAND::RENDER_VERTEX_3D:
+			offset += sizeof(UINT) + sizeof(SimdMath::Mat4) + sizeof(Vertex3D) * 4;
+			break;
+
+		case COMMAND::RENDER_FBX:
+			offset += sizeof(UINT) + sizeof(SimdMath::Mat4) + sizeof(UINT);
+			break;
+
+		case COMMAND::RENDER_TEXT:
+			offset += sizeof(UINT) + sizeof(SimdMath::Vec2) + sizeof(UINT) + sizeof(DWORD);
+			skipText();
+			break;
+
+		case COMMAND::DEFAULT_BLEND_MODE:
+		case COMMAND::DEFAULT_COLOR_BLENDING:
+			DefaultBlendMode();
+			break;
+
+		case COMMAND::ADDTION_BLEND_MODE:
+			AddtionBlendMode();
+			break;
+
+		case COMMAND::SET_RECT_ALPHA:
+			offset += sizeof(BYTE);
+			break;
+
+		case COMMAND::CREATE_TEX:
+			offset += sizeof(UINT);
+			skipText();
+			break;
+
+		case COMMAND::RELEASE_TEX:
+		case COMMAND::ON_LIGHT:
+		case COMMAND::OFF_LIGHT:
+		case COMMAND::CHANGE_AMBIENT:
+			offset += sizeof(DWORD);
+			break;
+
+		case COMMAND::SET_LIGHT:
+			offset += sizeof(DWORD) + sizeof(D3DLIGHT9);
+			break;
+
+		case COMMAND::SET_CAMERA_TRANSFORM:
+			offset += sizeof(SimdMath::Mat4) * 2;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	std::stable_sort(submittedRects.begin(), submittedRects.end(),
+		[](const SubmittedRect& rLeft, const SubmittedRect& rRight)
+	{
+		return std::make_tuple(rLeft.m_layer, rLeft.m_blendMode, rLeft.m_submittedTexId, -rLeft.m_depth) <
+			std::make_tuple(rRight.m_layer, rRight.m_blendMode, rRight.m_submittedTexId, -rRight.m_depth);
+	});
+
+	ColorBlender::BLEND_MODE prevBlendMode = m_blendMode;
+
+	for (const SubmittedRect& rSubmittedRect : submittedRects)
+	{
+		m_blendMode = static_cast<ColorBlender::BLEND_MODE>(rSubmittedRect.m_blendMode);
+
+		auto texture = textures.find(rSubmittedRect.m_texId);
+
+		Render(rSubmittedRect.m_vertices, (texture != textures.end()) ? texture->second : nullptr);
+	}
+
+	m_blendMode = prevBlendMode;
+
+	Flush();
+}
+
+bool SoftwareRasterizer::SaveTGA(const TCHAR* pFilePath) const
+{
+	std::ofstream file(pFilePath, std::ios::binary);
+
+	if (!file) return false;
+
+	//! 無圧縮フルカラー 画像記述子の0x20で左上原点,0x08でアルファ8bit
+	BYTE header[18] = {};
+	header[2]	= 2;
+	header[12]	= static_cast<BYTE>(m_FRAME_SIZE.m_x);
+	header[13]	= static_cast<BYTE>(m_FRAME_SIZE.m_x >> 8);
+	header[14]	= static_cast<BYTE>(m_FRAME_SIZE.m_y);
+	header[15]	= static_cast<BYTE>(m_FRAME_SIZE.m_y >> 8);
+	header[16]	= 32;
+	header[17]	= 0x28;
+
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+	//! TGAはBGRAの順
+	std::vector<BYTE> bGRA(m_colorBuffer.size());
+
+	for (size_t i = 0; i < m_colorBuffer.size(); i += 4)
+	{
+		bGRA[i]		= m_colorBuffer[i + 2];
+		bGRA[i + 1] = m_colorBuffer[i + 1];
+		bGRA[i + 2] = m_colorBuffer[i];
+		bGRA[i + 3] = m_colorBuffer[i + 3];
+	}
+
+	file.write(reinterpret_cast<const char*>(bGRA.data()), bGRA.size());
+
+	return static_cast<bool>(file);
+}
+
+bool SoftwareRasterizer::LoadTGA(SoftwareTexture* pTexture, const TCHAR* pFilePath)
+{
+	std::ifstream file(pFilePath, std::ios::binary);
+
+	if (!file) return false;
+
+	BYTE header[18] = {};
+	file.read(reinterpret_cast<char*>(header), sizeof(header));
+
+	const int BYTES_PER_PIXEL = header[16] / 8;
+
+	if (!file || header[2] != 2 || (BYTES_PER_PIXEL != 3 && BYTES_PER_PIXEL != 4)) return false;
+
+	file.seekg(header[0], std::ios::cur);
+
+	int width			= header[12] | (header[13] << 8);
+	int height			= header[14] | (header[15] << 8);
+	bool isTopOrigin	= (header[17] & 0x20) != 0;
+
+	std::vector<BYTE> pixels(width * height * BYTES_PER_PIXEL);
+	file.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+
+	if (!file) return false;
+
+	pTexture->m_width	= width;
+	pTexture->m_height	= height;
+	pTexture->m_texels.resize(width * height);
+
+	for (int y = 0; y < height; ++y)
+	{
+		int srcY = (isTopOrigin) ? y : height - 1 - y;
+
+		for (int x = 0; x < width; ++x)
+		{
+			const BYTE* pSrc = &pixels[(srcY * width + x) * BYTES_PER_PIXEL];
+
+			DWORD alpha = (BYTES_PER_PIXEL == 4) ? pSrc[3] : 0xFF;
+
+			pTexture->m_texels[y * width + x] = D3DCOLOR_ARGB(alpha, pSrc[2], pSrc[1], pSrc[0]);
+		}
+	}
+
+	return true;
+}
+
+UINT SoftwareRasterizer::CountDifferentPixels(const SoftwareTexture& reference, int tolerance) const
+{
+	const UINT PIXELS_NUM = static_cast<UINT>(m_FRAME_SIZE.m_x * m_FRAME_SIZE.m_y);
+
+	if (reference.m_width != m_FRAME_SIZE.m_x || reference.m_height != m_FRAME_SIZE.m_y) return PIXELS_NUM;
+
+	UINT differentPixelsNum = 0;
+
+	for (UINT i = 0; i < PIXELS_NUM; ++i)
+	{
+		DWORD referenceARGB = reference.m_texels[i];
+
+		//! フレームバッファと同じRGBAの順に並べる
+		const int REFERENCE_RGBA[4] =
+		{
+			static_cast<int>((referenceARGB >> 16) & 0xFF),
+			static_cast<int>((referenceARGB >> 8) & 0xFF),
+			static_cast<int>(referenceARGB & 0xFF),
+			static_cast<int>(referenceARGB >> 24)
+		};
+
+		const BYTE* pPixel = &m_colorBuffer[i * 4];
+
+		for (int component = 0; component < 4; ++component)
+		{
+			if (std::abs(pPixel[component] - REFERENCE_RGBA[component]) <= tolerance) continue;
+
+			++differentPixelsNum;
+
+			break;
+		}
+	}
+
+	return differentPixelsNum;
+}
+
+void SoftwareRasterizer::RasterizeTile(int tileIndex, UINT64* pShadedPixelsNum, UINT64* pWrittenPixelsNum)
+{
+	RECT tileRect;
+	tileRect.left	= (tileIndex % m_tilesNumX) * m_TILE_SIZE;
+	tileRect.top	= (tileIndex / m_tilesNumX) * m_TILE_SIZE;
+	tileRect.right	= (std::min)(static_cast<int>(tileRect.left) + m_TILE_SIZE, m_FRAME_SIZE.m_x);
+	tileRect.bottom = (std::min)(static_cast<int>(tileRect.top) + m_TILE_SIZE, m_FRAME_SIZE.m_y);
+
+	for (UINT quadIndex : m_tileQuadIndices[tileIndex])
+	{
+		const Quad& rQuad = m_quads[quadIndex];
+
+		//! SpriteBatchのインデックスと同じ0-1-2,0-2-3の三角形
+		RasterizeTriangle(rQuad, 0, 1, 2, tileRect, pShadedPixelsNum, pWrittenPixelsNum);
+		RasterizeTriangle(rQuad, 0, 2, 3, tileRect, pShadedPixelsNum, pWrittenPixelsNum);
+	}
+}
+
+void SoftwareRasterizer::RasterizeTriangle(const Quad& rQuad, int index0, int index1, int index2, const RECT& rTileRect,
+	UINT64* pShadedPixelsNum, UINT64* pWrittenPixelsNum)
+{
+	const CustomVertex* pVertices[3] = { &rQuad.m_vertices[index0], &rQuad.m_vertices[index1], &rQuad.m_vertices[index2] };
+
+	const D3DXVECTOR3& rPos0 = pVertices[0]->m_pos;
+	const D3DXVECTOR3& rPos1 = pVertices[1]->m_pos;
+	const D3DXVECTOR3& rPos2 = pVertices[2]->m_pos;
+
+	float area = (rPos1.x - rPos0.x) * (rPos2.y - rPos0.y) - (rPos1.y - rPos0.y) * (rPos2.x - rPos0.x);
+
+	//! D3DCULL_CCWと同じくスクリーン上で反時計回りの三角形は描画しない
+	if (area <= 0.0f) return;
+
+	int left	= (std::max)(static_cast<int>(rTileRect.left),		static_cast<int>(std::ceil((std::min)({ rPos0.x, rPos1.x, rPos2.x }))));
+	int top		= (std::max)(static_cast<int>(rTileRect.top),		static_cast<int>(std::ceil((std::min)({ rPos0.y, rPos1.y, rPos2.y }))));
+	int right	= (std::min)(static_cast<int>(rTileRect.right) - 1,	static_cast<int>(std::floor((std::max)({ rPos0.x, rPos1.x, rPos2.x }))));
+	int bottom	= (std::min)(static_cast<int>(rTileRect.bottom) - 1,static_cast<int>(std::floor((std::max)({ rPos0.y, rPos1.y, rPos2.y }))));
+
+	if (left > right || top > bottom) return;
+
+	//! 辺iは頂点iの向かいの辺 E(x,y) = A*x + B*y + C
+	float edgeA[3], edgeB[3], edgeC[3];
+	bool isTopLeft[3];
+
+	for (int i = 0; i < 3; ++i)
+	{
+		const D3DXVECTOR3& rStart	= pVertices[(i + 1) % 3]->m_pos;
+		const D3DXVECTOR3& rEnd		= pVertices[(i + 2) % 3]->m_pos;
+
+		edgeA[i] = -(rEnd.y - rStart.y);
+		edgeB[i] = rEnd.x - rStart.x;
+		edgeC[i] = -(edgeA[i] * rStart.x + edgeB[i] * rStart.y);
+
+		//! トップレフトルール 境界上の画素は上の辺か左の辺に属するときのみ描画する
+		bool isTop	= (rStart.y == rEnd.y) && (rEnd.x > rStart.x);
+		bool isLeft = rEnd.y < rStart.y;
+		isTopLeft[i] = isTop || isLeft;
+	}
+
+	const float INV_AREA = 1.0f / area;
+
+	const __m128 ZERO		= _mm_setzero_ps();
+	const __m128 LANE_X		= _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+
+	for (int y = top; y <= bottom; ++y)
+	{
+		for (int x = left; x <= right; x += 4)
+		{
+			__m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), LANE_X);
+			__m128 pixelY = _mm_set1_ps(static_cast<float>(y));
+
+			__m128 edges[3];
+			__m128 coverage = _mm_cmple_ps(pixelX, _mm_set1_ps(static_cast<float>(right)));
+
+			for (int i = 0; i < 3; ++i)
+			{
+				edges[i] = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[i]), pixelX), _mm_mul_ps(_mm_set1_ps(edgeB[i]), pixelY)),
+					_mm_set1_ps(edgeC[i]));
+
+				__m128 inside = (isTopLeft[i]) ? _mm_cmpge_ps(edges[i], ZERO) : _mm_cmpgt_ps(edges[i], ZERO);
+
+				coverage = _mm_and_ps(coverage, inside);
+			}
+
+			int coverageMask = _mm_movemask_ps(coverage);
+
+			if (!coverageMask) continue;
+
+			alignas(16) float weights[3][4];
+
+			for (int i = 0; i < 3; ++i)
+			{
+				_mm_store_ps(weights[i], _mm_mul_ps(edges[i], _mm_set1_ps(INV_AREA)));
+			}
+
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				if (!(coverageMask & (1 << lane))) continue;
+
+				++(*pShadedPixelsNum);
+
+				float weight[3] = { weights[0][lane], weights[1][lane], weights[2][lane] };
+
+				//! Zはスクリーン空間で線形に補間する
+				float z = weight[0] * rPos0.z + weight[1] * rPos1.z + weight[2] * rPos2.z;
+
+				int pixelIndex = y * m_FRAME_SIZE.m_x + x + lane;
+
+				if (z > m_depthBuffer[pixelIndex]) continue;
+
+				//! 色とテクスチャ座標はrHWを用いてパースペクティブコレクトに補間する
+				float perspectiveWeight[3];
+				float perspectiveWeightSum = 0.0f;
+
+				for (int i = 0; i < 3; ++i)
+				{
+					perspectiveWeight[i] = weight[i] * pVertices[i]->m_rHW;
+					perspectiveWeightSum += perspectiveWeight[i];
+				}
+
+				float u = 0.0f, v = 0.0f;
+				float diffuse[4] = {};
+
+				for (int i = 0; i < 3; ++i)
+				{
+					float w = perspectiveWeight[i] / perspectiveWeightSum;
+
+					u += w * pVertices[i]->m_texUV.x;
+					v += w * pVertices[i]->m_texUV.y;
+
+					DWORD aRGB = pVertices[i]->m_aRGB;
+
+					diffuse[0] += w * ((aRGB >> 16) & 0xFF);
+					diffuse[1] += w * ((aRGB >> 8) & 0xFF);
+					diffuse[2] += w * (aRGB & 0xFF);
+					diffuse[3] += w * (aRGB >> 24);
+				}
+
+				//! テクスチャがない場合は白の不透明として乗算する
+				DWORD texel = (rQuad.m_pTexture) ? Sample(rQuad.m_pTexture, u, v) : 0xFFFFFFFF;
+
+				int srcR = static_cast<int>(diffuse[0] * ((texel >> 16) & 0xFF) / 255.0f + 0.5f);
+				int srcG = static_cast<int>(diffuse[1] * ((texel >> 8) & 0xFF) / 255.0f + 0.5f);
+				int srcB = static_cast<int>(diffuse[2] * (texel & 0xFF) / 255.0f + 0.5f);
+				int srcA = static_cast<int>(diffuse[3] * (texel >> 24) / 255.0f + 0.5f);
+
+				if (srcA < m_ALPHA_REF) continue;
+
+				m_depthBuffer[pixelIndex] = z;
+
+				BYTE* pDst = &m_colorBuffer[pixelIndex * 4];
+
+				//! 加算合成ではDESTBLENDがONE,通常合成ではINVSRCALPHA
+				int dstFactor = (rQuad.m_blendMode == ColorBlender::BLEND_MODE::ADDITION) ? 255 : 255 - srcA;
+
+				pDst[0] = static_cast<BYTE>((std::min)(255, (srcR * srcA + pDst[0] * dstFactor + 127) / 255));
+				pDst[1] = static_cast<BYTE>((std::min)(255, (srcG * srcA + pDst[1] * dstFactor + 127) / 255));
+				pDst[2] = static_cast<BYTE>((std::min)(255, (srcB * srcA + pDst[2] * dstFactor + 127) / 255));
+				pDst[3] = static_cast<BYTE>((std::min)(255, (srcA * srcA + pDst[3] * dstFactor + 127) / 255));
+
+				++(*pWrittenPixelsNum);
+			}
+		}
+	}
+}
+
+DWORD SoftwareRasterizer::Sample(const SoftwareTexture* pTexture, float u, float v)
+{
+	if (pTexture->m_texels.empty()) return 0xFFFFFFFF;
+
+	//! D3DTADDRESS_WRAPとD3DTEXF_POINTの組み合わせ
+	int x = static_cast<int>(std::floor(u * pTexture->m_width))	% pTexture->m_width;
+	int y = static_cast<int>(std::floor(v * pTexture->m_height))	% pTexture->m_height;
+
+	if (x < 0) x += pTexture->m_width;
+	if (y < 0) y += pTexture->m_height;
+
+	return pTexture->m_texels[y * pTexture->m_width + x];
+}
@@ -0,0 +1,213 @@
+﻿/// <filename>
+/// SoftwareRasterizer.h
+/// </filename>
+/// <summary>
+/// CustomVertexの矩形をCPUで描画するクラスのヘッダ
+/// </summary>
+
+#ifndef SOFTWARE_RASTERIZER_H
+#define SOFTWARE_RASTERIZER_H
+
+#include <Windows.h>
+#include <tchar.h>
+
+#include <vector>
+#include <map>
+#include <atomic>
+#include <thread>
+
+#include <d3dx9.h>
+
+#include "CustomVertex.h"
+#include "DX\DX3D\ColorBlender\ColorBlender.h"
+#include "Wnd/Data/RectSize.h"
+
+/// <summary>
+/// SoftwareRasterizerで用いるテクスチャ
+/// </summary>
+struct SoftwareTexture
+{
+public:
+	//! ARGBのテクセルを左上から行の順に並べたもの
+	std::vector<DWORD> m_texels;
+
+	int m_width		= 0;
+	int m_height	= 0;
+};
+
+/// <summary>
+/// CustomVertex(XYZRHW|DIFFUSE|TEX1)の矩形をCPUでRGBAのフレームバッファへ描画するクラス
+/// GPUのない環境でのゴールデンイメージの作成やエフェクトのフィルレートの計測に用いる
+/// </summary>
+/// <remarks>
+/// ColorBlender::DefaultColorBlendingの状態を再現する
+/// 通常合成(SRCALPHA,INVSRCALPHA),加算合成(SRCALPHA,ONE),アルファテスト(0x01以上),
+/// テクスチャと頂点色の乗算,ポイントサンプリングのラップ,Zテスト(LESSEQUAL),反時計回りのカリング
+/// 矩形は描画した順にタイルごとへ振り分け,タイルを複数のスレッドで処理する
+/// デバイスは使わないがCustomVertexがD3DXの型を含むのでDirectX SDKのヘッダには依存する
+/// </remarks>
+class SoftwareRasterizer
+{
+public:
+	/// <param name="frameSize">フレームバッファのサイズ</param>
+	/// <param name="threadsNum">タイルを処理するスレッドの数 1以下なら呼び出したスレッドのみで処理する</param>
+	explicit SoftwareRasterizer(const RectSize& frameSize, UINT threadsNum = std::thread::hardware_concurrency());
+	~SoftwareRasterizer() {};
+
+	/// <summary>
+	/// フレームバッファを引数の色で,深度を1.0fで塗りつぶす 溜めている矩形は破棄される
+	/// </summary>
+	/// <param name="aRGB">塗りつぶす色</param>
+	void Clear(DWORD aRGB = 0xFF000000);
+
+	/// <summary>
+	/// 色の合成を通常合成に変更する 以降に追加した矩形に適用される
+	/// </summary>
+	inline void DefaultBlendMode()
+	{
+		m_blendMode = ColorBlender::BLEND_MODE::DEFAULT;
+	}
+
+	/// <summary>
+	/// 色の合成を加算合成に変更する 以降に追加した矩形に適用される
+	/// </summary>
+	inline void AddtionBlendMode()
+	{
+		m_blendMode = ColorBlender::BLEND_MODE::ADDITION;
+	}
+
+	/// <summary>
+	/// 矩形を追加する 実際の描画はFlushで行う
+	/// </summary>
+	/// <param name="pCustomVertices">[in]描画する矩形の頂点データの先頭ポインタ</param>
+	/// <param name="pTexture">[in]矩形に張り付けるテクスチャ nullptrなら頂点色のみ</param>
+	void Render(const CustomVertex* pCustomVertices, const SoftwareTexture* pTexture = nullptr);
+
+	/// <summary>
+	/// 溜めている矩形をタイルに振り分けフレームバッファへ描画する
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// RecordingRendererが記録した命令列のうち矩形の描画と色の合成の変更を再生しFlushする
+	/// Submitで積まれた矩形はRenderQueueと同じ順に並べ替え,他の描画の後に描画する
+	/// </summary>
+	/// <param name="commands">[in]RecordingRenderer::GetCommandsで取得した命令列</param>
+	/// <param name="textures">[in]RecordingRendererのテクスチャ番号とテクスチャの対応 見つからなければ頂点色のみ</param>
+	void Replay(const std::vector<BYTE>& commands, const std::map<UINT, const SoftwareTexture*>& textures);
+
+	/// <summary>
+	/// フレームバッファを取得する
+	/// </summary>
+	/// <returns>1画素4バイトRGBAの順で左上から行の順に並べたもの</returns>
+	inline const std::vector<BYTE>& GetFrameBuffer() const
+	{
+		return m_colorBuffer;
+	}
+
+	/// <summary>
+	/// 三角形に覆われ色の計算を行った画素の数を取得する フィルレートの計測に用いる
+	/// </summary>
+	inline UINT64 GetShadedPixelsNum() const
+	{
+		return m_shadedPixelsNum;
+	}
+
+	/// <summary>
+	/// アルファテストとZテストを通過しフレームバッファに書き込んだ画素の数を取得する
+	/// </summary>
+	inline UINT64 GetWrittenPixelsNum() const
+	{
+		return m_writtenPixelsNum;
+	}
+
+	/// <summary>
+	/// 計測した画素の数を0にする
+	/// </summary>
+	inline void ResetStats()
+	{
+		m_shadedPixelsNum	= 0;
+		m_writtenPixelsNum	= 0;
+	}
+
+	/// <summary>
+	/// フレームバッファを32bit無圧縮のTGAで保存する
+	/// </summary>
+	/// <param name="pFilePath">[in]保存先のパス</param>
+	/// <returns>成功したらtrue</returns>
+	bool SaveTGA(const TCHAR* pFilePath) const;
+
+	/// <summary>
+	/// 24bitか32bitの無圧縮のTGAをテクスチャとして読み込む
+	/// </summary>
+	/// <param name="pTexture">[out]読み込んだテクセルを入れる</param>
+	/// <param name="pFilePath">[in]読み込むTGAのパス</param>
+	/// <returns>成功したらtrue</returns>
+	static bool LoadTGA(SoftwareTexture* pTexture, const TCHAR* pFilePath);
+
+	/// <summary>
+	/// フレームバッファとリファレンス画像を比べ,いずれかの成分の差が許容値を超える画素の数を数える
+	/// </summary>
+	/// <param name="reference">[in]LoadTGAで読み込んだリファレンス画像</param>
+	/// <param name="tolerance">成分ごとに許容する差</param>
+	/// <returns>異なる画素の数 サイズが異なる場合はフレームバッファの全画素の数</returns>
+	UINT CountDifferentPixels(const SoftwareTexture& reference, int tolerance) const;
+
+private:
+	/// <summary>
+	/// 描画を待っている矩形
+	/// </summary>
+	struct Quad
+	{
+	public:
+		CustomVertex m_vertices[CustomVertex::m_RECT_VERTICES_NUM];
+
+		const SoftwareTexture* m_pTexture = nullptr;
+
+		ColorBlender::BLEND_MODE m_blendMode = ColorBlender::BLEND_MODE::DEFAULT;
+	};
+
+	/// <summary>
+	/// タイルに振り分けた矩形を描画した順に処理する
+	/// </summary>
+	void RasterizeTile(int tileIndex, UINT64* pShadedPixelsNum, UINT64* pWrittenPixelsNum);
+
+	/// <summary>
+	/// 三角形のうちタイルに含まれる部分を描画する 4画素ずつSSEでエッジ関数を評価する
+	/// </summary>
+	void RasterizeTriangle(const Quad& rQuad, int index0, int index1, int index2, const RECT& rTileRect,
+		UINT64* pShadedPixelsNum, UINT64* pWrittenPixelsNum);
+
+	/// <summary>
+	/// テクスチャから引数の座標のテクセルをポイントサンプリングで取得する
+	/// </summary>
+	static DWORD Sample(const SoftwareTexture* pTexture, float u, float v);
+
+	static const int m_TILE_SIZE = 64;
+
+	//! DefaultColorBlendingのD3DRS_ALPHAREFと同じ値
+	static const int m_ALPHA_REF = 0x01;
+
+	const RectSize m_FRAME_SIZE;
+
+	const UINT m_THREADS_NUM;
+
+	int m_tilesNumX = 0;
+	int m_tilesNumY = 0;
+
+	std::vector<BYTE> m_colorBuffer;
+
+	std::vector<float> m_depthBuffer;
+
+	std::vector<Quad> m_quads;
+
+	//! タイルごとに含まれる矩形の番号 追加した順に並ぶ
+	std::vector<std::vector<UINT>> m_tileQuadIndices;
+
+	ColorBlender::BLEND_MODE m_blendMode = ColorBlender::BLEND_MODE::DEFAULT;
+
+	std::atomic<UINT64> m_shadedPixelsNum;
+	std::atomic<UINT64> m_writtenPixelsNum;
+};
+
+#endif //! SOFTWARE_RASTERIZER_H
@@ -91,7 +91,7 @@ bool TimerManager::CanStartNextFrame()
 	if (currenFrameSynctTime_ms - m_prevFrameSyncTime_ms < 1000 / m_fPS) return false;
 
 	// 一フレームにかかった時間をDeltaTime_sのため取得する
-	m_processTimeAtPrevFrame_ms = m_prevFrameSyncTime_ms - currenFrameSynctTime_ms;
+	m_processTimeAtPrevFrame_ms = currenFrameSynctTime_ms - m_prevFrameSyncTime_ms;
 
 	m_prevFrameSyncTime_ms = currenFrameSynctTime_ms;
 
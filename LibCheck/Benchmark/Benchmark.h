@@ -0,0 +1,50 @@
+﻿/// <filename>
+/// Benchmark.h
+/// </filename>
+/// <summary>
+/// 検証の速度を測る共通の処理のヘッダ
+/// </summary>
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <chrono>
+
+/// <summary>
+/// 検証の速度を測る共通の処理 各検証のRunBenchmarkから用いる
+/// </summary>
+namespace Benchmark
+{
+	//! 速度を測る要素の数
+	const UINT ITEMS_NUMS[] = { 1000, 10000, 100000 };
+
+	//! 要素の数によらず測る時間がそろうように繰り返す要素の総数
+	const UINT TOTAL_ITEMS_NUM = 10000000;
+
+	/// <summary>
+	/// 処理を要素の総数がTOTAL_ITEMS_NUMになるまで繰り返し,1ミリ秒あたりの要素の数を求める
+	/// </summary>
+	/// <param name="itemsNum">一度の処理で扱う要素の数</param>
+	/// <param name="func">測る処理</param>
+	template<typename FUNC>
+	double MeasureItemsPerMillisecond(UINT itemsNum, FUNC func)
+	{
+		UINT repeatsNum = (std::max)(TOTAL_ITEMS_NUM / itemsNum, 1U);
+
+		auto startTime = std::chrono::steady_clock::now();
+
+		for (UINT i = 0; i < repeatsNum; ++i)
+		{
+			func();
+		}
+
+		std::chrono::duration<double, std::milli> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+		return static_cast<double>(itemsNum) * repeatsNum / elapsedTime.count();
+	}
+}
+
+#endif //! BENCHMARK_H
@@ -0,0 +1,172 @@
+﻿/// <filename>
+/// BoardInstanceRendererCheck.cpp
+/// </filename>
+/// <summary>
+/// BoardInstanceRendererが板ポリをテクスチャごとにまとめて描画するかを検証するソース
+/// </summary>
+
+#include "BoardInstanceRendererCheck.h"
+
+#include <Windows.h>
+#include <tchar.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include <d3dx9.h>
+
+#include "3DBoard\3DBoard.h"
+#include "3DBoard\BoardInstanceRenderer\BoardInstanceRenderer.h"
+#include "3DBoard\BoardInstanceRenderer\IBoardInstanceBackend.h"
+
+namespace
+{
+	const UINT CHECK_BOARDS_NUM = 10000;
+
+	//! 描画先は中身を参照しないので,テクスチャの代わりに別々の値を渡す
+	const LPDIRECT3DTEXTURE9 TEXTURE_A = reinterpret_cast<LPDIRECT3DTEXTURE9>(static_cast<UINT_PTR>(0x10));
+	const LPDIRECT3DTEXTURE9 TEXTURE_B = reinterpret_cast<LPDIRECT3DTEXTURE9>(static_cast<UINT_PTR>(0x20));
+
+	/// <summary>
+	/// 描画せずに,渡されたまとまりを数えて保持する描画先
+	/// </summary>
+	class CountingBoardInstanceBackend : public IBoardInstanceBackend
+	{
+	public:
+		struct Batch
+		{
+		public:
+			LPDIRECT3DTEXTURE9 m_pTexture = nullptr;
+
+			std::vector<BoardInstance> m_instances;
+		};
+
+		void DrawBatch(const BoardInstance* pInstances, UINT instancesNum, const LPDIRECT3DTEXTURE9 pTexture)
+		{
+			Batch batch;
+			batch.m_pTexture = pTexture;
+			batch.m_instances.assign(pInstances, pInstances + instancesNum);
+
+			m_batches.push_back(batch);
+		}
+
+		std::vector<Batch> m_batches;
+	};
+
+	/// <summary>
+	/// 板ポリを一枚ずつ作成して積む 色に通し番号を入れて,まとめた後の順番を確かめられるようにする
+	/// </summary>
+	/// <param name="pSelectTexture">通し番号からテクスチャを選ぶ関数</param>
+	void SubmitBoards(BoardInstanceRenderer* pBoardInstanceRenderer, LPDIRECT3DTEXTURE9(*pSelectTexture)(UINT))
+	{
+		Board3D board3D;
+
+		D3DXMATRIX world;
+		D3DXMatrixIdentity(&world);
+
+		BoardInstance instance;
+
+		for (UINT i = 0; i < CHECK_BOARDS_NUM; ++i)
+		{
+			board3D.CreateInstance(&instance, world, i);
+
+			pBoardInstanceRenderer->Submit(&instance, 1, pSelectTexture(i));
+		}
+	}
+
+	/// <summary>
+	/// まとまりのテクスチャと,色に入れた通し番号が期待通りか
+	/// </summary>
+	/// <param name="firstIndex">まとまりの先頭の通し番号</param>
+	/// <param name="indexStep">通し番号の間隔</param>
+	bool MatchesBatch(const CountingBoardInstanceBackend::Batch& rBatch, LPDIRECT3DTEXTURE9 pTexture, UINT instancesNum, UINT firstIndex, UINT indexStep)
+	{
+		if (rBatch.m_pTexture != pTexture || rBatch.m_instances.size() != instancesNum) return false;
+
+		for (UINT i = 0; i < instancesNum; ++i)
+		{
+			if (rBatch.m_instances[i].m_aRGB != firstIndex + i * indexStep) return false;
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// 全ての板ポリが同じテクスチャの場合,一度の描画にまとまるか
+	/// </summary>
+	bool RunSharedTexture()
+	{
+		BoardInstanceRenderer boardInstanceRenderer;
+		CountingBoardInstanceBackend backend;
+
+		SubmitBoards(&boardInstanceRenderer, [](UINT) { return TEXTURE_A; });
+
+		boardInstanceRenderer.Flush(&backend);
+
+		const BoardInstanceStats& rStats = boardInstanceRenderer.GetStats();
+
+		bool isPassed = backend.m_batches.size() == 1 && MatchesBatch(backend.m_batches[0], TEXTURE_A, CHECK_BOARDS_NUM, 0, 1) &&
+			rStats.m_batchesNum == 1 && rStats.m_instancesNum == CHECK_BOARDS_NUM;
+
+		if (isPassed)
+		{
+			_tprintf(_T("[OK] BoardInstanceRenderer: %u boards sharing a texture are drawn in 1 batch\n"), CHECK_BOARDS_NUM);
+		}
+		else
+		{
+			_tprintf(_T("[FAILED] BoardInstanceRenderer: %u boards sharing a texture are drawn in %u batch(es)\n"),
+				CHECK_BOARDS_NUM, static_cast<UINT>(backend.m_batches.size()));
+		}
+
+		return isPassed;
+	}
+
+	/// <summary>
+	/// テクスチャを交互に切り替えて積んだ場合,テクスチャごとに初めに積まれた順でまとまり,まとまりの中は積んだ順に並ぶか
+	/// Flushの後は空になり,次のFlushで何も描画しないかも確かめる
+	/// </summary>
+	bool RunAlternatingTextures()
+	{
+		BoardInstanceRenderer boardInstanceRenderer;
+		CountingBoardInstanceBackend backend;
+
+		SubmitBoards(&boardInstanceRenderer, [](UINT index) { return (index % 2 == 0) ? TEXTURE_A : TEXTURE_B; });
+
+		boardInstanceRenderer.Flush(&backend);
+
+		const UINT HALF_BOARDS_NUM = CHECK_BOARDS_NUM / 2;
+
+		bool isBatched = backend.m_batches.size() == 2 &&
+			MatchesBatch(backend.m_batches[0], TEXTURE_A, HALF_BOARDS_NUM, 0, 2) &&
+			MatchesBatch(backend.m_batches[1], TEXTURE_B, HALF_BOARDS_NUM, 1, 2);
+
+		boardInstanceRenderer.Flush(&backend);
+
+		bool isCleared = backend.m_batches.size() == 2 && boardInstanceRenderer.GetStats().m_batchesNum == 0;
+
+		bool isPassed = isBatched && isCleared;
+
+		if (isPassed)
+		{
+			_tprintf(_T("[OK] BoardInstanceRenderer: %u boards alternating 2 textures are drawn in 2 batches in order\n"), CHECK_BOARDS_NUM);
+		}
+		else
+		{
+			_tprintf(_T("[FAILED] BoardInstanceRenderer: boards alternating 2 textures %s\n"),
+				isBatched ? _T("are drawn again after Flush") : _T("are not grouped into 2 ordered batches"));
+		}
+
+		return isPassed;
+	}
+}
+
+namespace BoardInstanceRendererCheck
+{
+	bool Run()
+	{
+		bool isSharedTexturePassed			= RunSharedTexture();
+		bool isAlternatingTexturesPassed	= RunAlternatingTextures();
+
+		return isSharedTexturePassed && isAlternatingTexturesPassed;
+	}
+}
@@ -0,0 +1,23 @@
+﻿/// <filename>
+/// BoardInstanceRendererCheck.h
+/// </filename>
+/// <summary>
+/// BoardInstanceRendererが板ポリをテクスチャごとにまとめて描画するかを検証するヘッダ
+/// </summary>
+
+#ifndef BOARD_INSTANCE_RENDERER_CHECK_H
+#define BOARD_INSTANCE_RENDERER_CHECK_H
+
+/// <summary>
+/// BoardInstanceRendererが板ポリをテクスチャごとにまとめて描画するかを検証する
+/// </summary>
+namespace BoardInstanceRendererCheck
+{
+	/// <summary>
+	/// 一枚ずつ積んだ板ポリを描画の回数を数える描画先へ渡し,同じテクスチャの板ポリが一度の描画にまとまるかを確かめる
+	/// </summary>
+	/// <returns>描画の回数とインスタンスの数と順番が全て一致すればtrue</returns>
+	bool Run();
+}
+
+#endif //! BOARD_INSTANCE_RENDERER_CHECK_H
@@ -0,0 +1,179 @@
+﻿/// <filename>
+/// CustomVertexEditorCheck.cpp
+/// </filename>
+/// <summary>
+/// CustomVertexEditorのまとめて計算する関数を検証し速度を測るソース
+/// </summary>
+
+#include "CustomVertexEditorCheck.h"
+
+#include <Windows.h>
+#include <tchar.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <d3dx9.h>
+
+#include "DX\DX3D\CustomVertexEditor\CustomVertexEditor.h"
+#include "CustomVertex.h"
+#include "VerticesParam.h"
+
+#include "..\Benchmark\Benchmark.h"
+
+namespace
+{
+	//! 矩形ごとの計算とは回転行列の掛け方が異なるので,その分の誤差を許容する(ピクセル)
+	const float POS_TOLERANCE = 1.0e-3f;
+
+	//! 4矩形ずつ計算する端数も通るように4の倍数にしない
+	const UINT CHECK_RECTS_NUM = 1003;
+
+	/// <summary>
+	/// 乱数で矩形の状態を作成する 回転しない矩形も混ぜる
+	/// </summary>
+	std::vector<VerticesParam> CreateVerticesParams(UINT rectsNum, unsigned int seed)
+	{
+		std::mt19937 randEngine(seed);
+		std::uniform_real_distribution<float> pos(0.0f, 1280.0f);
+		std::uniform_real_distribution<float> scale(1.0f, 64.0f);
+		std::uniform_real_distribution<float> deg(-180.0f, 180.0f);
+
+		std::vector<VerticesParam> verticesParams(rectsNum);
+
+		for (UINT i = 0; i < rectsNum; ++i)
+		{
+			VerticesParam& rVerticesParam = verticesParams[i];
+
+			rVerticesParam.m_center		= D3DXVECTOR3(pos(randEngine), pos(randEngine), 0.0f);
+			rVerticesParam.m_halfScale	= D3DXVECTOR3(scale(randEngine), scale(randEngine), 0.0f);
+
+			if (i % 5 == 0) continue;
+
+			rVerticesParam.m_deg = RotateValueXYZ(deg(randEngine), deg(randEngine), deg(randEngine));
+		}
+
+		return verticesParams;
+	}
+
+	/// <summary>
+	/// 2つの頂点データ配列の座標の差の最大を求める
+	/// </summary>
+	float GetMaxPosError(const std::vector<CustomVertex>& rExpected, const std::vector<CustomVertex>& rActual)
+	{
+		float maxError = 0.0f;
+
+		for (size_t i = 0; i < rExpected.size(); ++i)
+		{
+			D3DXVECTOR3 difference = rExpected[i].m_pos - rActual[i].m_pos;
+
+			maxError = (std::max)(maxError, (std::max)(std::fabs(difference.x), (std::max)(std::fabs(difference.y), std::fabs(difference.z))));
+		}
+
+		return maxError;
+	}
+
+	bool CheckPosError(const TCHAR* pName, const std::vector<CustomVertex>& rExpected, const std::vector<CustomVertex>& rActual)
+	{
+		float maxError = GetMaxPosError(rExpected, rActual);
+
+		bool isPassed = (maxError <= POS_TOLERANCE);
+
+		_tprintf(_T("[%s] CustomVertexEditor %s: max error %g px (max %g)\n"), (isPassed) ? _T("OK") : _T("FAILED"), pName, maxError, POS_TOLERANCE);
+
+		return isPassed;
+	}
+}
+
+namespace CustomVertexEditorCheck
+{
+	bool Run()
+	{
+		CustomVertexEditor customVertexEditor(nullptr);
+
+		std::vector<VerticesParam> verticesParams = CreateVerticesParams(CHECK_RECTS_NUM, 1);
+
+		std::vector<CustomVertex> expected(CHECK_RECTS_NUM * CustomVertex::m_RECT_VERTICES_NUM);
+		std::vector<CustomVertex> actual(expected.size());
+
+		bool isPassed = true;
+
+		//! 作成
+		for (UINT i = 0; i < CHECK_RECTS_NUM; ++i)
+		{
+			customVertexEditor.Create(&expected[i * CustomVertex::m_RECT_VERTICES_NUM], verticesParams[i]);
+		}
+
+		customVertexEditor.CreateBatch(actual.data(), verticesParams.data(), CHECK_RECTS_NUM);
+
+		isPassed &= CheckPosError(_T("CreateBatch"), expected, actual);
+
+		//! 作成済みの矩形をさらに回転させる
+		std::vector<RotateValueXYZ> degs(CHECK_RECTS_NUM);
+		std::vector<D3DXVECTOR2> scaleRates(CHECK_RECTS_NUM);
+
+		std::vector<VerticesParam> otherVerticesParams = CreateVerticesParams(CHECK_RECTS_NUM, 2);
+
+		for (UINT i = 0; i < CHECK_RECTS_NUM; ++i)
+		{
+			degs[i]			= otherVerticesParams[i].m_deg;
+			scaleRates[i]	= D3DXVECTOR2(otherVerticesParams[i].m_halfScale.x / 32.0f, otherVerticesParams[i].m_halfScale.y / 32.0f);
+		}
+
+		actual = expected;
+
+		for (UINT i = 0; i < CHECK_RECTS_NUM; ++i)
+		{
+			customVertexEditor.RotateXYZ(&expected[i * CustomVertex::m_RECT_VERTICES_NUM], degs[i]);
+		}
+
+		customVertexEditor.RotateXYZBatch(actual.data(), degs.data(), CHECK_RECTS_NUM);
+
+		isPassed &= CheckPosError(_T("RotateXYZBatch"), expected, actual);
+
+		//! 拡縮は矩形ごとの計算と同じ順番で計算するので一致する
+		actual = expected;
+
+		for (UINT i = 0; i < CHECK_RECTS_NUM; ++i)
+		{
+			customVertexEditor.Rescale(&expected[i * CustomVertex::m_RECT_VERTICES_NUM], scaleRates[i]);
+		}
+
+		customVertexEditor.RescaleBatch(actual.data(), scaleRates.data(), CHECK_RECTS_NUM);
+
+		isPassed &= CheckPosError(_T("RescaleBatch"), expected, actual);
+
+		return isPassed;
+	}
+
+	void RunBenchmark()
+	{
+		CustomVertexEditor customVertexEditor(nullptr);
+
+		for (UINT rectsNum : Benchmark::ITEMS_NUMS)
+		{
+			std::vector<VerticesParam> verticesParams = CreateVerticesParams(rectsNum, 3);
+
+			std::vector<CustomVertex> customVertices(rectsNum * CustomVertex::m_RECT_VERTICES_NUM);
+
+			double createRectsPerMs = Benchmark::MeasureItemsPerMillisecond(rectsNum, [&]()
+			{
+				for (UINT i = 0; i < rectsNum; ++i)
+				{
+					customVertexEditor.Create(&customVertices[i * CustomVertex::m_RECT_VERTICES_NUM], verticesParams[i]);
+				}
+			});
+
+			double createBatchRectsPerMs = Benchmark::MeasureItemsPerMillisecond(rectsNum, [&]()
+			{
+				customVertexEditor.CreateBatch(customVertices.data(), verticesParams.data(), rectsNum);
+			});
+
+			_tprintf(_T("CustomVertexEditor: %6u quads: Create %.0f quads/ms, CreateBatch %.0f quads/ms (x%.2f)\n"),
+				rectsNum, createRectsPerMs, createBatchRectsPerMs, createBatchRectsPerMs / createRectsPerMs);
+		}
+	}
+}
@@ -0,0 +1,28 @@
+﻿/// <filename>
+/// CustomVertexEditorCheck.h
+/// </filename>
+/// <summary>
+/// CustomVertexEditorのまとめて計算する関数を検証し速度を測るヘッダ
+/// </summary>
+
+#ifndef CUSTOM_VERTEX_EDITOR_CHECK_H
+#define CUSTOM_VERTEX_EDITOR_CHECK_H
+
+/// <summary>
+/// CustomVertexEditorのまとめて計算する関数を検証し速度を測る
+/// </summary>
+namespace CustomVertexEditorCheck
+{
+	/// <summary>
+	/// CreateBatch,RotateXYZBatch,RescaleBatchの結果を矩形ごとに計算する関数の結果と比べる
+	/// </summary>
+	/// <returns>全ての頂点が許容誤差に収まればtrue</returns>
+	bool Run();
+
+	/// <summary>
+	/// 矩形ごとに計算する場合とまとめて計算する場合の1ミリ秒あたりの矩形の数を矩形の数ごとに表示する
+	/// </summary>
+	void RunBenchmark();
+}
+
+#endif //! CUSTOM_VERTEX_EDITOR_CHECK_H
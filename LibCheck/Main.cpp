@@ -0,0 +1,58 @@
+﻿/// <filename>
+/// Main.cpp
+/// </filename>
+/// <summary>
+/// ライブラリの検証を行うコンソールアプリのエントリポイント
+/// </summary>
+/// <remarks>
+/// LibCheck.exe [/update] [/benchmark]
+/// リファレンス画像は作業ディレクトリからの相対パスで読み書きするのでLibCheckのディレクトリで実行する
+/// /updateを付けると比較をせずにリファレンス画像を作り直す
+/// /benchmarkを付けると検証の後に速度を測って表示する 速度は終了コードに含めない Releaseで実行する
+/// 失敗した検証の数を終了コードとして返す
+/// </remarks>
+
+#include <Windows.h>
+#include <tchar.h>
+#include <stdio.h>
+
+#include "SoftwareRasterizerCheck\SoftwareRasterizerCheck.h"
+#include "CustomVertexEditorCheck\CustomVertexEditorCheck.h"
+#include "ParticleStorageCheck\ParticleStorageCheck.h"
+#include "ParticleCollisionWorldCheck\ParticleCollisionWorldCheck.h"
+#include "BoardInstanceRendererCheck\BoardInstanceRendererCheck.h"
+
+int _tmain(int argc, TCHAR* argv[])
+{
+	bool updatesReference	= false;
+	bool runsBenchmark		= false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (_tcscmp(argv[i], _T("/update")) == 0) updatesReference = true;
+
+		if (_tcscmp(argv[i], _T("/benchmark")) == 0) runsBenchmark = true;
+	}
+
+	int failedChecksNum = 0;
+
+	if (!SoftwareRasterizerCheck::Run(updatesReference)) ++failedChecksNum;
+
+	if (!CustomVertexEditorCheck::Run()) ++failedChecksNum;
+
+	if (!ParticleStorageCheck::Run()) ++failedChecksNum;
+
+	if (!ParticleCollisionWorldCheck::Run()) ++failedChecksNum;
+
+	if (!BoardInstanceRendererCheck::Run()) ++failedChecksNum;
+
+	if (runsBenchmark)
+	{
+		CustomVertexEditorCheck::RunBenchmark();
+		ParticleStorageCheck::RunBenchmark();
+	}
+
+	_tprintf(_T("%d check(s) failed\n"), failedChecksNum);
+
+	return failedChecksNum;
+}
@@ -0,0 +1,395 @@
+﻿/// <filename>
+/// ParticleCollisionWorldCheck.cpp
+/// </filename>
+/// <summary>
+/// ParticleCollisionWorldの衝突判定を検証するソース
+/// </summary>
+
+#include "ParticleCollisionWorldCheck.h"
+
+#include <Windows.h>
+#include <tchar.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <climits>
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include <d3dx9.h>
+
+#include "EffectManager\ParticleCollisionWorld\ParticleCollisionWorld.h"
+#include "EffectManager\Effect\ParticleStorage\ParticleStorage.h"
+#include "EffectManager\Effect\Particle\Particle.h"
+
+namespace
+{
+	typedef ParticleCollider::SHAPE SHAPE;
+	typedef ParticleCollider::RESPONSE RESPONSE;
+
+	const D3DXVECTOR2 VIEWPORT_SIZE(640.0f, 640.0f);
+
+	const float RESTITUTION = 0.5f;
+
+	//! 物体を一つずつ置く升目の大きさと,升目の端から物体を離す距離
+	//! 線分同士の間隔がパーティクルの1フレームに動く距離より広くなるようにする
+	const float SLOT_SIZE	= 64.0f;
+	const float SLOT_INSET	= 12.0f;
+
+	//! 小さい物体を並べる升目の数 残りの下側には格子に入らない大きな物体を一つ置く
+	const int SLOTS_X_NUM = 10;
+	const int SLOTS_Y_NUM = 7;
+
+	//! 升目より小さく,大きな物体がm_CELLS_PER_COLLIDER_MAXより多くの格子を覆う大きさ
+	const float HASHED_CELL_SIZE = 24.0f;
+
+	//! 全ての物体が一つの格子に入り,総当たりで判定される大きさ
+	const float BRUTE_FORCE_CELL_SIZE = 1.0e6f;
+
+	const UINT CHECK_PARTICLES_NUM = 20000;
+
+	//! パーティクルを置く範囲 画面の外も含める
+	const float PARTICLE_POS_MIN = -40.0f;
+	const float PARTICLE_POS_MAX = 680.0f;
+
+	//! 1フレームに動く距離 各成分がHASHED_CELL_SIZEより小さくなければならない
+	const float PARTICLE_SPEED_MAX = 12.0f;
+
+	//! 線分で止めたパーティクルは線分から少しだけ離されるので,その分の許容誤差
+	const float SURFACE_TOLERANCE = 0.1f;
+
+	const SHAPE SHAPES[] = { SHAPE::RECT, SHAPE::CIRCLE, SHAPE::SEGMENT, SHAPE::BOUNDS };
+
+	const RESPONSE RESPONSES[] = { RESPONSE::BOUNCE, RESPONSE::STICK, RESPONSE::KILL };
+
+	const TCHAR* ToString(SHAPE shape)
+	{
+		switch (shape)
+		{
+		case SHAPE::RECT:
+			return _T("rect");
+
+		case SHAPE::CIRCLE:
+			return _T("circle");
+
+		case SHAPE::SEGMENT:
+			return _T("segment");
+
+		default:
+			return _T("bounds");
+		}
+	}
+
+	const TCHAR* ToString(RESPONSE response)
+	{
+		switch (response)
+		{
+		case RESPONSE::BOUNCE:
+			return _T("bounce");
+
+		case RESPONSE::STICK:
+			return _T("stick");
+
+		default:
+			return _T("kill");
+		}
+	}
+
+	/// <summary>
+	/// 上面がy = 100,画面の範囲の場合は下端の物体を一つだけ入れる
+	/// </summary>
+	/// <returns>物体の面のy座標</returns>
+	float AddSurface(ParticleCollisionWorld* pParticleCollisionWorld, SHAPE shape, RESPONSE response)
+	{
+		switch (shape)
+		{
+		case SHAPE::RECT:
+			pParticleCollisionWorld->AddRect(D3DXVECTOR2(100.0f, 100.0f), D3DXVECTOR2(200.0f, 200.0f), response, RESTITUTION);
+
+			return 100.0f;
+
+		case SHAPE::CIRCLE:
+			pParticleCollisionWorld->AddCircle(D3DXVECTOR2(150.0f, 150.0f), 50.0f, response, RESTITUTION);
+
+			return 100.0f;
+
+		case SHAPE::SEGMENT:
+			pParticleCollisionWorld->AddSegment(D3DXVECTOR2(100.0f, 100.0f), D3DXVECTOR2(200.0f, 100.0f), response, RESTITUTION);
+
+			return 100.0f;
+
+		default:
+			pParticleCollisionWorld->SetViewportBounds(VIEWPORT_SIZE, response, RESTITUTION);
+
+			return VIEWPORT_SIZE.y;
+		}
+	}
+
+	/// <summary>
+	/// 真下へ撃ったパーティクルが面で止まり,衝突した後の扱い通りの速度になるか
+	/// </summary>
+	bool RunResponse(SHAPE shape, RESPONSE response)
+	{
+		ParticleCollisionWorld particleCollisionWorld;
+
+		float surfaceY = AddSurface(&particleCollisionWorld, shape, response);
+
+		particleCollisionWorld.Build();
+
+		const D3DXVECTOR2 VELOCITY(0.0f, 20.0f);
+
+		D3DXVECTOR2 prevCenter(150.0f, surfaceY - 10.0f);
+		D3DXVECTOR2 center = prevCenter + VELOCITY;
+		D3DXVECTOR2 velocity = VELOCITY;
+		RESPONSE collidedResponse = RESPONSE::BOUNCE;
+
+		bool collides = particleCollisionWorld.Collide(prevCenter, &center, &velocity, &collidedResponse);
+
+		D3DXVECTOR2 expectedVelocity = VELOCITY;
+
+		if (response == RESPONSE::BOUNCE) expectedVelocity = -VELOCITY * RESTITUTION;
+
+		if (response == RESPONSE::STICK) expectedVelocity = { 0.0f, 0.0f };
+
+		bool isPassed = collides && collidedResponse == response &&
+			center.x == prevCenter.x && fabsf(center.y - surfaceY) <= SURFACE_TOLERANCE &&
+			velocity == expectedVelocity;
+
+		if (!isPassed)
+		{
+			_tprintf(_T("[FAILED] ParticleCollisionWorld: %s %s ends at (%g, %g) moving (%g, %g)\n"),
+				ToString(shape), ToString(response), center.x, center.y, velocity.x, velocity.y);
+		}
+
+		return isPassed;
+	}
+
+	/// <summary>
+	/// 升目ごとに一つずつ小さい物体を置き,下側に格子に入らない大きな物体を一つ置く 画面の範囲も同じ扱いで判定する
+	/// </summary>
+	void AddColliders(ParticleCollisionWorld* pParticleCollisionWorld, SHAPE shape, RESPONSE response)
+	{
+		std::mt19937 randEngine(1);
+		std::uniform_real_distribution<float> slotPos(SLOT_INSET, SLOT_SIZE - SLOT_INSET);
+
+		for (int y = 0; y < SLOTS_Y_NUM; ++y)
+		{
+			for (int x = 0; x < SLOTS_X_NUM; ++x)
+			{
+				D3DXVECTOR2 slotOrigin(x * SLOT_SIZE, y * SLOT_SIZE);
+				D3DXVECTOR2 a = slotOrigin + D3DXVECTOR2(slotPos(randEngine), slotPos(randEngine));
+				D3DXVECTOR2 b = slotOrigin + D3DXVECTOR2(slotPos(randEngine), slotPos(randEngine));
+
+				switch (shape)
+				{
+				case SHAPE::RECT:
+					pParticleCollisionWorld->AddRect(D3DXVECTOR2((std::min)(a.x, b.x), (std::min)(a.y, b.y)),
+						D3DXVECTOR2((std::max)(a.x, b.x), (std::max)(a.y, b.y)), response, RESTITUTION);
+
+					break;
+
+				case SHAPE::CIRCLE:
+					pParticleCollisionWorld->AddCircle(slotOrigin + D3DXVECTOR2(SLOT_SIZE, SLOT_SIZE) * 0.5f,
+						(std::min)(fabsf(a.x - b.x), SLOT_SIZE * 0.5f - SLOT_INSET), response, RESTITUTION);
+
+					break;
+
+				default:
+					pParticleCollisionWorld->AddSegment(a, b, response, RESTITUTION);
+
+					break;
+				}
+			}
+		}
+
+		float largeTop = SLOTS_Y_NUM * SLOT_SIZE + SLOT_INSET;
+
+		switch (shape)
+		{
+		case SHAPE::RECT:
+			pParticleCollisionWorld->AddRect(D3DXVECTOR2(20.0f, largeTop), D3DXVECTOR2(620.0f, 620.0f), response, RESTITUTION);
+
+			break;
+
+		case SHAPE::CIRCLE:
+			pParticleCollisionWorld->AddCircle(D3DXVECTOR2(320.0f, largeTop + 90.0f), 90.0f, response, RESTITUTION);
+
+			break;
+
+		default:
+			pParticleCollisionWorld->AddSegment(D3DXVECTOR2(20.0f, largeTop + 60.0f), D3DXVECTOR2(620.0f, largeTop + 100.0f), response, RESTITUTION);
+
+			break;
+		}
+
+		pParticleCollisionWorld->SetViewportBounds(VIEWPORT_SIZE, response, RESTITUTION);
+	}
+
+	/// <summary>
+	/// 空間ハッシュで判定した結果が,総当たりで判定した結果とビット単位で一致するか
+	/// 物体に衝突したパーティクルと画面の範囲に衝突したパーティクルがどちらもあるかも確かめる
+	/// </summary>
+	bool RunBruteForce(SHAPE shape, RESPONSE response)
+	{
+		ParticleCollisionWorld hashed;
+		ParticleCollisionWorld bruteForce;
+
+		hashed.SetCellSize(HASHED_CELL_SIZE);
+		bruteForce.SetCellSize(BRUTE_FORCE_CELL_SIZE);
+
+		AddColliders(&hashed, shape, response);
+		AddColliders(&bruteForce, shape, response);
+
+		hashed.Build();
+		bruteForce.Build();
+
+		std::mt19937 randEngine(2);
+		std::uniform_real_distribution<float> pos(PARTICLE_POS_MIN, PARTICLE_POS_MAX);
+		std::uniform_real_distribution<float> speed(-PARTICLE_SPEED_MAX, PARTICLE_SPEED_MAX);
+
+		UINT collidersHitsNum	= 0;
+		UINT boundsHitsNum		= 0;
+		UINT mismatchedIndex	= UINT_MAX;
+
+		for (UINT i = 0; i < CHECK_PARTICLES_NUM && mismatchedIndex == UINT_MAX; ++i)
+		{
+			D3DXVECTOR2 center(pos(randEngine), pos(randEngine));
+			D3DXVECTOR2 velocity(speed(randEngine), speed(randEngine));
+			D3DXVECTOR2 prevCenter = center - velocity;
+
+			bool isInViewport = 0.0f <= center.x && center.x <= VIEWPORT_SIZE.x && 0.0f <= center.y && center.y <= VIEWPORT_SIZE.y;
+
+			D3DXVECTOR2 expectedCenter		= center;
+			D3DXVECTOR2 expectedVelocity	= velocity;
+			RESPONSE expectedResponse		= RESPONSE::BOUNCE;
+			RESPONSE actualResponse			= RESPONSE::BOUNCE;
+
+			bool expectedCollides	= bruteForce.Collide(prevCenter, &expectedCenter, &expectedVelocity, &expectedResponse);
+			bool actualCollides		= hashed.Collide(prevCenter, &center, &velocity, &actualResponse);
+
+			if (actualCollides != expectedCollides ||
+				memcmp(&center, &expectedCenter, sizeof(center)) != 0 ||
+				memcmp(&velocity, &expectedVelocity, sizeof(velocity)) != 0 ||
+				(expectedCollides && actualResponse != expectedResponse))
+			{
+				mismatchedIndex = i;
+			}
+
+			if (!expectedCollides) continue;
+
+			if (isInViewport)
+			{
+				++collidersHitsNum;
+			}
+			else
+			{
+				++boundsHitsNum;
+			}
+		}
+
+		bool isPassed = (mismatchedIndex == UINT_MAX && collidersHitsNum > 0 && boundsHitsNum > 0);
+
+		if (!isPassed)
+		{
+			_tprintf(_T("[FAILED] ParticleCollisionWorld: %s %s "), ToString(shape), ToString(response));
+
+			if (mismatchedIndex != UINT_MAX)
+			{
+				_tprintf(_T("differs from brute force at particle %u\n"), mismatchedIndex);
+			}
+			else
+			{
+				_tprintf(_T("hits %u collider(s) and %u bounds, expected both\n"), collidersHitsNum, boundsHitsNum);
+			}
+		}
+
+		return isPassed;
+	}
+
+	/// <summary>
+	/// 固定の間隔の更新を描画より多く行った場合も,保持した一つ前の中心から線分を横切ったかを判定するか
+	/// 一つ前の状態が別のパーティクルのものである,初期化しなおしたパーティクルは速度から判定するか
+	/// </summary>
+	bool RunPrevCenter()
+	{
+		ParticleCollisionWorld particleCollisionWorld;
+
+		particleCollisionWorld.AddSegment(D3DXVECTOR2(0.0f, 100.0f), D3DXVECTOR2(VIEWPORT_SIZE.x, 100.0f), RESPONSE::KILL);
+
+		particleCollisionWorld.Build();
+
+		ParticleStorage particleStorage(2);
+
+		particleStorage.Seed(1);
+
+		UINT crossingIndex = 0;
+		UINT respawnedIndex = 0;
+
+		particleStorage.Emit(&crossingIndex);
+		particleStorage.Emit(&respawnedIndex);
+
+		Particle crossing(&particleStorage, crossingIndex);
+
+		crossing.FormatCenter(D3DXVECTOR3(150.0f, 95.0f, 0.0f), 0.0f);
+		crossing.ZeroVelocity();
+		crossing.Accelarate(D3DXVECTOR2(0.0f, 10.0f));
+
+		Particle(&particleStorage, respawnedIndex).FormatCenter(D3DXVECTOR3(300.0f, 90.0f, 0.0f), 0.0f);
+
+		particleStorage.SaveRenderState();
+
+		//! 2回動かして線分を越え,速度だけ戻した位置も線分の向こう側にする
+		particleStorage.UpdateAll();
+		particleStorage.UpdateAll();
+
+		//! 保持した位置から見ると線分を横切っているが,速度から見ると横切っていない位置で生まれなおさせる
+		Particle respawned(&particleStorage, respawnedIndex);
+
+		respawned.FormatCenter(D3DXVECTOR3(300.0f, 110.0f, 0.0f), 0.0f);
+		respawned.ZeroVelocity();
+		respawned.Accelarate(D3DXVECTOR2(0.0f, 5.0f));
+
+		particleStorage.CollideAll(particleCollisionWorld);
+
+		bool isPassed = (particleStorage.GetAliveNum() == 1 && Particle(&particleStorage, 0).GetCenter().x == 300.0f);
+
+		if (!isPassed)
+		{
+			_tprintf(_T("[FAILED] ParticleCollisionWorld: segment %s\n"),
+				(particleStorage.GetAliveNum() == 2) ? _T("misses a particle moved twice since the saved state") : _T("kills a respawned particle from its old position"));
+		}
+
+		return isPassed;
+	}
+}
+
+namespace ParticleCollisionWorldCheck
+{
+	bool Run()
+	{
+		bool isPassed = true;
+
+		for (SHAPE shape : SHAPES)
+		{
+			for (RESPONSE response : RESPONSES)
+			{
+				isPassed = RunResponse(shape, response) && isPassed;
+
+				//! 画面の範囲は格子に入らないので,他の形の組み合わせで判定する
+				if (shape == SHAPE::BOUNDS) continue;
+
+				isPassed = RunBruteForce(shape, response) && isPassed;
+			}
+		}
+
+		isPassed = RunPrevCenter() && isPassed;
+
+		if (isPassed)
+		{
+			_tprintf(_T("[OK] ParticleCollisionWorld: every shape and response matches brute force over %u particles\n"), CHECK_PARTICLES_NUM);
+		}
+
+		return isPassed;
+	}
+}
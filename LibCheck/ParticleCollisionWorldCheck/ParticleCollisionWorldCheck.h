@@ -0,0 +1,25 @@
+﻿/// <filename>
+/// ParticleCollisionWorldCheck.h
+/// </filename>
+/// <summary>
+/// ParticleCollisionWorldの衝突判定を検証するヘッダ
+/// </summary>
+
+#ifndef PARTICLE_COLLISION_WORLD_CHECK_H
+#define PARTICLE_COLLISION_WORLD_CHECK_H
+
+/// <summary>
+/// ParticleCollisionWorldの衝突判定を検証する
+/// </summary>
+namespace ParticleCollisionWorldCheck
+{
+	/// <summary>
+	/// 形と衝突した後の扱いの組み合わせごとに,まっすぐ撃ったパーティクルが決まった位置と速度になるかを確かめる
+	/// 空間ハッシュで判定した結果を,格子を一つにして全ての物体と総当たりで判定した結果と比べる
+	/// 線分を横切ったかを保持した一つ前の中心で判定するかも確かめる
+	/// </summary>
+	/// <returns>全ての判定が一致すればtrue</returns>
+	bool Run();
+}
+
+#endif //! PARTICLE_COLLISION_WORLD_CHECK_H
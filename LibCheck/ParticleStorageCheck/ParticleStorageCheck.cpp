@@ -0,0 +1,317 @@
+﻿/// <filename>
+/// ParticleStorageCheck.cpp
+/// </filename>
+/// <summary>
+/// ParticleStorageの全てのパーティクルをまとめて処理する関数を検証し速度を測るソース
+/// </summary>
+
+#include "ParticleStorageCheck.h"
+
+#include <Windows.h>
+#include <tchar.h>
+#include <stdio.h>
+
+#include <climits>
+#include <cstring>
+#include <vector>
+
+#include <d3dx9.h>
+
+#include "EffectManager\Effect\ParticleStorage\ParticleStorage.h"
+#include "EffectManager\Effect\Particle\Particle.h"
+#include "VerticesParam.h"
+
+#include "..\Benchmark\Benchmark.h"
+
+namespace
+{
+	//! SIMD命令で4つずつ処理する端数も通るように4の倍数にしない
+	const UINT CHECK_PARTICLES_NUM = 1003;
+
+	//! フェードインとフェードアウトの途中と終わりを全て通るだけ進める
+	const UINT CHECK_STEPS_NUM = 60;
+
+	//! サンプルのエフェクトと同じ,一回の更新で行う処理
+	const D3DXVECTOR2 GRAVITY(0.0f, 0.1f);
+	const RotateValueXYZ ROTATION(0.0f, 0.0f, 3.0f);
+	const int FADE_IN_START_FRAME	= 0;
+	const int FADE_IN_TAKES_FRAME	= 10;
+	const int FADE_OUT_START_FRAME	= 15;
+	const int FADE_OUT_TAKES_FRAME	= 20;
+
+	//! サンプルの花びらのエフェクトと同じ,パーティクルごとに乱数で変える揺れと回転の範囲
+	const D3DXVECTOR2 SWAY_MIN(-1.0f, 0.0f);
+	const D3DXVECTOR2 SWAY_MAX(1.0f, 0.0f);
+	const RotateValueXYZ RANDOM_ROTATION_MIN(0.0f, 0.0f, 0.0f);
+	const RotateValueXYZ RANDOM_ROTATION_MAX(4.0f, 4.0f, 4.0f);
+
+	//! 初期化しなおしたパーティクルを置く,元の位置から離れた位置
+	const D3DXVECTOR3 RESPAWN_CENTER(0.0f, -100.0f, 0.0f);
+
+	//! 描画の際の補間の割合
+	const float INTERPOLATION = 0.5f;
+
+	/// <summary>
+	/// 同じシードで同じ数のパーティクルを同じ順番で初期化する
+	/// </summary>
+	void EmitParticles(ParticleStorage* pParticleStorage, UINT particlesNum)
+	{
+		pParticleStorage->Seed(1);
+
+		UINT index = 0;
+
+		for (UINT i = 0; i < particlesNum && pParticleStorage->Emit(&index); ++i)
+		{
+			Particle particle(pParticleStorage, index);
+
+			particle.FormatShape(D3DXVECTOR2(1.5f, 1.5f), 2.0f);
+			particle.SetColor(0x0087CEFA);
+			particle.FormatCenter(D3DXVECTOR3(640.0f, 360.0f, 0.0f), 20.0f);
+			particle.ZeroLifeFrame();
+			particle.ZeroVelocity();
+			particle.FormatRadiationInitialVelocity(2.0f, 0.0f);
+		}
+	}
+
+	void StepAll(ParticleStorage* pParticleStorage)
+	{
+		pParticleStorage->FadeInAll(FADE_IN_START_FRAME, FADE_IN_TAKES_FRAME);
+		pParticleStorage->FadeOutAll(FADE_OUT_START_FRAME, FADE_OUT_TAKES_FRAME);
+		pParticleStorage->RotateAll(ROTATION);
+		pParticleStorage->AccelerateAll(GRAVITY);
+		pParticleStorage->UpdateAll();
+	}
+
+	void StepEach(ParticleStorage* pParticleStorage)
+	{
+		for (UINT i = 0; i < pParticleStorage->GetAliveNum(); ++i)
+		{
+			Particle particle(pParticleStorage, i);
+
+			particle.FadeIn(FADE_IN_START_FRAME, FADE_IN_TAKES_FRAME);
+			particle.FadeOut(FADE_OUT_START_FRAME, FADE_OUT_TAKES_FRAME);
+			particle.RotateX(ROTATION.x);
+			particle.RotateY(ROTATION.y);
+			particle.RotateZ(ROTATION.z);
+			particle.Accelarate(GRAVITY);
+			particle.Update();
+		}
+	}
+
+	/// <summary>
+	/// 全てのパーティクルの矩形を作成するためのデータが一致するか
+	/// </summary>
+	bool Matches(ParticleStorage* pExpected, ParticleStorage* pActual)
+	{
+		if (pExpected->GetAliveNum() != pActual->GetAliveNum()) return false;
+
+		VerticesParam expected;
+		VerticesParam actual;
+
+		for (UINT i = 0; i < pExpected->GetAliveNum(); ++i)
+		{
+			Particle(pExpected, i).GetVerticesParam(&expected);
+			Particle(pActual, i).GetVerticesParam(&actual);
+
+			if (memcmp(&expected.m_center, &actual.m_center, sizeof(expected.m_center)) != 0 ||
+				memcmp(&expected.m_halfScale, &actual.m_halfScale, sizeof(expected.m_halfScale)) != 0 ||
+				memcmp(&expected.m_deg, &actual.m_deg, sizeof(expected.m_deg)) != 0 ||
+				expected.m_aRGB != actual.m_aRGB)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// 初期状態のパーティクルに乱数の揺れと回転を一度だけ足し,中心を揺れの分だけ動かす
+	/// </summary>
+	void StepRandomly(ParticleStorage* pParticleStorage, UINT particlesNum)
+	{
+		pParticleStorage->Seed(1);
+
+		UINT index = 0;
+
+		for (UINT i = 0; i < particlesNum; ++i)
+		{
+			if (!pParticleStorage->Emit(&index)) break;
+		}
+
+		pParticleStorage->RotateAllRandomly(RANDOM_ROTATION_MIN, RANDOM_ROTATION_MAX);
+		pParticleStorage->AccelerateAllRandomly(SWAY_MIN, SWAY_MAX);
+		pParticleStorage->UpdateAll();
+	}
+
+	/// <summary>
+	/// 乱数を足す関数が範囲内の値を足し,同じシードなら同じ結果になるか
+	/// </summary>
+	bool RunRandomly()
+	{
+		ParticleStorage first(CHECK_PARTICLES_NUM);
+		ParticleStorage second(CHECK_PARTICLES_NUM);
+
+		StepRandomly(&first, CHECK_PARTICLES_NUM);
+		StepRandomly(&second, CHECK_PARTICLES_NUM);
+
+		bool isInRange = true;
+
+		VerticesParam verticesParam;
+
+		for (UINT i = 0; i < first.GetAliveNum(); ++i)
+		{
+			Particle(&first, i).GetVerticesParam(&verticesParam);
+
+			const D3DXVECTOR3& rCenter	= verticesParam.m_center;
+			const RotateValueXYZ& rDeg	= verticesParam.m_deg;
+
+			//! 初期状態は中心も速度も0なので,一度動かした中心が足した速度になる
+			isInRange = isInRange &&
+				SWAY_MIN.x <= rCenter.x && rCenter.x <= SWAY_MAX.x &&
+				SWAY_MIN.y <= rCenter.y && rCenter.y <= SWAY_MAX.y &&
+				RANDOM_ROTATION_MIN.x <= rDeg.x && rDeg.x <= RANDOM_ROTATION_MAX.x &&
+				RANDOM_ROTATION_MIN.y <= rDeg.y && rDeg.y <= RANDOM_ROTATION_MAX.y &&
+				RANDOM_ROTATION_MIN.z <= rDeg.z && rDeg.z <= RANDOM_ROTATION_MAX.z;
+		}
+
+		bool isPassed = isInRange && Matches(&first, &second);
+
+		if (isPassed)
+		{
+			_tprintf(_T("[OK] ParticleStorage: random acceleration and rotation stay in range and follow the seed\n"));
+		}
+		else
+		{
+			_tprintf(_T("[FAILED] ParticleStorage: random acceleration and rotation %s\n"), isInRange ? _T("differ with the same seed") : _T("go out of range"));
+		}
+
+		return isPassed;
+	}
+
+	/// <summary>
+	/// その場で初期化しなおしたパーティクルが,元の位置から補間されずに描画されるか
+	/// 初期化しなおしていないパーティクルは補間されるか
+	/// </summary>
+	bool RunReinitialized()
+	{
+		ParticleStorage particleStorage(CHECK_PARTICLES_NUM);
+
+		EmitParticles(&particleStorage, CHECK_PARTICLES_NUM);
+
+		//! EffectManagerと同じく,固定の間隔で更新する前に一つ前の状態を保持する
+		for (UINT i = 0; i < CHECK_STEPS_NUM; ++i)
+		{
+			particleStorage.SaveRenderState();
+
+			StepAll(&particleStorage);
+		}
+
+		particleStorage.SaveRenderState();
+
+		StepAll(&particleStorage);
+
+		//! 偶数番目のパーティクルだけ,サンプルの花びらのように離れた位置で生まれなおさせる
+		for (UINT i = 0; i < particleStorage.GetAliveNum(); i += 2)
+		{
+			Particle particle(&particleStorage, i);
+
+			particle.FormatCenter(RESPAWN_CENTER, 0.0f);
+			particle.ZeroLifeFrame();
+		}
+
+		UINT failedIndex = UINT_MAX;
+
+		VerticesParam current;
+		VerticesParam interpolated;
+
+		for (UINT i = 0; i < particleStorage.GetAliveNum() && failedIndex == UINT_MAX; ++i)
+		{
+			Particle particle(&particleStorage, i);
+
+			particle.GetVerticesParam(&current);
+			particle.GetVerticesParam(&interpolated, INTERPOLATION);
+
+			bool isInterpolated = (memcmp(&current.m_center, &interpolated.m_center, sizeof(current.m_center)) != 0);
+			bool isReinitialized = (i % 2 == 0);
+
+			if (isInterpolated == isReinitialized) failedIndex = i;
+		}
+
+		bool isPassed = (failedIndex == UINT_MAX);
+
+		if (isPassed)
+		{
+			_tprintf(_T("[OK] ParticleStorage: reinitialized particles are drawn without interpolation\n"));
+		}
+		else
+		{
+			_tprintf(_T("[FAILED] ParticleStorage: particle %u is %s\n"), failedIndex,
+				(failedIndex % 2 == 0) ? _T("interpolated from its old position after reinitialization") : _T("not interpolated"));
+		}
+
+		return isPassed;
+	}
+
+	/// <summary>
+	/// パーティクルを初期化してから処理を繰り返し,1ミリ秒あたりのパーティクルの数を求める
+	/// </summary>
+	double MeasureParticlesPerMillisecond(UINT particlesNum, void(*pStep)(ParticleStorage*))
+	{
+		ParticleStorage particleStorage(particlesNum);
+
+		EmitParticles(&particleStorage, particlesNum);
+
+		return Benchmark::MeasureItemsPerMillisecond(particlesNum, [&]() { pStep(&particleStorage); });
+	}
+}
+
+namespace ParticleStorageCheck
+{
+	bool Run()
+	{
+		ParticleStorage expected(CHECK_PARTICLES_NUM);
+		ParticleStorage actual(CHECK_PARTICLES_NUM);
+
+		EmitParticles(&expected, CHECK_PARTICLES_NUM);
+		EmitParticles(&actual, CHECK_PARTICLES_NUM);
+
+		UINT mismatchedStep = 0;
+
+		for (UINT i = 1; i <= CHECK_STEPS_NUM && mismatchedStep == 0; ++i)
+		{
+			StepEach(&expected);
+			StepAll(&actual);
+
+			if (!Matches(&expected, &actual)) mismatchedStep = i;
+		}
+
+		bool isPassed = (mismatchedStep == 0);
+
+		if (isPassed)
+		{
+			_tprintf(_T("[OK] ParticleStorage: %u particles match Particle for %u steps\n"), CHECK_PARTICLES_NUM, CHECK_STEPS_NUM);
+		}
+		else
+		{
+			_tprintf(_T("[FAILED] ParticleStorage: differs from Particle at step %u\n"), mismatchedStep);
+		}
+
+		bool isRandomlyPassed		= RunRandomly();
+		bool isReinitializedPassed	= RunReinitialized();
+
+		return isPassed && isRandomlyPassed && isReinitializedPassed;
+	}
+
+	void RunBenchmark()
+	{
+		for (UINT particlesNum : Benchmark::ITEMS_NUMS)
+		{
+			double eachParticlesPerMs	= MeasureParticlesPerMillisecond(particlesNum, StepEach);
+			double allParticlesPerMs	= MeasureParticlesPerMillisecond(particlesNum, StepAll);
+
+			_tprintf(_T("ParticleStorage: %6u particles: Particle %.0f particles/ms, ParticleStorage %.0f particles/ms (x%.2f)\n"),
+				particlesNum, eachParticlesPerMs, allParticlesPerMs, allParticlesPerMs / eachParticlesPerMs);
+		}
+	}
+}
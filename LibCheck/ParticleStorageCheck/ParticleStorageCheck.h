@@ -0,0 +1,30 @@
+﻿/// <filename>
+/// ParticleStorageCheck.h
+/// </filename>
+/// <summary>
+/// ParticleStorageの全てのパーティクルをまとめて処理する関数を検証し速度を測るヘッダ
+/// </summary>
+
+#ifndef PARTICLE_STORAGE_CHECK_H
+#define PARTICLE_STORAGE_CHECK_H
+
+/// <summary>
+/// ParticleStorageの全てのパーティクルをまとめて処理する関数を検証し速度を測る
+/// </summary>
+namespace ParticleStorageCheck
+{
+	/// <summary>
+	/// まとめて処理した結果を,Particleの同名の関数をパーティクルごとに呼んだ結果と比べる
+	/// 乱数を足す関数は,足した値が範囲内で同じシードなら同じ結果になるかを確かめる
+	/// その場で初期化しなおしたパーティクルが補間されずに描画されるかも確かめる
+	/// </summary>
+	/// <returns>全てのパーティクルの状態がビット単位で一致し,乱数を足す関数も正しければtrue</returns>
+	bool Run();
+
+	/// <summary>
+	/// パーティクルごとに処理する場合とまとめて処理する場合の1ミリ秒あたりのパーティクルの数を数ごとに表示する
+	/// </summary>
+	void RunBenchmark();
+}
+
+#endif //! PARTICLE_STORAGE_CHECK_H
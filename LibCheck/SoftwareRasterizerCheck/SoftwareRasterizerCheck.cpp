@@ -0,0 +1,177 @@
+﻿/// <filename>
+/// SoftwareRasterizerCheck.cpp
+/// </filename>
+/// <summary>
+/// SoftwareRasterizerの描画結果をリファレンス画像と比べる検証のソース
+/// </summary>
+
+#include "SoftwareRasterizerCheck.h"
+
+#include <Windows.h>
+#include <tchar.h>
+#include <stdio.h>
+
+#include <map>
+
+#include <d3dx9.h>
+
+#include "IGameLibRenderer\RecordingRenderer\RecordingRenderer.h"
+#include "SoftwareRasterizer\SoftwareRasterizer.h"
+#include "CustomVertex.h"
+#include "VerticesParam.h"
+#include "Wnd/Data/RectSize.h"
+
+namespace
+{
+	const TCHAR* const REFERENCE_PATH = _T("ReferenceImages\\SoftwareRasterizer.tga");
+
+	//! 浮動小数点の計算順の違いで辺の画素やテクセルの丸めがずれるのを許容する
+	const int COMPONENT_TOLERANCE = 2;
+
+	//! 全画素のうち異なってよい画素の千分率
+	const UINT DIFFERENT_PIXELS_PER_MILLE = 1;
+
+	/// <summary>
+	/// 8x8マスの市松模様のテクスチャを作成する 黒のマスは半透明にする
+	/// </summary>
+	SoftwareTexture CreateCheckerTexture()
+	{
+		const int CELLS_NUM		= 8;
+		const int CELL_SIZE		= 4;
+
+		SoftwareTexture texture;
+		texture.m_width		= CELLS_NUM * CELL_SIZE;
+		texture.m_height	= CELLS_NUM * CELL_SIZE;
+		texture.m_texels.resize(texture.m_width * texture.m_height);
+
+		for (int y = 0; y < texture.m_height; ++y)
+		{
+			for (int x = 0; x < texture.m_width; ++x)
+			{
+				bool isWhite = ((x / CELL_SIZE + y / CELL_SIZE) % 2) == 0;
+
+				texture.m_texels[y * texture.m_width + x] = (isWhite) ? 0xFFF0F0F0 : 0x80202020;
+			}
+		}
+
+		return texture;
+	}
+
+	/// <summary>
+	/// 色の合成,カリング,アルファ,テクスチャ,並べ替えを行う描画を記録する
+	/// </summary>
+	void RecordScene(RecordingRenderer* pRenderer, const LPDIRECT3DTEXTURE9 pCheckerTex)
+	{
+		CustomVertex background[CustomVertex::m_RECT_VERTICES_NUM];
+		pRenderer->CreateRect(background, D3DXVECTOR3(128.0f, 128.0f, 0.9f), D3DXVECTOR3(128.0f, 128.0f, 0.0f));
+		pRenderer->SetTopBottomARGB(background, 0xFF203040, 0xFF101010);
+		pRenderer->Render(background);
+
+		VerticesParam checker;
+		checker.m_center	= { 88.0f, 96.0f, 0.5f };
+		checker.m_halfScale = { 48.0f, 40.0f, 0.0f };
+		checker.m_deg		= { 0.0f, 0.0f, 30.0f };
+		checker.m_texUV		= { 0.0f, 0.0f, 2.0f, 2.0f };
+		pRenderer->Render(checker, pCheckerTex);
+
+		//! 奥にあるのでZテストで隠れる
+		VerticesParam hidden;
+		hidden.m_center		= { 88.0f, 96.0f, 0.7f };
+		hidden.m_halfScale	= { 24.0f, 24.0f, 0.0f };
+		hidden.m_aRGB		= 0xFFFF0000;
+		pRenderer->Render(hidden);
+
+		pRenderer->AddtionBlendMode();
+
+		VerticesParam glow;
+		glow.m_center		= { 160.0f, 160.0f, 0.4f };
+		glow.m_halfScale	= { 56.0f, 32.0f, 0.0f };
+		glow.m_aRGB			= 0x80FF6000;
+		pRenderer->Render(glow);
+
+		glow.m_center		= { 184.0f, 184.0f, 0.35f };
+		glow.m_halfScale	= { 40.0f, 40.0f, 0.0f };
+		glow.m_aRGB			= 0x800060FF;
+		pRenderer->Render(glow);
+
+		pRenderer->DefaultBlendMode();
+
+		//! 積んだ順とは異なりレイヤー,色の合成,テクスチャが最初に積まれた順,奥からの順に描画される
+		//! 重なる矩形が同じZだと補間の誤差でZテストの結果が画素ごとにばらつくので,後に描画されるものほど手前に置く
+		VerticesParam submitted;
+		submitted.m_center		= { 200.0f, 56.0f, 0.25f };
+		submitted.m_halfScale	= { 32.0f, 32.0f, 0.0f };
+		pRenderer->Submit(submitted, pCheckerTex, ColorBlender::BLEND_MODE::DEFAULT, 1);
+
+		submitted.m_center		= { 184.0f, 72.0f, 0.3f };
+		submitted.m_halfScale	= { 28.0f, 28.0f, 0.0f };
+		submitted.m_aRGB		= 0xC000FF40;
+		pRenderer->Submit(submitted, nullptr, ColorBlender::BLEND_MODE::DEFAULT, 0);
+
+		submitted.m_center		= { 216.0f, 80.0f, 0.2f };
+		submitted.m_halfScale	= { 24.0f, 24.0f, 0.0f };
+		submitted.m_aRGB		= 0xA0FF00FF;
+		pRenderer->Submit(submitted, nullptr, ColorBlender::BLEND_MODE::ADDITION, 1);
+
+		submitted.m_center		= { 48.0f, 208.0f, 0.15f };
+		submitted.m_halfScale	= { 32.0f, 24.0f, 0.0f };
+		submitted.m_aRGB		= 0xFFFFFFFF;
+		pRenderer->Submit(submitted, pCheckerTex, ColorBlender::BLEND_MODE::DEFAULT, 2);
+
+		submitted.m_center		= { 72.0f, 216.0f, 0.1f };
+		submitted.m_halfScale	= { 32.0f, 24.0f, 0.0f };
+		submitted.m_aRGB		= 0xE0FFD000;
+		pRenderer->Submit(submitted, nullptr, ColorBlender::BLEND_MODE::DEFAULT, 2);
+	}
+}
+
+bool SoftwareRasterizerCheck::Run(bool updatesReference)
+{
+	RectSize frameSize;
+	frameSize.m_x = 256;
+	frameSize.m_y = 256;
+
+	RecordingRenderer renderer(frameSize);
+
+	TexHandle checkerHandle = renderer.CreateTex(_T("Checker"), _T("Checker.tga"));
+
+	SoftwareTexture checker = CreateCheckerTexture();
+
+	std::map<UINT, const SoftwareTexture*> textures;
+	textures[checkerHandle.GetIndex()] = &checker;
+
+	RecordScene(&renderer, renderer.GetTex(checkerHandle));
+
+	SoftwareRasterizer rasterizer(frameSize);
+	rasterizer.Clear(0xFF000000);
+	rasterizer.Replay(renderer.GetCommands(), textures);
+
+	if (updatesReference)
+	{
+		bool saves = rasterizer.SaveTGA(REFERENCE_PATH);
+
+		_tprintf(_T("[%s] SoftwareRasterizer: update %s\n"), (saves) ? _T("OK") : _T("FAILED"), REFERENCE_PATH);
+
+		return saves;
+	}
+
+	SoftwareTexture reference;
+
+	if (!SoftwareRasterizer::LoadTGA(&reference, REFERENCE_PATH))
+	{
+		_tprintf(_T("[FAILED] SoftwareRasterizer: %s not found\n"), REFERENCE_PATH);
+
+		return false;
+	}
+
+	const UINT DIFFERENT_PIXELS_MAX = static_cast<UINT>(frameSize.m_x * frameSize.m_y) * DIFFERENT_PIXELS_PER_MILLE / 1000;
+
+	UINT differentPixelsNum = rasterizer.CountDifferentPixels(reference, COMPONENT_TOLERANCE);
+
+	bool matches = differentPixelsNum <= DIFFERENT_PIXELS_MAX;
+
+	_tprintf(_T("[%s] SoftwareRasterizer: %u pixel(s) differ from %s (max %u)\n"),
+		(matches) ? _T("OK") : _T("FAILED"), differentPixelsNum, REFERENCE_PATH, DIFFERENT_PIXELS_MAX);
+
+	return matches;
+}
@@ -0,0 +1,24 @@
+﻿/// <filename>
+/// SoftwareRasterizerCheck.h
+/// </filename>
+/// <summary>
+/// SoftwareRasterizerの描画結果をリファレンス画像と比べる検証のヘッダ
+/// </summary>
+
+#ifndef SOFTWARE_RASTERIZER_CHECK_H
+#define SOFTWARE_RASTERIZER_CHECK_H
+
+/// <summary>
+/// SoftwareRasterizerの描画結果をリファレンス画像と比べる検証
+/// </summary>
+namespace SoftwareRasterizerCheck
+{
+	/// <summary>
+	/// 決まった場面をRecordingRendererに記録しSoftwareRasterizerで再生した結果をリファレンス画像と比べる
+	/// </summary>
+	/// <param name="updatesReference">trueなら比べずにリファレンス画像を作り直す</param>
+	/// <returns>一致したか作り直せたらtrue</returns>
+	bool Run(bool updatesReference);
+}
+
+#endif //! SOFTWARE_RASTERIZER_CHECK_H
@@ -5,29 +5,50 @@
 /// 
 #include "Effects.h"
 
+#include <Windows.h>
+#include <tchar.h>
+
+#include <string>
+
 #include <d3dx9.h>
 
 #include "GameLib.h"
 
-void GetScoreStarEffect::Update()
+namespace GetScoreStarEffect
 {
-	InitActivatedParticle();
-
-	for (int i = 0; i < m_particles.size(); ++i)
+	namespace
 	{
-		if (i > m_activeLimit) continue;
+		const TCHAR* const DESC_KEY = _T("GetScoreStarEffect");
 
-		if (m_particles[i]->GetLifeFrame() > 40)
+		const TCHAR* const DESC_FILE_PATH = _T("EffectDescs\\GetScoreStarEffect.txt");
+
+		/// <summary>
+		/// 作業ディレクトリによらず読み込めるよう,実行ファイルのディレクトリからのパスにする
+		/// </summary>
+		std::basic_string<TCHAR> GetPathFromExeDir(const TCHAR* pRelativePath)
 		{
-			m_ends = true;
+			TCHAR exePath[MAX_PATH];
+
+			DWORD length = GetModuleFileName(NULL, exePath, MAX_PATH);
+
+			if (length == 0 || length >= MAX_PATH) return pRelativePath;
 
-			return;
+			TCHAR* pLastSeparator = _tcsrchr(exePath, _T('\\'));
+
+			if (!pLastSeparator) return pRelativePath;
+
+			return std::basic_string<TCHAR>(exePath, pLastSeparator + 1) + pRelativePath;
 		}
+	}
+
+	bool LoadDesc()
+	{
+		return GameLib::GetInstance().LoadEffectDesc(DESC_KEY, GetPathFromExeDir(DESC_FILE_PATH).c_str());
+	}
 
-		m_particles[i]->FadeIn(0, 10);
-		m_particles[i]->FadeOut(15, 20);
-		m_particles[i]->RotateZ(3.0f);
-		m_particles[i]->Update();
+	EffectHandle Spawn(const D3DXVECTOR3& center)
+	{
+		return GameLib::GetInstance().SpawnEffect(DESC_KEY, center);
 	}
 }
 
@@ -35,65 +56,61 @@ void GetClearStarEffect::Update()
 {
 	InitActivatedParticle();
 
-	for (int i = 0; i < m_particles.size(); ++i)
+	if (GetMaxLifeFrame() > 50)
 	{
-		if (i > m_activeLimit) continue;
+		m_ends = true;
 
-		if (m_particles[i]->GetLifeFrame() > 50)
-		{
-			m_ends = true;
+		return;
+	}
 
-			return;
-		}
+	FadeInParticles(0, 10);
+	FadeOutParticles(20, 25);
+	RotateParticles(RotateValueXYZ(0.0f, 0.0f, 3.0f));
 
-		m_particles[i]->FadeIn(0, 10);
-		m_particles[i]->FadeOut(20, 25);
-		m_particles[i]->RotateZ(3.0f);
-		m_particles[i]->CirculationZ(5.0f);
-		m_particles[i]->Update();
+	//! 回転量に乱数を使うのでパーティクルごとに処理する
+	for (UINT i = 0; i < GetParticlesNum(); ++i)
+	{
+		GetParticle(i).CirculationZ(5.0f);
 	}
+
+	UpdateParticles();
 }
 
 void GetDamageStarEffect::Update()
 {
 	InitActivatedParticle();
 
-	for (int i = 0; i < m_particles.size(); ++i)
+	if (GetMaxLifeFrame() > 30)
 	{
-		if (i > m_activeLimit) continue;
+		m_ends = true;
 
-		if (m_particles[i]->GetLifeFrame() > 30)
-		{
-			m_ends = true;
-
-			return;
-		}
-
-		m_particles[i]->FadeIn(0, 10);
-		m_particles[i]->FadeOut(10, 20);
-		m_particles[i]->RotateZ(3.0f);
-		m_particles[i]->Update();
+		return;
 	}
+
+	FadeInParticles(0, 10);
+	FadeOutParticles(10, 20);
+	RotateParticles(RotateValueXYZ(0.0f, 0.0f, 3.0f));
+	UpdateParticles();
 }
 
 void FlowerFallingEffect::Update()
 {
 	InitActivatedParticle();
 
-	std::uniform_real_distribution<float> degRand(0, D3DX_PI);
+	std::uniform_int_distribution<int> lifeFrameRand(220, 299);
 
-	for (int i = 0; i < m_particles.size(); ++i)
+	//! 生存時間が乱数の下限以下なら初期化されることはないので,乱数を引かずに飛ばす
+	for (UINT i = 0; i < GetParticlesNum(); ++i)
 	{
-		if (i > m_activeLimit) continue;
-
-		if (m_particles[i]->GetLifeFrame() > rand() % 80 + 220) Init(m_particles[i]);
+		Particle particle = GetParticle(i);
 
-		D3DXVECTOR2 gravity = { cos(degRand(m_randEngine)) , 0.0f};
+		if (particle.GetLifeFrame() <= lifeFrameRand.min()) continue;
 
-		m_particles[i]->RotateX(static_cast<float>(rand() % 5));
-		m_particles[i]->RotateY(static_cast<float>(rand() % 5));
-		m_particles[i]->RotateZ(static_cast<float>(rand() % 5));
-		m_particles[i]->Accelarate(gravity);
-		m_particles[i]->Update();
+		if (particle.GetLifeFrame() > lifeFrameRand(GetRandEngine())) Init(particle);
 	}
+
+	//! 揺れと回転の量はパーティクルごとに乱数で変わるが,まとめて処理する関数で足す
+	RotateParticlesRandomly(RotateValueXYZ(0.0f, 0.0f, 0.0f), RotateValueXYZ(4.0f, 4.0f, 4.0f));
+	AccelerateParticlesRandomly(D3DXVECTOR2(-1.0f, 0.0f), D3DXVECTOR2(1.0f, 0.0f));
+	UpdateParticles();
 }
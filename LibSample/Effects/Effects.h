@@ -7,73 +7,73 @@
 
 #include <Windows.h>
 
+#include <tchar.h>
+
+#include <random>
+
 #include <d3dx9.h>
 
 #include "GameLib.h"
 
-class GetScoreStarEffect :public Effect
+/// <summary>
+/// 派生クラスを作らずにEffectDescs/GetScoreStarEffect.txtの設定で動かすエフェクト
+/// 設定はビルド後に実行ファイルと同じディレクトリのEffectDescsへコピーされる
+/// </summary>
+namespace GetScoreStarEffect
+{
+	/// <summary>
+	/// 設定を実行ファイルと同じディレクトリから読み込む GameLibを作成した後,出現させる前に一度呼ぶ
+	/// </summary>
+	/// <returns>ファイルが開けないか書式が誤っている場合false</returns>
+	bool LoadDesc();
+
+	/// <summary>
+	/// 読み込んだ設定で動くエフェクトを出現させる
+	/// </summary>
+	/// <param name="center">パーティクルを出現させる位置</param>
+	/// <returns>追加したエフェクトのハンドル 設定が読み込まれていない場合何も指さない</returns>
+	EffectHandle Spawn(const D3DXVECTOR3& center);
+}
+
+class GetClearStarEffect :public Effect
 {
 public:
-	GetScoreStarEffect(const D3DXVECTOR3& center) :Effect(13, _T("2DTextures/EffectTexture/Star.png"), 0), m_center(center)
+	GetClearStarEffect(const D3DXVECTOR3& center) :Effect(40, _T("2DTextures/EffectTexture/Star.png"), 0)
 	{
-		if (m_COUNT_TO_ACTIVE_MAX != 0) return;
-
-		for (auto i : m_particles) 
-		{
-			Init(i); 
-		}
+		Reset(center);
 	}
 
-	~GetScoreStarEffect() {};
-
-	void Update();
+	~GetClearStarEffect() {};
 
-protected:
-	inline void Init(Particle* pParticle)
+	/// <summary>
+	/// SpawnEffectで使いまわされる際に呼ばれる
+	/// </summary>
+	inline void Reset(const D3DXVECTOR3& center)
 	{
-		D3DXVECTOR2 halfScale = { 1.5f, 1.5f };
+		m_center = center;
 
-		pParticle->FormatShape(halfScale, 2.0f);
-		pParticle->SetColor(0x0087CEFA);
-		pParticle->FormatCenter(m_center, 20.0f);
-		
-		pParticle->ZeroLifeFrame();
-		pParticle->ZeroVelocity();
-		pParticle->FormatRadiationInitialVelocity(2.0f, 0.0f);
-	}
+		Restart();
 
-	D3DXVECTOR3 m_center;
-};
-
-class GetClearStarEffect :public Effect
-{
-public:
-	GetClearStarEffect(const D3DXVECTOR3& center) :Effect(40, _T("2DTextures/EffectTexture/Star.png"), 0), m_center(center)
-	{
-		if (m_COUNT_TO_ACTIVE_MAX != 0) return;
-
-		for (auto i : m_particles) 
+		for (UINT i = 0; i < GetParticlesNum(); ++i)
 		{
-			Init(i); 
+			Init(GetParticle(i));
 		}
 	}
 
-	~GetClearStarEffect() {};
-
 	void Update();
 
 protected:
-	inline void Init(Particle* pParticle)
+	inline void Init(Particle particle)
 	{
 		D3DXVECTOR2 halfScale = { 1.5f, 1.5f };
 
-		pParticle->FormatShape(halfScale, 2.0f);
-		pParticle->SetColor(0x0098FB98);
-		pParticle->FormatCenter(m_center, 20.0f);
+		particle.FormatShape(halfScale, 2.0f);
+		particle.SetColor(0x0098FB98);
+		particle.FormatCenter(m_center, 20.0f);
 
-		pParticle->ZeroLifeFrame();
-		pParticle->ZeroVelocity();
-		pParticle->FormatRadiationInitialVelocity(3.0f, 0.0f);
+		particle.ZeroLifeFrame();
+		particle.ZeroVelocity();
+		particle.FormatRadiationInitialVelocity(3.0f, 0.0f);
 	}
 
 	D3DXVECTOR3 m_center;
@@ -82,32 +82,42 @@ protected:
 class GetDamageStarEffect :public Effect
 {
 public:
-	GetDamageStarEffect(const D3DXVECTOR3& center) :Effect(25, _T("2DTextures/EffectTexture/Star.png"), 0), m_center(center)
+	GetDamageStarEffect(const D3DXVECTOR3& center) :Effect(25, _T("2DTextures/EffectTexture/Star.png"), 0)
 	{
-		if (m_COUNT_TO_ACTIVE_MAX != 0) return;
+		Reset(center);
+	}
+
+	~GetDamageStarEffect() {};
 
-		for (auto i : m_particles) 
+	/// <summary>
+	/// SpawnEffectで使いまわされる際に呼ばれる
+	/// </summary>
+	inline void Reset(const D3DXVECTOR3& center)
+	{
+		m_center = center;
+
+		Restart();
+
+		for (UINT i = 0; i < GetParticlesNum(); ++i)
 		{
-			Init(i); 
+			Init(GetParticle(i));
 		}
 	}
 
-	~GetDamageStarEffect() {};
-
 	void Update();
 
 protected:
-	inline void Init(Particle* pParticle)
+	inline void Init(Particle particle)
 	{
 		D3DXVECTOR2 halfScale = { 1.5f, 1.5f };
 
-		pParticle->FormatShape(halfScale, 2.0f);
-		pParticle->SetColor(0x00FFFFFF);
-		pParticle->FormatCenter(m_center, 80.0f,10.0f);
+		particle.FormatShape(halfScale, 2.0f);
+		particle.SetColor(0x00FFFFFF);
+		particle.FormatCenter(m_center, 80.0f,10.0f);
 
-		pParticle->ZeroLifeFrame();
-		pParticle->ZeroVelocity();
-		pParticle->FormatAbsorptionInitialVelocity(3.0f, 0.0f);
+		particle.ZeroLifeFrame();
+		particle.ZeroVelocity();
+		particle.FormatAbsorptionInitialVelocity(3.0f, 0.0f);
 	}
 
 	D3DXVECTOR3 m_center;
@@ -118,43 +128,51 @@ class FlowerFallingEffect :public Effect
 public:
 	FlowerFallingEffect() :Effect(30, nullptr, 0)
 	{
-		if (m_COUNT_TO_ACTIVE_MAX != 0) return;
+		Reset();
+	}
+
+	~FlowerFallingEffect() {}
+
+	/// <summary>
+	/// SpawnEffectで使いまわされる際に呼ばれる
+	/// </summary>
+	inline void Reset()
+	{
+		Restart();
 
-		for (auto i : m_particles)
+		for (UINT i = 0; i < GetParticlesNum(); ++i)
 		{
-			Init(i);
+			Init(GetParticle(i));
 		}
-
-		std::random_device randDevForSeed;
-		m_randEngine.seed(randDevForSeed());
 	}
 
-	~FlowerFallingEffect() {}
-
 	void Update();
 
 private:
-	void Init(Particle* pParticle)
+	void Init(Particle particle)
 	{
 		D3DXVECTOR2 halfScale = { 3.5f, 3.5f };
 
 		DWORD colors[2] = { 0xCAF8F8F8,0xCA87CEFA };
 
-		pParticle->FormatShape(halfScale, 0.0f);
-		pParticle->SetColor(colors[rand() % 2]);
+		//! 並列に更新しても結果が変わらないよう,rand()ではなくエフェクトの乱数を使う
+		std::uniform_int_distribution<int> colorRand(0, 1);
+		std::uniform_int_distribution<int> xRand(0, 1279);
+		std::uniform_int_distribution<int> yRand(0, 999);
 
-		D3DXVECTOR3 center(static_cast<float>(rand() % 1280), static_cast<float>(-rand() % 1000), 0.0f);
-		pParticle->FormatCenter(center, 0.0f);
+		particle.FormatShape(halfScale, 0.0f);
+		particle.SetColor(colors[colorRand(GetRandEngine())]);
 
-		pParticle->ZeroLifeFrame();
-		pParticle->ZeroVelocity();
+		D3DXVECTOR3 center(static_cast<float>(xRand(GetRandEngine())), static_cast<float>(-yRand(GetRandEngine())), 0.0f);
+		particle.FormatCenter(center, 0.0f);
+
+		particle.ZeroLifeFrame();
+		particle.ZeroVelocity();
 
 		D3DXVECTOR2 gravity = { 0.0f , 3.0f };
 
-		pParticle->Accelarate(gravity);
+		particle.Accelarate(gravity);
 	}
-
-	std::minstd_rand m_randEngine;
 };
 
 #endif //! EFFECTS_H